@@ -2,8 +2,9 @@
 <xsl:stylesheet xmlns:xsl="http://www.w3.org/1999/XSL/Transform"
                 xmlns:moz="http://www.mozilla.org/"
                 xmlns:ext="xalan://io.github.hc1839.xbelmark.xslt.ext.DateTime"
+                xmlns:icon="xalan://io.github.hc1839.xbelmark.xslt.ext.Icon"
                 xmlns="http://www.w3.org/1999/xhtml"
-                extension-element-prefixes="ext"
+                extension-element-prefixes="ext icon"
                 exclude-result-prefixes="moz"
                 version="1.0">
   <!-- HTML title of the output. -->
@@ -112,7 +113,7 @@
   <xsl:template match="/xbel//bookmark">
     <dt>
       <a href="{@href}">
-        <xsl:apply-templates select="@added|@modified"/>
+        <xsl:apply-templates select="@added|@modified|@icon"/>
         <xsl:apply-templates select="info/metadata/moz:*"/>
         <xsl:call-template name="value-of-or-default">
           <xsl:with-param name="node" select="title"/>
@@ -188,6 +189,18 @@
     </xsl:if>
   </xsl:template>
 
+  <!-- Icon of the bookmark embedded from the icon cache. -->
+  <xsl:template match="/xbel//bookmark/@icon">
+    <xsl:if test="function-available('icon:dataUri')">
+      <xsl:variable name="data.uri" select="icon:dataUri(.)"/>
+      <xsl:if test="$data.uri != ''">
+        <xsl:attribute name="icon">
+          <xsl:value-of select="$data.uri"/>
+        </xsl:attribute>
+      </xsl:if>
+    </xsl:if>
+  </xsl:template>
+
   <!-- When the folder was added. -->
   <xsl:template match="/xbel//folder/@added">
     <xsl:if test="$vendor.id = $vendor.libxslt.id or
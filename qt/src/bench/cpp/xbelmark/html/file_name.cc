@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "xbelmark/html/file_name.h"
+
+using xbelmark::html::SanitizedFileName;
+
+/**
+ *  Destination of the results so that the measured work is not optimized
+ *  away.
+ */
+volatile std::size_t sink = 0;
+
+/**
+ *  File name of a title by regular expressions in the same way as
+ *  `WinTitleName` and `paste` did before `SanitizedFileName`.
+ */
+std::string RegexFileName(const std::string &title) {
+  const std::regex reserved_re("<|>|:|\"|/|\\\\|\\||\\?|\\*");
+  std::string retval(title);
+  retval = std::regex_replace(retval, std::regex("^\\s+|\\s+$"), "");
+  retval = std::regex_replace(retval, std::regex("\\s+"), " ");
+  retval = std::regex_replace(retval, reserved_re, "_");
+  return std::regex_replace(retval, std::regex("\\s"), "_");
+}
+
+/**
+ *  Samples of HTML titles, modeled on the titles of popular sites.
+ */
+std::vector<std::pair<std::string, std::string>> BuiltinSamples() {
+  std::vector<std::pair<std::string, std::string>> retval;
+  retval.emplace_back("short", "Example Domain");
+  retval.emplace_back(
+      "reserved",
+      "  c++ - What is std::move? | Q&A: \"rvalue\" <references> / 2024 ");
+  retval.emplace_back(
+      "whitespace",
+      "\n\t\tNews  &  Views\n\t\t\xE2\x80\x93  Front   Page\n\t");
+  std::string long_title;
+  for (int i = 0; i != 20; ++i) {
+    long_title += "Chapter " + std::to_string(i) + ": A Rather Long Heading ";
+  }
+  retval.emplace_back("long", long_title);
+  return retval;
+}
+
+int main() {
+  const std::vector<std::pair<std::string, std::string>> samples(
+      BuiltinSamples());
+  std::cout <<
+      std::left << std::setw(24) << "sample" <<
+      std::right << std::setw(10) << "bytes" <<
+      std::setw(14) << "single ns" <<
+      std::setw(14) << "regex ns" <<
+      std::setw(10) << "speedup" << std::endl;
+  for (const auto &sample : samples) {
+    const std::string &title = sample.second;
+    // Truncation makes long titles differ, so only short ones are compared.
+    if (title.size() <= xbelmark::html::kMaxFileNameBytes &&
+        SanitizedFileName(title, '_') != RegexFileName(title)) {
+      std::cout << std::left << std::setw(24) << sample.first <<
+          " file names differ: \"" << SanitizedFileName(title, '_') <<
+          "\" and \"" << RegexFileName(title) << "\"" << std::endl;
+    }
+    const int iterations = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i != iterations; ++i) {
+      sink = SanitizedFileName(title, '_').size();
+    }
+    const double single_ns =
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count() / iterations;
+    const int regex_iterations = iterations / 100 + 1;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i != regex_iterations; ++i) {
+      sink = RegexFileName(title).size();
+    }
+    const double regex_ns =
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count() /
+        regex_iterations;
+    std::cout <<
+        std::left << std::setw(24) << sample.first.substr(0, 23) <<
+        std::right << std::setw(10) << title.size() <<
+        std::fixed << std::setprecision(0) <<
+        std::setw(14) << single_ns <<
+        std::setw(14) << regex_ns <<
+        std::setprecision(1) <<
+        std::setw(9) << regex_ns / single_ns << "x" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,185 @@
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libxml/HTMLparser.h>
+#include <libxml/parser.h>
+
+#include "xbelmark/html/title_scanner.h"
+
+using xbelmark::html::TitleScanner;
+
+/**
+ *  Destination of the results so that the measured work is not optimized
+ *  away.
+ */
+volatile std::size_t sink = 0;
+
+/**
+ *  Title of an HTML document that is read by the libxml2 HTML push parser in
+ *  the same way as `InfoRequest`.
+ */
+class ParserTitle final {
+ public:
+  static void StartElement(
+      void *ctx, const xmlChar *name, const xmlChar ** /* atts */) {
+    ParserTitle *obj = static_cast<ParserTitle *>(ctx);
+    if (std::strcmp(reinterpret_cast<const char *>(name), "title") == 0) {
+      obj->is_title_ = true;
+    }
+  }
+
+  static void EndElement(void *ctx, const xmlChar *name) {
+    ParserTitle *obj = static_cast<ParserTitle *>(ctx);
+    if (obj->is_title_ &&
+        std::strcmp(reinterpret_cast<const char *>(name), "title") == 0) {
+      obj->is_title_ = false;
+      xmlStopParser(obj->ctxt_);
+    }
+  }
+
+  static void Characters(void *ctx, const xmlChar *ch, int len) {
+    ParserTitle *obj = static_cast<ParserTitle *>(ctx);
+    if (obj->is_title_) {
+      obj->title_.append(reinterpret_cast<const char *>(ch), len);
+    }
+  }
+
+  explicit ParserTitle(const std::string &html) {
+    htmlSAXHandler handler;
+    std::memset(&handler, 0, sizeof(handler));
+    handler.startElement = &StartElement;
+    handler.endElement = &EndElement;
+    handler.characters = &Characters;
+    handler.cdataBlock = &Characters;
+    ctxt_ = htmlCreatePushParserCtxt(
+        &handler, this, nullptr, 0, "", XML_CHAR_ENCODING_UTF8);
+    htmlParseChunk(ctxt_, html.data(), static_cast<int>(html.size()), 1);
+    htmlFreeParserCtxt(ctxt_);
+  }
+
+  const std::string &title() const {
+    return title_;
+  }
+
+ private:
+  htmlParserCtxtPtr ctxt_;
+
+  std::string title_;
+
+  bool is_title_ = false;
+};
+
+/**
+ *  Samples that are used if no HTML files are given, modeled on the `head`
+ *  elements of popular sites.
+ */
+std::vector<std::pair<std::string, std::string>> BuiltinSamples() {
+  std::vector<std::pair<std::string, std::string>> retval;
+  std::string meta;
+  for (int i = 0; i != 40; ++i) {
+    meta += "<meta property=\"og:x" + std::to_string(i) +
+        "\" content=\"Some fairly long content value number " +
+        std::to_string(i) + "\">\n";
+  }
+  std::string script("<script>");
+  for (int i = 0; i != 2000; ++i) {
+    script += "var a" + std::to_string(i) + " = '<div>' + " +
+        std::to_string(i) + " + '</div>';\n";
+  }
+  script += "</script>\n";
+  std::string style("<style>");
+  for (int i = 0; i != 500; ++i) {
+    style += ".c" + std::to_string(i) + " > p { margin: 0 auto; }\n";
+  }
+  style += "</style>\n";
+  retval.emplace_back(
+      "short-head",
+      "<!DOCTYPE html><html lang=\"en\"><head><meta charset=\"utf-8\">"
+      "<title>Example Domain</title></head><body><p>Text</p></body></html>");
+  retval.emplace_back(
+      "meta-heavy",
+      "<!DOCTYPE html><html><head><meta charset=\"utf-8\">\n" + meta +
+      "<title>News &amp; Views &#8211; Front Page</title></head><body>");
+  retval.emplace_back(
+      "inline-script",
+      "<!DOCTYPE html><html><head><meta charset=\"utf-8\">\n" + meta + style +
+      script + "<!-- analytics -->\n<title>Dashboard</title></head><body>");
+  return retval;
+}
+
+int main(int argc, char *argv[]) {
+  std::vector<std::pair<std::string, std::string>> samples;
+  for (int i = 1; i < argc; ++i) {
+    std::ifstream file(argv[i], std::ios::binary);
+    if (!file) {
+      std::cerr << "Cannot read " << argv[i] << std::endl;
+      return 1;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    samples.emplace_back(argv[i], content.str());
+  }
+  if (samples.empty()) {
+    samples = BuiltinSamples();
+  }
+  std::cout <<
+      std::left << std::setw(24) << "sample" <<
+      std::right << std::setw(10) << "bytes" <<
+      std::setw(14) << "scanner ns" <<
+      std::setw(14) << "libxml2 ns" <<
+      std::setw(10) << "speedup" << std::endl;
+  for (const auto &sample : samples) {
+    const std::string &html = sample.second;
+    TitleScanner check;
+    const TitleScanner::Status status =
+        check.Scan(html.data(), html.size(), true);
+    if (status != TitleScanner::Status::FOUND) {
+      std::cout << std::left << std::setw(24) << sample.first <<
+          " falls back to libxml2" << std::endl;
+      continue;
+    }
+    if (check.title() != ParserTitle(html).title()) {
+      std::cout << std::left << std::setw(24) << sample.first <<
+          " titles differ: \"" << check.title() << "\" and \"" <<
+          ParserTitle(html).title() << "\"" << std::endl;
+    }
+    // Repeat until each measurement takes a while.
+    const int iterations =
+        static_cast<int>(200000000 / (html.size() + 1000)) + 1;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i != iterations; ++i) {
+      TitleScanner scanner;
+      scanner.Scan(html.data(), html.size(), true);
+      sink = scanner.title().size();
+    }
+    const double scanner_ns =
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count() / iterations;
+    const int parser_iterations = iterations / 10 + 1;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i != parser_iterations; ++i) {
+      sink = ParserTitle(html).title().size();
+    }
+    const double parser_ns =
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count() /
+        parser_iterations;
+    std::cout <<
+        std::left << std::setw(24) << sample.first.substr(0, 23) <<
+        std::right << std::setw(10) << html.size() <<
+        std::fixed << std::setprecision(0) <<
+        std::setw(14) << scanner_ns <<
+        std::setw(14) << parser_ns <<
+        std::setprecision(1) <<
+        std::setw(9) << parser_ns / scanner_ns << "x" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,203 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include "xbelmark/xml/reader.h"
+
+using xbelmark::xml::NewXmlParserCtxt;
+using xbelmark::xml::OrderedXmlDoc;
+using xbelmark::xml::ReadXmlFile;
+using xbelmark::xml::kReadOptions;
+
+/**
+ *  Destination of the results so that the measured work is not optimized
+ *  away.
+ */
+volatile std::size_t sink = 0;
+
+/**
+ *  Write a synthetic XBEL file of nested folders of bookmarks.
+ */
+void WriteSample(const std::string &path, int num_bookmarks) {
+  std::ofstream out(path, std::ios::binary);
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<!DOCTYPE xbel PUBLIC \"+//IDN python.org//DTD XML Bookmark "
+      "Exchange Language 1.0//EN//XML\" "
+      "\"http://pyxml.sourceforge.net/topics/dtds/xbel.dtd\">\n"
+      "<xbel version=\"1.0\">\n";
+  for (int i = 0; i != num_bookmarks; ++i) {
+    if (i % 100 == 0) {
+      if (i != 0) {
+        out << "</folder>\n";
+      }
+      out << "<folder folded=\"yes\"><title>Folder " << i / 100 <<
+          "</title>\n";
+    }
+    out << "  <bookmark href=\"https://www.example.com/articles/" << i <<
+        "/some-fairly-long-slug-of-an-article\" added=\"2024-01-01T00:00:00Z\""
+        " icon=\"https://www.example.com/favicon.ico\">\n"
+        "    <title>Article " << i << " &#8211; Example News</title>\n"
+        "    <desc>Description of article " << i << ".</desc>\n"
+        "  </bookmark>\n";
+  }
+  out << "</folder>\n</xbel>\n";
+}
+
+/**
+ *  Number of nodes in a tree.
+ */
+std::size_t CountNodes(xmlNodePtr node) {
+  std::size_t retval = 0;
+  for (; node; node = node->next) {
+    retval += 1 + CountNodes(node->children);
+  }
+  return retval;
+}
+
+/**
+ *  Ways of parsing an input document of the `xslt` subcommand.
+ */
+enum class Mode {
+  /**
+   *  `xmlParseFile` with the default options.
+   */
+  BASELINE,
+
+  /**
+   *  `ReadXmlFile`, which is used by the `xslt` subcommand.
+   */
+  TUNED,
+
+  /**
+   *  Same as `TUNED` but from a mapped file, which is not used.
+   */
+  MAPPED
+};
+
+const char *ModeName(Mode mode) {
+  switch (mode) {
+    case Mode::BASELINE: {
+      return "baseline";
+    }
+    case Mode::TUNED: {
+      return "tuned";
+    }
+    case Mode::MAPPED: {
+      return "mapped";
+    }
+  }
+  return "";
+}
+
+/**
+ *  Parse a file with a dictionary that stands for that of a stylesheet.
+ */
+xmlDocPtr Parse(const std::string &path, Mode mode, xmlDictPtr dict) {
+  switch (mode) {
+    case Mode::BASELINE: {
+      return xmlParseFile(path.c_str());
+    }
+    case Mode::TUNED: {
+      return ReadXmlFile(path, dict);
+    }
+    case Mode::MAPPED: {
+      const int fd = open(path.c_str(), O_RDONLY);
+      struct stat st;
+      if (fd < 0 || fstat(fd, &st) != 0) {
+        return nullptr;
+      }
+      void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (data == MAP_FAILED) {
+        return nullptr;
+      }
+      xmlParserCtxtPtr ctxt = NewXmlParserCtxt(dict);
+      xmlDocPtr retval = xmlCtxtReadMemory(
+          ctxt,
+          static_cast<const char *>(data),
+          static_cast<int>(st.st_size),
+          path.c_str(),
+          nullptr,
+          kReadOptions);
+      xmlFreeParserCtxt(ctxt);
+      munmap(data, st.st_size);
+      return OrderedXmlDoc(retval);
+    }
+  }
+  return nullptr;
+}
+
+/**
+ *  Measure the parsing of a file in a child process so that the peak
+ *  resident set size is of the parsing alone.
+ */
+void Measure(const std::string &path, Mode mode) {
+  std::fflush(stdout);
+  const pid_t pid = fork();
+  if (pid == 0) {
+    xmlInitParser();
+    xmlDictPtr dict = xmlDictCreate();
+    const auto start = std::chrono::steady_clock::now();
+    xmlDocPtr doc = Parse(path, mode, dict);
+    const double ms =
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    if (!doc) {
+      std::printf("%-10s failed\n", ModeName(mode));
+      std::_Exit(1);
+    }
+    sink = CountNodes(doc->children);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("%-10s %12.1f %14ld\n", ModeName(mode), ms, usage.ru_maxrss);
+    std::fflush(stdout);
+    std::_Exit(0);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+}
+
+int main(int argc, char *argv[]) {
+  std::string path;
+  if (argc > 1) {
+    path = argv[1];
+  } else {
+    path = "bench_xml_reader.xbel";
+    WriteSample(path, 500000);
+  }
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    std::cerr << "Cannot read " << path << std::endl;
+    return 1;
+  }
+  std::cout << path << ": " << st.st_size << " bytes" << std::endl;
+  std::cout <<
+      std::left << std::setw(10) << "parser" <<
+      std::right << std::setw(13) << "parse ms" <<
+      std::setw(15) << "peak RSS KiB" << std::endl;
+  for (int i = 0; i != 3; ++i) {
+    Measure(path, Mode::BASELINE);
+    Measure(path, Mode::TUNED);
+    Measure(path, Mode::MAPPED);
+  }
+  if (argc <= 1) {
+    std::remove(path.c_str());
+  }
+  return 0;
+}
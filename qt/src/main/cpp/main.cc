@@ -1,6 +1,8 @@
 #include <iostream>
 #include <string>
 
+#include "xbelmark/compact/compact.h"
+#include "xbelmark/daemon/daemon.h"
 #include "xbelmark/paste/paste.h"
 #include "xbelmark/xslt/xslt.h"
 
@@ -13,6 +15,8 @@ int main(int argc, char *argv[]) {
   if (subcommand == "--help" || subcommand == "-h") {
     if (argc == 2) {
       std::cout << "Available subcommands:" << std::endl;
+      std::cout << "  compact" << std::endl;
+      std::cout << "  daemon" << std::endl;
       std::cout << "  paste" << std::endl;
       std::cout << "  xslt" << std::endl;
       std::cout << "Type `xbelmark [subcommand] --help`";
@@ -23,6 +27,10 @@ int main(int argc, char *argv[]) {
       char *args[] = { argv[0], argv[2], help_opt.data() };
       return main(3, args);
     }
+  } else if (subcommand == "compact") {
+    return xbelmark::compact::Execute(argc, argv);
+  } else if (subcommand == "daemon") {
+    return xbelmark::daemon::Execute(argc, argv);
   } else if (subcommand == "paste") {
     return xbelmark::paste::Execute(argc, argv);
   } else if (subcommand == "xslt") {
@@ -0,0 +1,30 @@
+#ifndef XBELMARK_COMPACT_CMD_ARGS_H
+#define XBELMARK_COMPACT_CMD_ARGS_H
+
+#include <string>
+
+#include "xbelmark/cmd_args.h"
+
+namespace xbelmark {
+namespace compact {
+
+/**
+ *  Command-line arguments for the `compact` subcommand.
+ */
+struct CmdArgs : public xbelmark::CmdArgs {
+ public:
+  /**
+   *  Path to the journal.
+   */
+  std::string journal_path;
+
+  /**
+   *  Path to the XBEL document.
+   */
+  std::string xbel_path;
+};
+
+} // namespace compact
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,142 @@
+#include "xbelmark/compact/cmd_args_parser.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#define SUBCOMMAND_NAME "compact"
+
+namespace xbelmark {
+namespace compact {
+
+class CmdArgsParser::Impl final {
+ public:
+  /**
+   *  Reset the parser.
+   */
+  void Reset() {
+    cmd_args_.reset(new CmdArgs());
+    arg_it_ = nullptr;
+    arg_last_ = nullptr;
+    pos_arg_idx_ = -1;
+  }
+
+  /**
+   *  Set the help message that can be printed.
+   */
+  void SetHelpMessage() {
+    ++arg_it_;
+    std::string &help = cmd_args_->help;
+    if (!help.empty()) {
+      return;
+    }
+    help = help +
+        "Usage: " +
+        cmd_args_->command_name + " " + cmd_args_->subcommand_name +
+        " [options]\n\n" +
+        "Fold the bookmarks in a journal written by `paste --journal`\n" +
+        "into an XBEL document.\n\n";
+    help = help +
+        "  --journal [path]\n" +
+        "\n" +
+        "      Path to the journal.\n\n";
+    help = help +
+        "  --xbel [path]\n" +
+        "\n" +
+        "      Path to the XBEL document, which is created if it does not\n" +
+        "      exist.\n\n";
+    help = help +
+        "  --help, -h\n" +
+        "\n" +
+        "      Print help.";
+  }
+
+  /**
+   *  Set the path to the journal.
+   */
+  void SetJournalPath() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--journal`.");
+    }
+    cmd_args_->journal_path = *arg_it_++;
+  }
+
+  /**
+   *  Set the path to the XBEL document.
+   */
+  void SetXbelPath() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--xbel`.");
+    }
+    cmd_args_->xbel_path = *arg_it_++;
+  }
+
+  /**
+   *  Parsed command-line arguments.
+   */
+  std::unique_ptr<CmdArgs> cmd_args_;
+
+  /**
+   *  Pointer to the current command-line argument.
+   */
+  char **arg_it_;
+
+  /**
+   *  Pointer to past-the-last command-line argument.
+   */
+  char **arg_last_;
+
+  /**
+   *  Zero-based index of the current positional command-line argument.
+   *
+   *  It is `-1` if the current command-line argument is not positional.
+   */
+  int pos_arg_idx_;
+};
+
+CmdArgsParser::CmdArgsParser() : p_impl_(new Impl()) {
+}
+
+CmdArgsParser::~CmdArgsParser() = default;
+
+std::unique_ptr<CmdArgs> CmdArgsParser::Parse(char **first, char **last) {
+  p_impl_->Reset();
+  p_impl_->cmd_args_->subcommand_name = SUBCOMMAND_NAME;
+  p_impl_->arg_it_ = first;
+  p_impl_->arg_last_ = last;
+  // Parse the command-line arguments.
+  while (p_impl_->arg_it_ != p_impl_->arg_last_) {
+    if (p_impl_->pos_arg_idx_ == -1) {
+      const std::string opt(*p_impl_->arg_it_);
+      if (opt == "--help" || opt == "-h") {
+        p_impl_->SetHelpMessage();
+      } else if (opt == "--journal") {
+        p_impl_->SetJournalPath();
+      } else if (opt == "--xbel") {
+        p_impl_->SetXbelPath();
+      } else if (opt.front() == '-') {
+        throw std::runtime_error("Unrecognized option: " + opt);
+      } else {
+        ++p_impl_->pos_arg_idx_;
+      }
+    } else {
+      const std::string arg(*p_impl_->arg_it_);
+      throw std::runtime_error("Unrecognized positional argument: " + arg);
+    }
+  }
+  // Ensure the paths to the journal and XBEL document are set.
+  if (p_impl_->cmd_args_->help.empty()) {
+    if (p_impl_->cmd_args_->journal_path.empty()) {
+      throw std::invalid_argument("Path to journal is not provided.");
+    }
+    if (p_impl_->cmd_args_->xbel_path.empty()) {
+      throw std::invalid_argument("Path to XBEL document is not provided.");
+    }
+  }
+  return std::move(p_impl_->cmd_args_);
+}
+
+} // namespace compact
+} // namespace xbelmark
@@ -0,0 +1,42 @@
+#include "xbelmark/compact/compact.h"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+#include "xbelmark/compact/cmd_args.h"
+#include "xbelmark/compact/cmd_args_parser.h"
+#include "xbelmark/journal/journal.h"
+
+namespace xbelmark {
+namespace compact {
+
+int Execute(int argc, char *argv[]) {
+  std::unique_ptr<CmdArgs> cmd_args;
+  try {
+    cmd_args = CmdArgsParser().Parse(&argv[2], &argv[argc]);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  if (!cmd_args->help.empty()) {
+    std::cout << cmd_args->help << std::endl;
+    return 1;
+  }
+  xbelmark::journal::CompactResult result;
+  try {
+    result = xbelmark::journal::Compact(
+        cmd_args->journal_path, cmd_args->xbel_path);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  std::cout <<
+      "Added " << result.num_added << " bookmarks (" <<
+      result.num_duplicates << " duplicates, " <<
+      result.num_corrupted << " corrupted records skipped)." << std::endl;
+  return 0;
+}
+
+} // namespace compact
+} // namespace xbelmark
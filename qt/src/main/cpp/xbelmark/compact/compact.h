@@ -0,0 +1,15 @@
+#ifndef XBELMARK_COMPACT_COMPACT_H
+#define XBELMARK_COMPACT_COMPACT_H
+
+namespace xbelmark {
+namespace compact {
+
+/**
+ *  Executes the `compact` subcommand.
+ */
+int Execute(int argc, char *argv[]);
+
+} // namespace compact
+} // namespace xbelmark
+
+#endif
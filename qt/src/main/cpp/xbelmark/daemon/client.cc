@@ -0,0 +1,43 @@
+#include "xbelmark/daemon/client.h"
+
+#include <stdexcept>
+
+#include <QByteArray>
+#include <QDeadlineTimer>
+#include <QLocalSocket>
+
+#include "xbelmark/daemon/protocol.h"
+
+namespace xbelmark {
+namespace daemon {
+
+bool Request(
+    const QString &server_name,
+    const QJsonObject &request,
+    int timeout,
+    QJsonObject &response) {
+  QLocalSocket socket;
+  socket.connectToServer(server_name);
+  // A running daemon accepts the connection immediately.
+  if (!socket.waitForConnected(1000)) {
+    return false;
+  }
+  socket.write(EncodeMessage(request));
+  socket.flush();
+  QDeadlineTimer deadline(timeout < 0 ? QDeadlineTimer::Forever : timeout);
+  QByteArray buffer;
+  while (!DecodeMessage(buffer, response)) {
+    if (!socket.waitForReadyRead(
+            deadline.isForever() ? -1 :
+            static_cast<int>(deadline.remainingTime()))) {
+      throw std::runtime_error(
+          "No response from the daemon: " +
+          socket.errorString().toStdString());
+    }
+    buffer.append(socket.readAll());
+  }
+  return true;
+}
+
+} // namespace daemon
+} // namespace xbelmark
@@ -0,0 +1,40 @@
+#ifndef XBELMARK_DAEMON_CLIENT_H
+#define XBELMARK_DAEMON_CLIENT_H
+
+#include <QJsonObject>
+#include <QString>
+
+namespace xbelmark {
+namespace daemon {
+
+/**
+ *  Send a request to the daemon, and wait for its response.
+ *
+ *  @param server_name
+ *    Name of the local server of the daemon.
+ *
+ *  @param request
+ *    Request to send.
+ *
+ *  @param timeout
+ *    Time in milliseconds to wait for the response, or `-1` for no limit.
+ *
+ *  @param response
+ *    Response that is set if the daemon is running.
+ *
+ *  @return
+ *    Whether the daemon is running. If not, nothing has been sent.
+ *
+ *  @throw std::runtime_error
+ *    Request was sent, but no valid response was received.
+ */
+bool Request(
+    const QString &server_name,
+    const QJsonObject &request,
+    int timeout,
+    QJsonObject &response);
+
+} // namespace daemon
+} // namespace xbelmark
+
+#endif
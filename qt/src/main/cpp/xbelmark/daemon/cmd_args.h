@@ -0,0 +1,25 @@
+#ifndef XBELMARK_DAEMON_CMD_ARGS_H
+#define XBELMARK_DAEMON_CMD_ARGS_H
+
+#include <string>
+
+#include "xbelmark/cmd_args.h"
+
+namespace xbelmark {
+namespace daemon {
+
+/**
+ *  Command-line arguments for the `daemon` subcommand.
+ */
+struct CmdArgs : public xbelmark::CmdArgs {
+ public:
+  /**
+   *  Name of the local server, or an empty string for the default.
+   */
+  std::string name;
+};
+
+} // namespace daemon
+} // namespace xbelmark
+
+#endif
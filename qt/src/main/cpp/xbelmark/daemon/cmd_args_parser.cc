@@ -0,0 +1,117 @@
+#include "xbelmark/daemon/cmd_args_parser.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#define SUBCOMMAND_NAME "daemon"
+
+namespace xbelmark {
+namespace daemon {
+
+class CmdArgsParser::Impl final {
+ public:
+  /**
+   *  Reset the parser.
+   */
+  void Reset() {
+    cmd_args_.reset(new CmdArgs());
+    arg_it_ = nullptr;
+    arg_last_ = nullptr;
+    pos_arg_idx_ = -1;
+  }
+
+  /**
+   *  Set the help message that can be printed.
+   */
+  void SetHelpMessage() {
+    ++arg_it_;
+    std::string &help = cmd_args_->help;
+    if (!help.empty()) {
+      return;
+    }
+    help = help +
+        "Usage: " +
+        cmd_args_->command_name + " " + cmd_args_->subcommand_name +
+        " [options]\n\n" +
+        "Serve `paste` requests with a resident process so that the\n" +
+        "application, network, and cache are set up only once. A request\n" +
+        "is sent by `paste --daemon`.\n\n";
+    help = help +
+        "  --name [name]\n" +
+        "\n" +
+        "      Name of the local server. If not specified, a name that is\n" +
+        "      specific to the user is used.\n\n";
+    help = help +
+        "  --help, -h\n" +
+        "\n" +
+        "      Print help.";
+  }
+
+  /**
+   *  Set the name of the local server.
+   */
+  void SetName() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--name`.");
+    }
+    cmd_args_->name = *arg_it_++;
+  }
+
+  /**
+   *  Parsed command-line arguments.
+   */
+  std::unique_ptr<CmdArgs> cmd_args_;
+
+  /**
+   *  Pointer to the current command-line argument.
+   */
+  char **arg_it_;
+
+  /**
+   *  Pointer to past-the-last command-line argument.
+   */
+  char **arg_last_;
+
+  /**
+   *  Zero-based index of the current positional command-line argument.
+   *
+   *  It is `-1` if the current command-line argument is not positional.
+   */
+  int pos_arg_idx_;
+};
+
+CmdArgsParser::CmdArgsParser() : p_impl_(new Impl()) {
+}
+
+CmdArgsParser::~CmdArgsParser() = default;
+
+std::unique_ptr<CmdArgs> CmdArgsParser::Parse(char **first, char **last) {
+  p_impl_->Reset();
+  p_impl_->cmd_args_->subcommand_name = SUBCOMMAND_NAME;
+  p_impl_->arg_it_ = first;
+  p_impl_->arg_last_ = last;
+  // Parse the command-line arguments.
+  while (p_impl_->arg_it_ != p_impl_->arg_last_) {
+    if (p_impl_->pos_arg_idx_ == -1) {
+      const std::string opt(*p_impl_->arg_it_);
+      if (opt == "--help" || opt == "-h") {
+        p_impl_->SetHelpMessage();
+      } else if (opt == "--name") {
+        p_impl_->SetName();
+      } else if (opt.front() == '-') {
+        throw std::runtime_error("Unrecognized option: " + opt);
+      } else {
+        ++p_impl_->pos_arg_idx_;
+      }
+    } else {
+      const std::string arg(*p_impl_->arg_it_);
+      throw std::runtime_error("Unrecognized positional argument: " + arg);
+    }
+  }
+  return std::move(p_impl_->cmd_args_);
+}
+
+} // namespace daemon
+} // namespace xbelmark
@@ -0,0 +1,360 @@
+#include "xbelmark/daemon/daemon.h"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+#include <QDir>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QString>
+#include <QUrl>
+
+#include "xbelmark/daemon/cmd_args.h"
+#include "xbelmark/daemon/cmd_args_parser.h"
+#include "xbelmark/daemon/protocol.h"
+#include "xbelmark/html/info.h"
+#include "xbelmark/html/info_cache.h"
+#include "xbelmark/html/info_request.h"
+#include "xbelmark/html/latency_tracker.h"
+#include "xbelmark/html/retrieval_options.h"
+#include "xbelmark/paste/cmd_args.h"
+#include "xbelmark/paste/cmd_args_parser.h"
+#include "xbelmark/paste/duplicates.h"
+#include "xbelmark/paste/paste.h"
+#include "xbelmark/urlindex/url_index.h"
+
+using xbelmark::html::Info;
+using xbelmark::html::InfoCache;
+using xbelmark::html::InfoRequest;
+using xbelmark::html::LatencyTracker;
+using xbelmark::html::RetrievalOptions;
+using xbelmark::urlindex::UrlIndex;
+
+namespace xbelmark {
+namespace daemon {
+
+/**
+ *  State that is kept across requests.
+ */
+struct State {
+ public:
+  /**
+   *  Network access manager, which keeps connections, TLS sessions, and DNS
+   *  lookups for reuse.
+   */
+  QNetworkAccessManager manager;
+
+  /**
+   *  Caches by the paths to their directories.
+   */
+  std::map<std::string, std::unique_ptr<InfoCache>> caches;
+
+  /**
+   *  Latencies of the requests of all clients, from which the delay of
+   *  hedging is estimated.
+   */
+  LatencyTracker latency_tracker;
+};
+
+/**
+ *  Connection from a client.
+ */
+struct Connection {
+ public:
+  /**
+   *  Data that has been received but not decoded.
+   */
+  QByteArray buffer;
+
+  /**
+   *  Whether the request has been received.
+   */
+  bool has_request = false;
+};
+
+/**
+ *  Resolve the paths to the directories of the retrieval options against the
+ *  working directory of the client, as the `paste` subcommand would.
+ */
+void ResolvePaths(RetrievalOptions &options, const QDir &dir) {
+  const auto resolve = [&dir](std::string &path) -> void {
+    if (!path.empty()) {
+      path = QDir::cleanPath(dir.absoluteFilePath(QString::fromStdString(path)))
+          .toStdString();
+    }
+  };
+  resolve(options.cache_dir);
+  resolve(options.icon_cache_dir);
+  resolve(options.tls_session_dir);
+}
+
+/**
+ *  Cache of the retrieval options, which is opened once per directory.
+ *
+ *  @param options
+ *    Retrieval options whose paths have been resolved by
+ *    @link ResolvePaths @endlink, so that the cache is keyed by its absolute
+ *    path.
+ *
+ *  @return
+ *    Cache, or `nullptr` if caching is disabled.
+ */
+InfoCache *CacheOf(State &state, const RetrievalOptions &options) {
+  if (options.cache_dir.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<InfoCache> &cache = state.caches[options.cache_dir];
+  if (!cache) {
+    cache.reset(
+        new InfoCache(options.cache_dir, options.cache_max_entries));
+  }
+  return cache.get();
+}
+
+/**
+ *  Send a response to the client, and close the connection.
+ *
+ *  @param socket
+ *    Connection to the client, which is null if the client has disconnected.
+ */
+void Respond(
+    const QPointer<QLocalSocket> &socket,
+    const QJsonObject &response) {
+  if (!socket) {
+    return;
+  }
+  socket->write(EncodeMessage(response));
+  socket->disconnectFromServer();
+}
+
+/**
+ *  Response with an error.
+ */
+QJsonObject ErrorResponse(const std::string &message) {
+  QJsonObject retval;
+  retval.insert("status", 1);
+  retval.insert("error", QString::fromStdString(message));
+  return retval;
+}
+
+/**
+ *  Response with a warning about a duplicate bookmark that is not pasted.
+ */
+QJsonObject SkippedResponse(const std::string &warning) {
+  QJsonObject retval;
+  retval.insert("status", 0);
+  retval.insert("warning", QString::fromStdString(warning));
+  return retval;
+}
+
+/**
+ *  Response with the bookmark of an HTML document, which is written to a file
+ *  or to the output of the response.
+ *
+ *  @param url_index
+ *    Index of the collection, or `nullptr` if no collection is specified.
+ *
+ *  @param warning
+ *    Warning about the pasted URL being a duplicate, or an empty string if
+ *    it is not.
+ */
+QJsonObject BookmarkResponse(
+    const xbelmark::paste::CmdArgs &cmd_args,
+    const QDir &dir,
+    const Info &html_info,
+    UrlIndex *url_index,
+    std::string warning) {
+  QJsonObject retval;
+  try {
+    if (warning.empty()) {
+      warning = xbelmark::paste::DuplicateWarning(
+          cmd_args,
+          url_index,
+          QUrl(
+              QString::fromStdString(
+                  xbelmark::paste::BookmarkUri(cmd_args, html_info))));
+      if (!warning.empty() &&
+          cmd_args.duplicates == xbelmark::paste::Duplicates::SKIP) {
+        return SkippedResponse(warning);
+      }
+    }
+    std::ostringstream out;
+    const std::string path(
+        xbelmark::paste::WriteBookmark(
+            cmd_args, dir, html_info, url_index, out));
+    retval.insert("status", 0);
+    retval.insert("path", QString::fromStdString(path));
+    retval.insert("output", QString::fromStdString(out.str()));
+    retval.insert("warning", QString::fromStdString(warning));
+  } catch (const std::exception &e) {
+    retval = ErrorResponse(e.what());
+  }
+  return retval;
+}
+
+/**
+ *  Handle a paste request.
+ *
+ *  The request has the working directory of the client as `cwd` and the
+ *  command-line arguments of the `paste` subcommand as `args`. The response
+ *  has the exit status as `status`, and either the path to the bookmark file
+ *  as `path` or the standard output as `output`, or an error message as
+ *  `error`. A warning about a duplicate bookmark is given as `warning`.
+ */
+void Handle(
+    State &state,
+    const QPointer<QLocalSocket> &socket,
+    const QJsonObject &request) {
+  try {
+    std::vector<std::string> args;
+    for (const QJsonValue &value : request.value("args").toArray()) {
+      args.push_back(value.toString().toStdString());
+    }
+    std::vector<char *> argv;
+    for (std::string &arg : args) {
+      argv.push_back(&arg[0]);
+    }
+    std::shared_ptr<xbelmark::paste::CmdArgs> cmd_args(
+        xbelmark::paste::CmdArgsParser()
+            .Parse(argv.data(), argv.data() + argv.size()).release());
+    if (!cmd_args->help.empty()) {
+      QJsonObject response;
+      response.insert("status", 1);
+      response.insert("output", QString::fromStdString(cmd_args->help + "\n"));
+      Respond(socket, response);
+      return;
+    }
+    const QUrl url(xbelmark::paste::PastedUrl(*cmd_args));
+    const QDir dir(request.value("cwd").toString());
+    // The index is opened once per request, and is kept until the bookmark
+    // is written.
+    const std::shared_ptr<UrlIndex> url_index(
+        xbelmark::paste::OpenUrlIndex(*cmd_args, dir).release());
+    xbelmark::paste::PrepareCollection(*cmd_args, url_index.get());
+    const std::string warning(
+        xbelmark::paste::DuplicateWarning(*cmd_args, url_index.get(), url));
+    if (!warning.empty() &&
+        cmd_args->duplicates == xbelmark::paste::Duplicates::SKIP) {
+      Respond(socket, SkippedResponse(warning));
+      return;
+    }
+    if (!xbelmark::paste::NeedsRetrieval(*cmd_args)) {
+      Respond(
+          socket,
+          BookmarkResponse(
+              *cmd_args,
+              dir,
+              xbelmark::paste::GivenInfo(*cmd_args, url),
+              url_index.get(),
+              warning));
+      return;
+    }
+    xbelmark::paste::CompleteRetrievalOptions(*cmd_args);
+    ResolvePaths(cmd_args->retrieval_options, dir);
+    InfoRequest *info_request = new InfoRequest(
+        state.manager,
+        url,
+        cmd_args->retrieval_options,
+        CacheOf(state, cmd_args->retrieval_options),
+        &state.latency_tracker);
+    info_request->Start(
+        [info_request, cmd_args, dir, url_index, socket, warning]() -> void {
+          Info html_info(info_request->info());
+          if (!cmd_args->title.empty()) {
+            html_info.title = cmd_args->title;
+          }
+          info_request->deleteLater();
+          Respond(
+              socket,
+              BookmarkResponse(
+                  *cmd_args, dir, html_info, url_index.get(), warning));
+        });
+  } catch (const std::exception &e) {
+    Respond(socket, ErrorResponse(e.what()));
+  }
+}
+
+int Execute(int argc, char *argv[]) {
+  std::unique_ptr<CmdArgs> cmd_args;
+  try {
+    cmd_args = CmdArgsParser().Parse(&argv[2], &argv[argc]);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  if (!cmd_args->help.empty()) {
+    std::cout << cmd_args->help << std::endl;
+    return 1;
+  }
+  // The clipboard is read on behalf of the clients.
+  QGuiApplication gui_app(argc, argv);
+  const QString name(
+      cmd_args->name.empty() ?
+          DefaultServerName() : QString::fromStdString(cmd_args->name));
+  // Remove the socket of a daemon that has exited abnormally, but not of one
+  // that is running.
+  {
+    QLocalSocket socket;
+    socket.connectToServer(name);
+    if (socket.waitForConnected(1000)) {
+      std::cerr << "Daemon is already running." << std::endl;
+      return 1;
+    }
+  }
+  QLocalServer::removeServer(name);
+  QLocalServer server;
+  server.setSocketOptions(QLocalServer::UserAccessOption);
+  if (!server.listen(name)) {
+    std::cerr <<
+        "Cannot listen on " << name.toStdString() << ": " <<
+        server.errorString().toStdString() << std::endl;
+    return 1;
+  }
+  State state;
+  QObject::connect(
+      &server, &QLocalServer::newConnection,
+      &server, [&server, &state]() -> void {
+        while (QLocalSocket *socket = server.nextPendingConnection()) {
+          QObject::connect(
+              socket, &QLocalSocket::disconnected,
+              socket, &QObject::deleteLater);
+          std::shared_ptr<Connection> connection(new Connection());
+          QObject::connect(
+              socket, &QLocalSocket::readyRead,
+              socket, [&state, socket, connection]() -> void {
+                if (connection->has_request) {
+                  socket->readAll();
+                  return;
+                }
+                connection->buffer.append(socket->readAll());
+                QJsonObject request;
+                try {
+                  if (!DecodeMessage(connection->buffer, request)) {
+                    return;
+                  }
+                } catch (const std::exception &e) {
+                  Respond(socket, ErrorResponse(e.what()));
+                  return;
+                }
+                connection->has_request = true;
+                Handle(state, socket, request);
+              });
+        }
+      });
+  return gui_app.exec();
+}
+
+} // namespace daemon
+} // namespace xbelmark
@@ -0,0 +1,15 @@
+#ifndef XBELMARK_DAEMON_DAEMON_H
+#define XBELMARK_DAEMON_DAEMON_H
+
+namespace xbelmark {
+namespace daemon {
+
+/**
+ *  Executes the `daemon` subcommand.
+ */
+int Execute(int argc, char *argv[]);
+
+} // namespace daemon
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef XBELMARK_DAEMON_FRAME_H
+#define XBELMARK_DAEMON_FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace xbelmark {
+namespace daemon {
+
+/**
+ *  Number of bytes in the prefix of a frame, which is the size of its
+ *  payload.
+ */
+constexpr std::size_t kFramePrefixSize = 4;
+
+/**
+ *  Prefix of a frame, which is the size of its payload in four big-endian
+ *  bytes.
+ *
+ *  @param payload_size
+ *    Number of bytes in the payload.
+ */
+inline std::string FramePrefix(std::uint32_t payload_size) {
+  std::string retval(kFramePrefixSize, '\0');
+  for (std::size_t i = 0; i != kFramePrefixSize; ++i) {
+    retval[kFramePrefixSize - 1 - i] =
+        static_cast<char>((payload_size >> (8 * i)) & 0xFF);
+  }
+  return retval;
+}
+
+/**
+ *  Whether a complete frame is at the beginning of a buffer.
+ *
+ *  @param data
+ *    Data that has been received.
+ *
+ *  @param size
+ *    Number of bytes in `data`.
+ *
+ *  @param max_payload_size
+ *    Maximum number of bytes in a payload.
+ *
+ *  @param payload_size
+ *    Number of bytes in the payload, which is set if the frame is complete.
+ *    The payload follows the prefix.
+ *
+ *  @return
+ *    Whether the frame is complete.
+ *
+ *  @throw std::runtime_error
+ *    The payload is larger than `max_payload_size`.
+ */
+inline bool HasFrame(
+    const char *data,
+    std::size_t size,
+    std::uint32_t max_payload_size,
+    std::uint32_t &payload_size) {
+  if (size < kFramePrefixSize) {
+    return false;
+  }
+  std::uint32_t value = 0;
+  for (std::size_t i = 0; i != kFramePrefixSize; ++i) {
+    value = (value << 8) | static_cast<unsigned char>(data[i]);
+  }
+  if (value > max_payload_size) {
+    throw std::runtime_error("Message is too large.");
+  }
+  if (size - kFramePrefixSize < value) {
+    return false;
+  }
+  payload_size = value;
+  return true;
+}
+
+} // namespace daemon
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,59 @@
+#include "xbelmark/daemon/protocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QtGlobal>
+
+#include "xbelmark/daemon/frame.h"
+
+namespace xbelmark {
+namespace daemon {
+
+QString DefaultServerName() {
+  QString user(qEnvironmentVariable("USER"));
+  if (user.isEmpty()) {
+    user = qEnvironmentVariable("USERNAME");
+  }
+  return "xbelmark-daemon-" + user;
+}
+
+QByteArray EncodeMessage(const QJsonObject &message) {
+  const QByteArray json(QJsonDocument(message).toJson(QJsonDocument::Compact));
+  const std::string prefix(
+      FramePrefix(static_cast<std::uint32_t>(json.size())));
+  QByteArray retval;
+  retval.reserve(static_cast<int>(prefix.size()) + json.size());
+  retval.append(prefix.data(), static_cast<int>(prefix.size()));
+  retval.append(json);
+  return retval;
+}
+
+bool DecodeMessage(QByteArray &buffer, QJsonObject &message) {
+  std::uint32_t size = 0;
+  if (!HasFrame(
+          buffer.constData(),
+          static_cast<std::size_t>(buffer.size()),
+          static_cast<std::uint32_t>(kMaxMessageSize),
+          size)) {
+    return false;
+  }
+  const int prefix_size = static_cast<int>(kFramePrefixSize);
+  QJsonParseError error;
+  const QJsonDocument doc(
+      QJsonDocument::fromJson(
+          buffer.mid(prefix_size, static_cast<int>(size)), &error));
+  buffer.remove(0, prefix_size + static_cast<int>(size));
+  if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+    throw std::runtime_error("Message is not a JSON object.");
+  }
+  message = doc.object();
+  return true;
+}
+
+} // namespace daemon
+} // namespace xbelmark
@@ -0,0 +1,54 @@
+#ifndef XBELMARK_DAEMON_PROTOCOL_H
+#define XBELMARK_DAEMON_PROTOCOL_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+namespace xbelmark {
+namespace daemon {
+
+/**
+ *  Maximum size in bytes of the JSON of a message.
+ */
+constexpr int kMaxMessageSize = 16 * 1024 * 1024;
+
+/**
+ *  Name of the local server of the daemon of the current user.
+ */
+QString DefaultServerName();
+
+/**
+ *  Encode a message as its size in four big-endian bytes followed by its
+ *  compact JSON.
+ *
+ *  @param message
+ *    Message to encode.
+ *
+ *  @return
+ *    Encoded message.
+ */
+QByteArray EncodeMessage(const QJsonObject &message);
+
+/**
+ *  Decode a message from the beginning of a buffer.
+ *
+ *  @param buffer
+ *    Data that has been received. The encoded message is removed from it if
+ *    it is complete.
+ *
+ *  @param message
+ *    Message that is set if it is complete.
+ *
+ *  @return
+ *    Whether a complete message has been decoded.
+ *
+ *  @throw std::runtime_error
+ *    The message is too large or is not a JSON object.
+ */
+bool DecodeMessage(QByteArray &buffer, QJsonObject &message);
+
+} // namespace daemon
+} // namespace xbelmark
+
+#endif
@@ -40,7 +40,14 @@ inline std::tm EpochTm() {
 inline int RawOffset() {
   std::tm local_tm(EpochTm());
   const std::time_t local_time(std::mktime(&local_tm));
-  std::tm utc_tm(*std::gmtime(&local_time));
+  // Reentrant, since extension functions are called by concurrent
+  // transformations.
+  std::tm utc_tm;
+#ifdef WIN32
+  gmtime_s(&utc_tm, &local_time);
+#else
+  gmtime_r(&local_time, &utc_tm);
+#endif
   return static_cast<int>(std::difftime(local_time, std::mktime(&utc_tm)));
 }
 
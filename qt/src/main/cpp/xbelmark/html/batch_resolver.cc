@@ -0,0 +1,136 @@
+#include "xbelmark/html/batch_resolver.h"
+
+#include <deque>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#include <QEventLoop>
+
+#include "xbelmark/html/info_cache.h"
+#include "xbelmark/html/info_request.h"
+#include "xbelmark/html/latency_tracker.h"
+
+namespace xbelmark {
+namespace html {
+
+class BatchResolver::Impl final {
+ public:
+  /**
+   *  URL that is waiting to be resolved.
+   */
+  struct Job {
+    QUrl url;
+
+    Callback callback;
+  };
+
+  /**
+   *  Start queued jobs until the maximum number of requests are in flight.
+   */
+  void Dispatch() {
+    while (static_cast<int>(in_flight_.size()) < max_in_flight_ &&
+           !queue_.empty()) {
+      Job job(std::move(queue_.front()));
+      queue_.pop_front();
+      InfoRequest *request = new InfoRequest(
+          manager_, job.url, options_, cache_.get(), &latency_tracker_);
+      in_flight_.insert(request);
+      Callback callback(std::move(job.callback));
+      request->Start([this, request, callback]() -> void {
+        Complete(request, callback);
+      });
+    }
+  }
+
+  /**
+   *  Hand the information to the callback of a finished request, and start
+   *  the next queued job.
+   */
+  void Complete(InfoRequest *request, const Callback &callback) {
+    in_flight_.erase(request);
+    // The request owns the function being executed.
+    request->deleteLater();
+    if (callback) {
+      callback(request->info());
+    }
+    Dispatch();
+    if (wait_loop_ && in_flight_.empty() && queue_.empty()) {
+      wait_loop_->quit();
+    }
+  }
+
+  QNetworkAccessManager manager_;
+
+  RetrievalOptions options_;
+
+  /**
+   *  Cache shared by the requests, or `nullptr` if there is none.
+   */
+  std::unique_ptr<InfoCache> cache_;
+
+  /**
+   *  Latencies of the requests, from which the delay of hedging is estimated.
+   */
+  LatencyTracker latency_tracker_;
+
+  int max_in_flight_;
+
+  std::deque<Job> queue_;
+
+  std::set<InfoRequest *> in_flight_;
+
+  /**
+   *  Event loop run by @link WaitForAll @endlink, or `nullptr` if it is not
+   *  running.
+   */
+  QEventLoop *wait_loop_ = nullptr;
+};
+
+BatchResolver::BatchResolver(
+    int max_in_flight,
+    const RetrievalOptions &options) : p_impl_(new Impl()) {
+  if (max_in_flight < 1) {
+    throw std::invalid_argument(
+        "Maximum number of requests in flight is not positive.");
+  }
+  p_impl_->max_in_flight_ = max_in_flight;
+  p_impl_->options_ = options;
+  if (!options.cache_dir.empty()) {
+    p_impl_->cache_.reset(
+        new InfoCache(options.cache_dir, options.cache_max_entries));
+  }
+}
+
+BatchResolver::~BatchResolver() {
+  for (InfoRequest *request : p_impl_->in_flight_) {
+    delete request;
+  }
+}
+
+QNetworkAccessManager &BatchResolver::manager() {
+  return p_impl_->manager_;
+}
+
+void BatchResolver::Enqueue(const QUrl &url, Callback callback) {
+  p_impl_->queue_.push_back(Impl::Job { url, std::move(callback) });
+  p_impl_->Dispatch();
+}
+
+std::size_t BatchResolver::num_pending() const {
+  return p_impl_->queue_.size() + p_impl_->in_flight_.size();
+}
+
+void BatchResolver::WaitForAll() {
+  if (num_pending() == 0) {
+    return;
+  }
+  QEventLoop loop;
+  p_impl_->wait_loop_ = &loop;
+  loop.exec();
+  p_impl_->wait_loop_ = nullptr;
+}
+
+} // namespace html
+} // namespace xbelmark
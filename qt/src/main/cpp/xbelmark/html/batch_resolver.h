@@ -0,0 +1,89 @@
+#ifndef XBELMARK_HTML_BATCH_RESOLVER_H
+#define XBELMARK_HTML_BATCH_RESOLVER_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include <QNetworkAccessManager>
+#include <QUrl>
+
+#include "xbelmark/html/info.h"
+#include "xbelmark/html/retrieval_options.h"
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Resolver of information about many HTML documents concurrently.
+ *
+ *  All requests share one network access manager, so connections (including
+ *  multiplexed HTTP/2 connections) are reused across requests to the same
+ *  host. At most a bounded number of requests are in flight at a time, and the
+ *  rest are queued in the order that they were enqueued.
+ *
+ *  Progress is made only while an event loop is running in the thread of the
+ *  resolver, such as the one run by @link WaitForAll @endlink.
+ */
+class BatchResolver final {
+ public:
+  /**
+   *  Function that is called with the information about an HTML document once
+   *  it has been retrieved.
+   */
+  using Callback = std::function<void(const Info &)>;
+
+  /**
+   *  @param max_in_flight
+   *    Maximum number of requests in flight at a time. It must be positive.
+   *
+   *  @param options
+   *    Options for each retrieval.
+   */
+  BatchResolver(
+      int max_in_flight,
+      const RetrievalOptions &options = RetrievalOptions());
+
+  /**
+   *  Requests in flight are aborted without their callbacks being called.
+   */
+  ~BatchResolver();
+
+  /**
+   *  Network access manager shared by the requests.
+   */
+  QNetworkAccessManager &manager();
+
+  /**
+   *  Enqueue a URL to be resolved.
+   *
+   *  @param url
+   *    URL to the HTML document.
+   *
+   *  @param callback
+   *    Function that is called, in the order of completion, once the
+   *    information has been retrieved. More URLs can be enqueued from within
+   *    it.
+   */
+  void Enqueue(const QUrl &url, Callback callback);
+
+  /**
+   *  Number of URLs that are queued or in flight.
+   */
+  std::size_t num_pending() const;
+
+  /**
+   *  Run an event loop until all enqueued URLs have been resolved.
+   */
+  void WaitForAll();
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef XBELMARK_HTML_CACHE_POLICY_H
+#define XBELMARK_HTML_CACHE_POLICY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Whether a cached entry is used without being revalidated.
+ *
+ *  An entry that was stored in the future, such as after the clock was set
+ *  back, is not fresh.
+ *
+ *  @param stored_at
+ *    When the entry was stored or last revalidated, in seconds since epoch.
+ *
+ *  @param now
+ *    Current time in seconds since epoch.
+ *
+ *  @param ttl
+ *    Age in seconds up to which the entry is fresh.
+ */
+inline bool IsFreshEntry(long long stored_at, long long now, long long ttl) {
+  const long long age = now - stored_at;
+  return age >= 0 && age <= ttl;
+}
+
+/**
+ *  Headers of a conditional request that revalidates a cached entry.
+ *
+ *  @param etag
+ *    Value of the `ETag` header of the cached response, or an empty string
+ *    if there was none.
+ *
+ *  @param last_modified
+ *    Value of the `Last-Modified` header of the cached response, or an empty
+ *    string if there was none.
+ *
+ *  @return
+ *    Names and values of the headers, which are none if the entry cannot be
+ *    revalidated.
+ */
+inline std::vector<std::pair<std::string, std::string>> RevalidationHeaders(
+    const std::string &etag,
+    const std::string &last_modified) {
+  std::vector<std::pair<std::string, std::string>> retval;
+  if (!etag.empty()) {
+    retval.emplace_back("If-None-Match", etag);
+  }
+  if (!last_modified.empty()) {
+    retval.emplace_back("If-Modified-Since", last_modified);
+  }
+  return retval;
+}
+
+/**
+ *  Whether a response confirms that a cached entry is still valid.
+ *
+ *  @param status_code
+ *    HTTP status code of the response.
+ *
+ *  @param has_cached_entry
+ *    Whether the request revalidated a cached entry.
+ */
+inline bool IsRevalidated(int status_code, bool has_cached_entry) {
+  return status_code == 304 && has_cached_entry;
+}
+
+/**
+ *  Whether the information from a response is stored in the cache.
+ *
+ *  Only complete or ranged successful responses are stored, since a title
+ *  that was read without the metadata would be incomplete.
+ *
+ *  @param status_code
+ *    HTTP status code of the response.
+ *
+ *  @param has_metadata
+ *    Whether the metadata was read in addition to the title.
+ *
+ *  @param has_error
+ *    Whether the retrieval failed.
+ */
+inline bool IsCacheableResponse(
+    int status_code, bool has_metadata, bool has_error) {
+  return has_metadata && !has_error &&
+      (status_code == 200 || status_code == 206);
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
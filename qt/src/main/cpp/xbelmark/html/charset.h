@@ -0,0 +1,291 @@
+#ifndef XBELMARK_HTML_CHARSET_H
+#define XBELMARK_HTML_CHARSET_H
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Number of bytes at the beginning of an HTML document that are examined for
+ *  a character encoding declaration.
+ */
+constexpr std::size_t kCharsetSniffSize = 1024;
+
+/**
+ *  Canonical name of a character encoding label.
+ *
+ *  Labels that browsers treat as Windows-1252 or Shift_JIS are mapped to
+ *  `windows-1252` and `shift_jis`, respectively.
+ *
+ *  @param label
+ *    Character encoding label, such as the value of a `charset` parameter.
+ *
+ *  @return
+ *    Label in lowercase with surrounding whitespace and quotes removed, or
+ *    its canonical name if it is an alias.
+ */
+inline std::string CanonicalCharset(const std::string &label) {
+  std::string retval;
+  for (char ch : label) {
+    if (!std::isspace(static_cast<unsigned char>(ch)) &&
+        ch != '"' && ch != '\'') {
+      retval += static_cast<char>(
+          std::tolower(static_cast<unsigned char>(ch)));
+    }
+  }
+  if (retval == "utf8") {
+    return "utf-8";
+  }
+  if (retval == "ascii" || retval == "us-ascii" ||
+      retval == "iso-8859-1" || retval == "iso8859-1" ||
+      retval == "latin1" || retval == "l1" || retval == "cp1252") {
+    return "windows-1252";
+  }
+  if (retval == "shift-jis" || retval == "sjis" || retval == "x-sjis" ||
+      retval == "ms_kanji" || retval == "windows-31j") {
+    return "shift_jis";
+  }
+  return retval;
+}
+
+/**
+ *  Character encoding declared in the value of a `Content-Type` header.
+ *
+ *  @param content_type
+ *    Value of a `Content-Type` header, such as `text/html; charset=UTF-8`.
+ *
+ *  @return
+ *    Canonical name of the character encoding, or an empty string if none is
+ *    declared.
+ */
+inline std::string CharsetFromContentType(const std::string &content_type) {
+  std::string lower(content_type);
+  for (char &ch : lower) {
+    ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+  }
+  const std::size_t pos = lower.find("charset");
+  if (pos == std::string::npos) {
+    return "";
+  }
+  std::size_t first = pos + 7;
+  while (first != lower.size() &&
+         std::isspace(static_cast<unsigned char>(lower[first]))) {
+    ++first;
+  }
+  if (first == lower.size() || lower[first] != '=') {
+    return "";
+  }
+  ++first;
+  const std::size_t last = lower.find(';', first);
+  return CanonicalCharset(
+      content_type.substr(
+          first, last == std::string::npos ? std::string::npos : last - first));
+}
+
+/**
+ *  Character encoding declared by a byte order mark or a `meta` element at
+ *  the beginning of an HTML document.
+ *
+ *  This is a simplified form of the prescan algorithm of the HTML standard,
+ *  which examines at most @link kCharsetSniffSize @endlink bytes.
+ *
+ *  @param data
+ *    Beginning of the HTML document.
+ *
+ *  @param size
+ *    Number of bytes in `data`.
+ *
+ *  @return
+ *    Canonical name of the character encoding, or an empty string if none is
+ *    declared.
+ */
+inline std::string SniffCharset(const char *data, std::size_t size) {
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+  if (size >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+    return "utf-8";
+  }
+  if (size >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF) {
+    return "utf-16be";
+  }
+  if (size >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) {
+    return "utf-16le";
+  }
+  std::string head(data, size < kCharsetSniffSize ? size : kCharsetSniffSize);
+  for (char &ch : head) {
+    ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+  }
+  std::size_t pos = 0;
+  while ((pos = head.find('<', pos)) != std::string::npos) {
+    if (head.compare(pos, 4, "<!--") == 0) {
+      pos = head.find("-->", pos + 4);
+      if (pos == std::string::npos) {
+        break;
+      }
+      continue;
+    }
+    const std::size_t tag_end = head.find('>', pos);
+    if (tag_end == std::string::npos) {
+      break;
+    }
+    if (head.compare(pos, 5, "<meta") != 0 ||
+        !(std::isspace(static_cast<unsigned char>(head[pos + 5])) ||
+          head[pos + 5] == '/')) {
+      pos = tag_end;
+      continue;
+    }
+    // Parse the attributes of the `meta` element.
+    std::string charset;
+    std::string content;
+    bool is_content_type = false;
+    std::size_t i = pos + 5;
+    while (i < tag_end) {
+      while (i < tag_end &&
+             (std::isspace(static_cast<unsigned char>(head[i])) ||
+              head[i] == '/')) {
+        ++i;
+      }
+      const std::size_t name_first = i;
+      while (i < tag_end && head[i] != '=' && head[i] != '/' &&
+             !std::isspace(static_cast<unsigned char>(head[i]))) {
+        ++i;
+      }
+      const std::string name(head.substr(name_first, i - name_first));
+      while (i < tag_end && std::isspace(static_cast<unsigned char>(head[i]))) {
+        ++i;
+      }
+      std::string value;
+      if (i < tag_end && head[i] == '=') {
+        ++i;
+        while (i < tag_end &&
+               std::isspace(static_cast<unsigned char>(head[i]))) {
+          ++i;
+        }
+        if (i < tag_end && (head[i] == '"' || head[i] == '\'')) {
+          const char quote = head[i++];
+          const std::size_t value_first = i;
+          while (i < tag_end && head[i] != quote) {
+            ++i;
+          }
+          value = head.substr(value_first, i - value_first);
+          ++i;
+        } else {
+          const std::size_t value_first = i;
+          while (i < tag_end &&
+                 !std::isspace(static_cast<unsigned char>(head[i]))) {
+            ++i;
+          }
+          value = head.substr(value_first, i - value_first);
+        }
+      }
+      if (name == "charset") {
+        charset = CanonicalCharset(value);
+      } else if (name == "content") {
+        content = value;
+      } else if (name == "http-equiv") {
+        is_content_type = value == "content-type";
+      }
+    }
+    if (charset.empty() && is_content_type) {
+      charset = CharsetFromContentType(content);
+    }
+    if (!charset.empty()) {
+      // A document whose bytes can declare it cannot be UTF-16.
+      if (charset.compare(0, 6, "utf-16") == 0) {
+        return "utf-8";
+      }
+      return charset;
+    }
+    pos = tag_end;
+  }
+  return "";
+}
+
+/**
+ *  Whether a byte sequence is valid UTF-8.
+ *
+ *  Runs of ASCII are skipped eight bytes at a time, since they dominate most
+ *  HTML documents.
+ *
+ *  @param data
+ *    Byte sequence.
+ *
+ *  @param size
+ *    Number of bytes in `data`.
+ *
+ *  @param is_prefix
+ *    Whether `data` is only the beginning of the byte sequence, in which case
+ *    an incomplete character at the end is not an error.
+ *
+ *  @return
+ *    Whether `data` is valid UTF-8.
+ */
+inline bool IsValidUtf8(
+    const char *data,
+    std::size_t size,
+    bool is_prefix = false) {
+  const unsigned char *it = reinterpret_cast<const unsigned char *>(data);
+  const unsigned char *last = it + size;
+  while (it != last) {
+    if (last - it >= 8) {
+      std::uint64_t word;
+      std::memcpy(&word, it, sizeof(word));
+      if ((word & UINT64_C(0x8080808080808080)) == 0) {
+        it += 8;
+        continue;
+      }
+    }
+    const unsigned char lead = *it;
+    if (lead < 0x80) {
+      ++it;
+      continue;
+    }
+    std::size_t len;
+    unsigned char min_next = 0x80;
+    unsigned char max_next = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      len = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      len = 3;
+      if (lead == 0xE0) {
+        // Overlong encoding.
+        min_next = 0xA0;
+      } else if (lead == 0xED) {
+        // Surrogate.
+        max_next = 0x9F;
+      }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      len = 4;
+      if (lead == 0xF0) {
+        // Overlong encoding.
+        min_next = 0x90;
+      } else if (lead == 0xF4) {
+        // Beyond U+10FFFF.
+        max_next = 0x8F;
+      }
+    } else {
+      return false;
+    }
+    for (std::size_t i = 1; i != len; ++i) {
+      if (it + i == last) {
+        return is_prefix;
+      }
+      const unsigned char next = it[i];
+      if (next < (i == 1 ? min_next : 0x80) ||
+          next > (i == 1 ? max_next : 0xBF)) {
+        return false;
+      }
+    }
+    it += len;
+  }
+  return true;
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
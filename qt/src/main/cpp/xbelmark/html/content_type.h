@@ -0,0 +1,366 @@
+#ifndef XBELMARK_HTML_CONTENT_TYPE_H
+#define XBELMARK_HTML_CONTENT_TYPE_H
+
+#include <cctype>
+#include <climits>
+#include <cstddef>
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Media type of the value of a `Content-Type` header.
+ *
+ *  @param content_type
+ *    Value of a `Content-Type` header, such as `text/html; charset=UTF-8`.
+ *
+ *  @return
+ *    Media type in lowercase without parameters, such as `text/html`.
+ */
+inline std::string MediaType(const std::string &content_type) {
+  std::string retval;
+  for (char ch : content_type.substr(0, content_type.find(';'))) {
+    if (!std::isspace(static_cast<unsigned char>(ch))) {
+      retval += static_cast<char>(
+          std::tolower(static_cast<unsigned char>(ch)));
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Whether a resource with a given `Content-Type` can have an HTML title.
+ *
+ *  @param content_type
+ *    Value of a `Content-Type` header.
+ *
+ *  @return
+ *    Whether the media type is HTML or XHTML, or is missing.
+ */
+inline bool IsHtmlMediaType(const std::string &content_type) {
+  const std::string media_type(MediaType(content_type));
+  return media_type.empty() ||
+      media_type == "text/html" ||
+      media_type == "application/xhtml+xml";
+}
+
+/**
+ *  UTF-8 encoding of a code point.
+ */
+inline void AppendUtf8(std::string &output, unsigned long code_point) {
+  if (code_point < 0x80) {
+    output += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    output += static_cast<char>(0xC0 | (code_point >> 6));
+    output += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    output += static_cast<char>(0xE0 | (code_point >> 12));
+    output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    output += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    output += static_cast<char>(0xF0 | (code_point >> 18));
+    output += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    output += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+/**
+ *  UTF-8 form of a Latin-1 string.
+ */
+inline std::string Latin1ToUtf8(const std::string &input) {
+  std::string retval;
+  for (char ch : input) {
+    AppendUtf8(retval, static_cast<unsigned char>(ch));
+  }
+  return retval;
+}
+
+/**
+ *  UTF-8 form of a UTF-16BE string, where unpaired surrogates are dropped.
+ */
+inline std::string Utf16BeToUtf8(const std::string &input) {
+  std::string retval;
+  unsigned long high_surrogate = 0;
+  for (std::size_t i = 0; i + 1 < input.size(); i += 2) {
+    const unsigned long unit =
+        (static_cast<unsigned char>(input[i]) << 8) |
+        static_cast<unsigned char>(input[i + 1]);
+    if (unit >= 0xD800 && unit <= 0xDBFF) {
+      high_surrogate = unit;
+    } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+      if (high_surrogate != 0) {
+        AppendUtf8(
+            retval,
+            0x10000 + ((high_surrogate - 0xD800) << 10) + (unit - 0xDC00));
+      }
+      high_surrogate = 0;
+    } else {
+      AppendUtf8(retval, unit);
+      high_surrogate = 0;
+    }
+  }
+  return retval;
+}
+
+/**
+ *  File name in the value of a `Content-Disposition` header.
+ *
+ *  The extended `filename*` parameter takes precedence over `filename`.
+ *
+ *  @param content_disposition
+ *    Value of a `Content-Disposition` header, such as
+ *    `attachment; filename="report.pdf"`.
+ *
+ *  @return
+ *    File name in UTF-8, or an empty string if none is given.
+ */
+inline std::string FileNameFromContentDisposition(
+    const std::string &content_disposition) {
+  std::string lower(content_disposition);
+  for (char &ch : lower) {
+    ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+  }
+  // Extended parameter in the form of `filename*=UTF-8'lang'name%20here`.
+  std::size_t pos = lower.find("filename*=");
+  if (pos != std::string::npos) {
+    const std::size_t first = pos + 10;
+    const std::size_t last = content_disposition.find(';', first);
+    const std::string value(
+        content_disposition.substr(
+            first,
+            last == std::string::npos ? std::string::npos : last - first));
+    const std::size_t charset_end = value.find('\'');
+    const std::size_t language_end = charset_end == std::string::npos ?
+        std::string::npos : value.find('\'', charset_end + 1);
+    if (language_end != std::string::npos) {
+      const std::string charset(lower.substr(first, charset_end));
+      std::string decoded;
+      for (std::size_t i = language_end + 1; i < value.size(); ++i) {
+        if (value[i] == '%' && i + 2 < value.size() &&
+            std::isxdigit(static_cast<unsigned char>(value[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(value[i + 2]))) {
+          decoded += static_cast<char>(
+              std::stoi(value.substr(i + 1, 2), nullptr, 16));
+          i += 2;
+        } else if (!std::isspace(static_cast<unsigned char>(value[i]))) {
+          decoded += value[i];
+        }
+      }
+      if (!decoded.empty()) {
+        return charset == "utf-8" ? decoded : Latin1ToUtf8(decoded);
+      }
+    }
+  }
+  // Regular parameter in the form of `filename="name here"`.
+  pos = lower.find("filename=");
+  if (pos == std::string::npos) {
+    return "";
+  }
+  std::size_t first = pos + 9;
+  std::string retval;
+  if (first < content_disposition.size() && content_disposition[first] == '"') {
+    for (std::size_t i = first + 1; i < content_disposition.size(); ++i) {
+      if (content_disposition[i] == '\\' &&
+          i + 1 < content_disposition.size()) {
+        retval += content_disposition[++i];
+      } else if (content_disposition[i] == '"') {
+        break;
+      } else {
+        retval += content_disposition[i];
+      }
+    }
+  } else {
+    const std::size_t last = content_disposition.find(';', first);
+    retval = content_disposition.substr(
+        first, last == std::string::npos ? std::string::npos : last - first);
+    while (!retval.empty() &&
+           std::isspace(static_cast<unsigned char>(retval.back()))) {
+      retval.pop_back();
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Byte range in the value of a `Content-Range` header.
+ *
+ *  @param content_range
+ *    Value of a `Content-Range` header, such as `bytes 0-16383/52811`.
+ *
+ *  @param first
+ *    Offset of the first byte in the range.
+ *
+ *  @param last
+ *    Offset of the last byte in the range.
+ *
+ *  @param complete_length
+ *    Length of the resource, or `-1` if it is unknown.
+ *
+ *  @return
+ *    Whether `content_range` is a satisfied byte range. If not, the output
+ *    parameters are unspecified.
+ */
+inline bool ParseContentRange(
+    const std::string &content_range,
+    long long &first,
+    long long &last,
+    long long &complete_length) {
+  const std::string &str = content_range;
+  std::size_t i = 0;
+  while (i < str.size() && std::isspace(static_cast<unsigned char>(str[i]))) {
+    ++i;
+  }
+  if (str.compare(i, 6, "bytes ") != 0) {
+    return false;
+  }
+  i += 6;
+  long long *const values[] = { &first, &last, &complete_length };
+  const char delimiters[] = { '-', '/', '\0' };
+  for (int j = 0; j != 3; ++j) {
+    if (j == 2 && i < str.size() && str[i] == '*') {
+      complete_length = -1;
+      ++i;
+      break;
+    }
+    if (i == str.size() || !std::isdigit(static_cast<unsigned char>(str[i]))) {
+      return false;
+    }
+    long long value = 0;
+    for (; i < str.size() && std::isdigit(static_cast<unsigned char>(str[i]));
+         ++i) {
+      if (value > (LLONG_MAX - 9) / 10) {
+        return false;
+      }
+      value = value * 10 + (str[i] - '0');
+    }
+    *values[j] = value;
+    if (delimiters[j] != '\0') {
+      if (i == str.size() || str[i] != delimiters[j]) {
+        return false;
+      }
+      ++i;
+    }
+  }
+  while (i < str.size() && std::isspace(static_cast<unsigned char>(str[i]))) {
+    ++i;
+  }
+  return i == str.size() && first <= last &&
+      (complete_length < 0 || last < complete_length);
+}
+
+/**
+ *  Title in the document information dictionary of a PDF file.
+ *
+ *  Only uncompressed objects are searched, which covers the document
+ *  information dictionary of most PDF files.
+ *
+ *  @param data
+ *    Bytes of the PDF file, which can be only a part of the file.
+ *
+ *  @param size
+ *    Number of bytes in `data`.
+ *
+ *  @return
+ *    Title in UTF-8, or an empty string if it is not found.
+ */
+inline std::string PdfTitle(const char *data, std::size_t size) {
+  const std::string pdf(data, size);
+  std::size_t pos = 0;
+  while ((pos = pdf.find("/Title", pos)) != std::string::npos) {
+    std::size_t i = pos + 6;
+    pos = i;
+    while (i < pdf.size() && std::isspace(static_cast<unsigned char>(pdf[i]))) {
+      ++i;
+    }
+    if (i == pdf.size()) {
+      break;
+    }
+    std::string raw;
+    if (pdf[i] == '(') {
+      // Literal string, which can contain balanced parentheses and escapes.
+      int depth = 1;
+      for (++i; i < pdf.size(); ++i) {
+        const char ch = pdf[i];
+        if (ch == '\\' && i + 1 < pdf.size()) {
+          const char next = pdf[++i];
+          switch (next) {
+            case 'n': raw += '\n'; break;
+            case 'r': raw += '\r'; break;
+            case 't': raw += '\t'; break;
+            case 'b': raw += '\b'; break;
+            case 'f': raw += '\f'; break;
+            case '\r':
+            case '\n':
+              break;
+            default:
+              if (next >= '0' && next <= '7') {
+                int value = next - '0';
+                for (int j = 0;
+                     j != 2 && i + 1 < pdf.size() &&
+                     pdf[i + 1] >= '0' && pdf[i + 1] <= '7';
+                     ++j) {
+                  value = value * 8 + (pdf[++i] - '0');
+                }
+                raw += static_cast<char>(value);
+              } else {
+                raw += next;
+              }
+              break;
+          }
+        } else if (ch == '(') {
+          ++depth;
+          raw += ch;
+        } else if (ch == ')') {
+          if (--depth == 0) {
+            break;
+          }
+          raw += ch;
+        } else {
+          raw += ch;
+        }
+      }
+      if (depth != 0) {
+        break;
+      }
+    } else if (pdf[i] == '<' && i + 1 < pdf.size() && pdf[i + 1] != '<') {
+      // Hexadecimal string.
+      std::string digits;
+      for (++i; i < pdf.size() && pdf[i] != '>'; ++i) {
+        if (std::isxdigit(static_cast<unsigned char>(pdf[i]))) {
+          digits += pdf[i];
+        }
+      }
+      if (i == pdf.size()) {
+        break;
+      }
+      if (digits.size() % 2 != 0) {
+        digits += '0';
+      }
+      for (std::size_t j = 0; j < digits.size(); j += 2) {
+        raw += static_cast<char>(std::stoi(digits.substr(j, 2), nullptr, 16));
+      }
+    } else {
+      continue;
+    }
+    std::string retval;
+    if (raw.size() >= 2 &&
+        static_cast<unsigned char>(raw[0]) == 0xFE &&
+        static_cast<unsigned char>(raw[1]) == 0xFF) {
+      retval = Utf16BeToUtf8(raw.substr(2));
+    } else {
+      // PDFDocEncoding coincides with Latin-1 for printable characters.
+      retval = Latin1ToUtf8(raw);
+    }
+    if (!retval.empty()) {
+      return retval;
+    }
+  }
+  return "";
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef XBELMARK_HTML_FILE_NAME_H
+#define XBELMARK_HTML_FILE_NAME_H
+
+#include <cstddef>
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Default maximum number of bytes in a sanitized file name, which leaves
+ *  room under the limit of 255 for a number and an extension, such as
+ *  ` (1000).xbel`.
+ */
+constexpr std::size_t kMaxFileNameBytes = 240;
+
+/**
+ *  Default maximum number of UTF-16 code units in a sanitized file name, which
+ *  is the measure of the limit under Windows.
+ */
+constexpr std::size_t kMaxFileNameUtf16Units = 240;
+
+/**
+ *  Whether a file name is a reserved device name under Windows, such as `CON`
+ *  or `com1.txt`.
+ *
+ *  @param file_name
+ *    File name, whose part before the first dot is compared without regard to
+ *    case.
+ */
+inline bool IsReservedDeviceName(const std::string &file_name) {
+  std::string stem(file_name.substr(0, file_name.find('.')));
+  while (!stem.empty() && stem.back() == ' ') {
+    stem.pop_back();
+  }
+  for (char &ch : stem) {
+    if (ch >= 'a' && ch <= 'z') {
+      ch = static_cast<char>(ch - 'a' + 'A');
+    }
+  }
+  if (stem.size() == 3) {
+    return stem == "CON" || stem == "PRN" || stem == "AUX" || stem == "NUL";
+  }
+  if (stem.size() == 4) {
+    const std::string prefix(stem.substr(0, 3));
+    return (prefix == "COM" || prefix == "LPT") &&
+        stem[3] >= '1' && stem[3] <= '9';
+  }
+  return false;
+}
+
+/**
+ *  Title sanitized in a single pass into a file name that is legal under
+ *  Windows.
+ *
+ *  Leading and trailing whitespace is removed, and intervening whitespace is
+ *  replaced with a single space character. Reserved characters (`<>:"/\|?*`),
+ *  control characters, and bytes that do not start a UTF-8 sequence are
+ *  replaced with an underscore. Trailing dots are removed, and an underscore
+ *  is appended to a reserved device name. The title is truncated at a code
+ *  point so that it fits in both budgets. Normalization is left to the
+ *  caller.
+ *
+ *  @param title
+ *    Title in UTF-8.
+ *
+ *  @param space
+ *    Character that replaces a run of whitespace.
+ *
+ *  @param max_bytes
+ *    Maximum number of bytes in the file name.
+ *
+ *  @param max_utf16_units
+ *    Maximum number of UTF-16 code units in the file name.
+ *
+ *  @return
+ *    File name, which is empty if the title has no legal characters.
+ */
+inline std::string SanitizedFileName(
+    const std::string &title,
+    char space = ' ',
+    std::size_t max_bytes = kMaxFileNameBytes,
+    std::size_t max_utf16_units = kMaxFileNameUtf16Units) {
+  std::string retval;
+  retval.reserve(title.size() < max_bytes ? title.size() : max_bytes);
+  std::size_t num_units = 0;
+  bool has_space = false;
+  std::size_t i = 0;
+  while (i != title.size()) {
+    const unsigned char ch = static_cast<unsigned char>(title[i]);
+    // Whitespace, including a no-break space, is deferred until a character
+    // follows it.
+    if (ch == ' ' || (ch >= '\t' && ch <= '\r')) {
+      has_space = !retval.empty();
+      ++i;
+      continue;
+    }
+    if (ch == 0xC2 && i + 1 != title.size() &&
+        static_cast<unsigned char>(title[i + 1]) == 0xA0) {
+      has_space = !retval.empty();
+      i += 2;
+      continue;
+    }
+    std::size_t len = 1;
+    if (ch >= 0xF0 && ch <= 0xF4) {
+      len = 4;
+    } else if (ch >= 0xE0 && ch <= 0xEF) {
+      len = 3;
+    } else if (ch >= 0xC2 && ch <= 0xDF) {
+      len = 2;
+    }
+    if (len > title.size() - i) {
+      len = 1;
+    }
+    // A lead byte without its continuation bytes is replaced by itself.
+    for (std::size_t j = 1; j < len; ++j) {
+      if ((static_cast<unsigned char>(title[i + j]) & 0xC0) != 0x80) {
+        len = 1;
+        break;
+      }
+    }
+    const std::size_t units = len == 4 ? 2 : 1;
+    const std::size_t space_len = has_space ? 1 : 0;
+    if (retval.size() + space_len + len > max_bytes ||
+        num_units + space_len + units > max_utf16_units) {
+      break;
+    }
+    if (has_space) {
+      retval += space;
+      ++num_units;
+      has_space = false;
+    }
+    if (len != 1) {
+      retval.append(title, i, len);
+    } else if (ch < 0x20 || ch >= 0x7F || ch == '<' || ch == '>' ||
+               ch == ':' || ch == '"' || ch == '/' || ch == '\\' ||
+               ch == '|' || ch == '?' || ch == '*') {
+      retval += '_';
+    } else {
+      retval += static_cast<char>(ch);
+    }
+    num_units += units;
+    i += len;
+  }
+  // Windows removes trailing dots and spaces from file names.
+  while (!retval.empty() && (retval.back() == '.' || retval.back() == ' ')) {
+    retval.pop_back();
+  }
+  if (IsReservedDeviceName(retval)) {
+    retval += '_';
+  }
+  return retval;
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,404 @@
+#ifndef XBELMARK_HTML_HEAD_PARSER_H
+#define XBELMARK_HTML_HEAD_PARSER_H
+
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <libxml/HTMLparser.h>
+#include <libxml/encoding.h>
+#include <libxml/parser.h>
+#include <libxml/parserInternals.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Icon that is linked in the `head` element of an HTML document.
+ */
+struct IconLink {
+ public:
+  /**
+   *  Value of the `href` attribute as it is in the HTML document.
+   */
+  std::string href;
+
+  /**
+   *  Value of the `rel` attribute in lowercase.
+   */
+  std::string rel;
+
+  /**
+   *  Value of the `sizes` attribute.
+   */
+  std::string sizes;
+
+  /**
+   *  Value of the `type` attribute.
+   */
+  std::string type;
+};
+
+/**
+ *  Push parser of an HTML document that reads the title and the metadata in
+ *  its `head` element with libxml2 without building a parse tree.
+ *
+ *  Parsing stops once the `head` element has ended and a title has been
+ *  read, which is the content of the `title` element or the `og:title` or
+ *  `twitter:title` property. URLs are as they are in the HTML document, and
+ *  are to be resolved against the URL of the HTML document and the
+ *  @link base_href @endlink.
+ */
+class HeadParser final {
+ public:
+  HeadParser() {
+    Reset();
+  }
+
+  HeadParser(const HeadParser &) = delete;
+
+  HeadParser &operator=(const HeadParser &) = delete;
+
+  ~HeadParser() {
+    Free();
+  }
+
+  /**
+   *  Discard what has been parsed, and start parsing from the beginning.
+   */
+  void Reset() {
+    Free();
+    htmlSAXHandler handler(sax_handler());
+    ctxt_ = htmlCreatePushParserCtxt(
+        &handler, this, nullptr, 0, "", XML_CHAR_ENCODING_NONE);
+    title_.clear();
+    og_title_.clear();
+    twitter_title_.clear();
+    description_.clear();
+    canonical_href_.clear();
+    base_href_.clear();
+    icons_.clear();
+    is_title_ = false;
+    has_title_ = false;
+    is_head_done_ = false;
+    is_done_ = false;
+  }
+
+  /**
+   *  Free the parser while keeping what has been read.
+   *
+   *  Nothing more can be parsed until @link Reset @endlink is called.
+   */
+  void Free() {
+    if (ctxt_) {
+      htmlFreeParserCtxt(ctxt_);
+      ctxt_ = nullptr;
+    }
+  }
+
+  /**
+   *  Have the parser decode from a character encoding instead of detecting
+   *  it.
+   *
+   *  @param charset
+   *    Name of the character encoding. It is ignored if it is unknown to
+   *    libxml2.
+   */
+  void SetCharset(const std::string &charset) {
+    xmlCharEncodingHandlerPtr handler(
+        xmlFindCharEncodingHandler(charset.c_str()));
+    if (ctxt_ && handler) {
+      xmlSwitchToEncoding(ctxt_, handler);
+    }
+  }
+
+  /**
+   *  Parse the next chunk of the HTML document.
+   *
+   *  @param data
+   *    Chunk of the HTML document that follows the previous chunks.
+   *
+   *  @param size
+   *    Number of bytes in `data`.
+   *
+   *  @param is_last
+   *    Whether the chunk is the end of the HTML document.
+   */
+  void Parse(const char *data, std::size_t size, bool is_last) {
+    if (ctxt_ && !is_done_) {
+      htmlParseChunk(ctxt_, data, static_cast<int>(size), is_last ? 1 : 0);
+    }
+  }
+
+  /**
+   *  Whether nothing more is needed from the HTML document.
+   */
+  bool is_done() const {
+    return is_done_;
+  }
+
+  /**
+   *  Content of the `title` element in UTF-8, or an empty string if there is
+   *  none.
+   */
+  const std::string &title() const {
+    return title_;
+  }
+
+  /**
+   *  Content of the first `og:title` property in UTF-8.
+   */
+  const std::string &og_title() const {
+    return og_title_;
+  }
+
+  /**
+   *  Content of the first `twitter:title` property in UTF-8.
+   */
+  const std::string &twitter_title() const {
+    return twitter_title_;
+  }
+
+  /**
+   *  Content of the `description` metadata, or of the `og:description`
+   *  property if there is none, in UTF-8.
+   */
+  const std::string &description() const {
+    return description_;
+  }
+
+  /**
+   *  `href` of the first link that is canonical, or an empty string if there
+   *  is none.
+   */
+  const std::string &canonical_href() const {
+    return canonical_href_;
+  }
+
+  /**
+   *  `href` of the first `base` element, or an empty string if there is
+   *  none.
+   */
+  const std::string &base_href() const {
+    return base_href_;
+  }
+
+  /**
+   *  Icons in the order that they are linked.
+   */
+  const std::vector<IconLink> &icons() const {
+    return icons_;
+  }
+
+ private:
+  /**
+   *  Value of an attribute of an element.
+   *
+   *  @return
+   *    Value of the attribute, or an empty string if it is not specified.
+   */
+  static std::string AttributeValue(const xmlChar **atts, const char *name) {
+    for (; atts && atts[0]; atts += 2) {
+      if (std::strcmp(reinterpret_cast<const char *>(atts[0]), name) == 0) {
+        return atts[1] ? reinterpret_cast<const char *>(atts[1]) : "";
+      }
+    }
+    return "";
+  }
+
+  /**
+   *  String in lowercase.
+   */
+  static std::string ToLower(std::string str) {
+    for (char &ch : str) {
+      ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return str;
+  }
+
+  /**
+   *  Record the metadata in a `meta` element.
+   */
+  void ReadMeta(const xmlChar **atts) {
+    const std::string content(AttributeValue(atts, "content"));
+    const std::string property(ToLower(AttributeValue(atts, "property")));
+    const std::string name(ToLower(AttributeValue(atts, "name")));
+    if (property == "og:title") {
+      if (og_title_.empty()) {
+        og_title_ = content;
+      }
+    } else if (property == "twitter:title" || name == "twitter:title") {
+      if (twitter_title_.empty()) {
+        twitter_title_ = content;
+      }
+    } else if (name == "description") {
+      description_ = content;
+    } else if (property == "og:description") {
+      if (description_.empty()) {
+        description_ = content;
+      }
+    }
+  }
+
+  /**
+   *  Record the canonical URL or the icon in a `link` element.
+   */
+  void ReadLink(const xmlChar **atts) {
+    const std::string href(AttributeValue(atts, "href"));
+    if (href.empty()) {
+      return;
+    }
+    const std::string rel(ToLower(AttributeValue(atts, "rel")));
+    std::istringstream rel_stream(rel);
+    std::string token;
+    bool is_canonical = false;
+    bool is_icon = false;
+    while (rel_stream >> token) {
+      is_canonical = is_canonical || token == "canonical";
+      is_icon = is_icon ||
+          token == "icon" || token.compare(0, 16, "apple-touch-icon") == 0;
+    }
+    if (is_canonical && canonical_href_.empty()) {
+      canonical_href_ = href;
+    }
+    if (is_icon) {
+      IconLink icon;
+      icon.href = href;
+      icon.rel = rel;
+      icon.sizes = AttributeValue(atts, "sizes");
+      icon.type = AttributeValue(atts, "type");
+      icons_.push_back(icon);
+    }
+  }
+
+  /**
+   *  Stop parsing if nothing more is needed, which is once the `head` element
+   *  has ended and a title has been read.
+   */
+  void StopIfDone() {
+    if (is_head_done_ &&
+        (has_title_ || !og_title_.empty() || !twitter_title_.empty())) {
+      is_done_ = true;
+      xmlStopParser(ctxt_);
+    }
+  }
+
+  static void StartElement(
+      void *ctx, const xmlChar *name, const xmlChar **atts) {
+    HeadParser *obj = static_cast<HeadParser *>(ctx);
+    const char *tag = reinterpret_cast<const char *>(name);
+    if (std::strcmp(tag, "title") == 0) {
+      obj->is_title_ = !obj->has_title_;
+    } else if (std::strcmp(tag, "body") == 0) {
+      obj->is_head_done_ = true;
+      obj->StopIfDone();
+    } else if (obj->is_head_done_) {
+      // Metadata is only in the `head` element.
+    } else if (std::strcmp(tag, "meta") == 0) {
+      obj->ReadMeta(atts);
+    } else if (std::strcmp(tag, "link") == 0) {
+      obj->ReadLink(atts);
+    } else if (std::strcmp(tag, "base") == 0 && obj->base_href_.empty()) {
+      obj->base_href_ = AttributeValue(atts, "href");
+    }
+  }
+
+  static void EndElement(void *ctx, const xmlChar *name) {
+    HeadParser *obj = static_cast<HeadParser *>(ctx);
+    const char *tag = reinterpret_cast<const char *>(name);
+    if (obj->is_title_ && std::strcmp(tag, "title") == 0) {
+      obj->is_title_ = false;
+      obj->has_title_ = true;
+      obj->StopIfDone();
+    } else if (std::strcmp(tag, "head") == 0) {
+      obj->is_head_done_ = true;
+      obj->StopIfDone();
+    }
+  }
+
+  static void Characters(void *ctx, const xmlChar *ch, int len) {
+    HeadParser *obj = static_cast<HeadParser *>(ctx);
+    if (obj->is_title_) {
+      obj->title_.append(reinterpret_cast<const char *>(ch), len);
+    }
+  }
+
+  static htmlSAXHandler sax_handler() {
+    htmlSAXHandler retval;
+    retval.internalSubset = nullptr;
+    retval.isStandalone = nullptr;
+    retval.hasInternalSubset = nullptr;
+    retval.hasExternalSubset = nullptr;
+    retval.resolveEntity = nullptr;
+    retval.getEntity = nullptr;
+    retval.entityDecl = nullptr;
+    retval.notationDecl = nullptr;
+    retval.attributeDecl = nullptr;
+    retval.elementDecl = nullptr;
+    retval.unparsedEntityDecl = nullptr;
+    retval.setDocumentLocator = nullptr;
+    retval.startDocument = nullptr;
+    retval.endDocument = nullptr;
+    retval.startElement = &StartElement;
+    retval.endElement = &EndElement;
+    retval.reference = nullptr;
+    retval.characters = &Characters;
+    retval.ignorableWhitespace = nullptr;
+    retval.processingInstruction = nullptr;
+    retval.comment = nullptr;
+    retval.warning = nullptr;
+    retval.error = nullptr;
+    retval.fatalError = nullptr;
+    retval.getParameterEntity = nullptr;
+    retval.cdataBlock = &Characters;
+    retval.externalSubset = nullptr;
+    return retval;
+  }
+
+  /**
+   *  libxml2 HTML push parser, or `nullptr` if it has been freed.
+   */
+  htmlParserCtxtPtr ctxt_ = nullptr;
+
+  std::string title_;
+
+  std::string og_title_;
+
+  std::string twitter_title_;
+
+  std::string description_;
+
+  std::string canonical_href_;
+
+  std::string base_href_;
+
+  std::vector<IconLink> icons_;
+
+  /**
+   *  Whether the content of the `title` element is being read.
+   */
+  bool is_title_ = false;
+
+  /**
+   *  Whether the content of the `title` element has been read.
+   */
+  bool has_title_ = false;
+
+  /**
+   *  Whether the `head` element has ended.
+   */
+  bool is_head_done_ = false;
+
+  /**
+   *  Whether no more data is to be parsed.
+   */
+  bool is_done_ = false;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,162 @@
+#include "xbelmark/html/icon_cache.h"
+
+#include <map>
+#include <mutex>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QString>
+
+#include "xbelmark/url/url.h"
+
+using xbelmark::url::NormalizedUrl;
+
+namespace xbelmark {
+namespace html {
+
+class IconCache::Impl final {
+ public:
+  /**
+   *  Path to the file that maps a URL to the digest of its icon.
+   */
+  QString UrlPath(const std::string &normalized_url) const {
+    const QByteArray digest(
+        QCryptographicHash::hash(
+            QByteArray(normalized_url.data(), normalized_url.size()),
+            QCryptographicHash::Sha1));
+    return dir_.filePath(
+        "urls/" + QString::fromLatin1(digest.toHex()) + ".json");
+  }
+
+  /**
+   *  Path to the file of the content of an icon, which is in one of 256
+   *  subdirectories so that no directory grows too large.
+   */
+  QString ObjectPath(const std::string &digest) const {
+    const QString hex(QString::fromStdString(digest));
+    return dir_.filePath("objects/" + hex.left(2) + "/" + hex);
+  }
+
+  QDir dir_;
+
+  /**
+   *  `data` URIs by the digests of the contents that have been encoded.
+   */
+  std::map<std::string, std::string> data_uris_;
+
+  /**
+   *  Mutex of @link data_uris_ @endlink, since `data` URIs are requested by
+   *  concurrent transformations.
+   */
+  std::mutex data_uris_mutex_;
+};
+
+IconCache::IconCache(const std::string &dir_path) : p_impl_(new Impl()) {
+  p_impl_->dir_ = QDir(QString::fromStdString(dir_path));
+  p_impl_->dir_.mkpath("urls");
+  p_impl_->dir_.mkpath("objects");
+}
+
+IconCache::~IconCache() = default;
+
+bool IconCache::Lookup(const QUrl &url, Entry &entry) const {
+  const std::string normalized_url(NormalizedUrl(url));
+  QFile file(p_impl_->UrlPath(normalized_url));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const QJsonObject obj(QJsonDocument::fromJson(file.readAll()).object());
+  // Guard against a corrupted entry or a hash collision.
+  if (obj.value("url").toString().toStdString() != normalized_url) {
+    return false;
+  }
+  entry.digest = obj.value("digest").toString().toStdString();
+  entry.type = obj.value("type").toString().toStdString();
+  entry.stored_at = obj.value("stored_at").toInteger();
+  return !entry.digest.empty() &&
+      QFile::exists(p_impl_->ObjectPath(entry.digest));
+}
+
+bool IconCache::Store(
+    const QUrl &url,
+    const QByteArray &data,
+    const std::string &type) {
+  const std::string digest(
+      QCryptographicHash::hash(data, QCryptographicHash::Sha256)
+          .toHex().toStdString());
+  const QString object_path(p_impl_->ObjectPath(digest));
+  if (!QFile::exists(object_path)) {
+    p_impl_->dir_.mkpath(QFileInfo(object_path).path());
+    QSaveFile object_file(object_path);
+    if (!object_file.open(QIODevice::WriteOnly)) {
+      return false;
+    }
+    object_file.write(data);
+    if (!object_file.commit()) {
+      return false;
+    }
+  }
+  const std::string normalized_url(NormalizedUrl(url));
+  QJsonObject obj;
+  obj.insert("url", QString::fromStdString(normalized_url));
+  obj.insert("digest", QString::fromStdString(digest));
+  obj.insert("type", QString::fromStdString(type));
+  obj.insert(
+      "stored_at", static_cast<qint64>(QDateTime::currentSecsSinceEpoch()));
+  QSaveFile url_file(p_impl_->UrlPath(normalized_url));
+  if (!url_file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  url_file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+  return url_file.commit();
+}
+
+bool IconCache::Read(const std::string &digest, QByteArray &data) const {
+  QFile file(p_impl_->ObjectPath(digest));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  data = file.readAll();
+  return true;
+}
+
+std::string IconCache::DataUri(const QUrl &url) const {
+  Entry entry;
+  if (!Lookup(url, entry)) {
+    return "";
+  }
+  {
+    std::lock_guard<std::mutex> lock(p_impl_->data_uris_mutex_);
+    auto it = p_impl_->data_uris_.find(entry.digest);
+    if (it != p_impl_->data_uris_.end()) {
+      return it->second;
+    }
+  }
+  QByteArray data;
+  if (!Read(entry.digest, data)) {
+    return "";
+  }
+  const std::string retval(
+      "data:" + entry.type + ";base64," + data.toBase64().toStdString());
+  std::lock_guard<std::mutex> lock(p_impl_->data_uris_mutex_);
+  p_impl_->data_uris_.emplace(entry.digest, retval);
+  return retval;
+}
+
+std::string DefaultIconCacheDir() {
+  return QDir(QStandardPaths::writableLocation(
+                  QStandardPaths::GenericCacheLocation))
+      .filePath("xbelmark/icons").toStdString();
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,130 @@
+#ifndef XBELMARK_HTML_ICON_CACHE_H
+#define XBELMARK_HTML_ICON_CACHE_H
+
+#include <memory>
+#include <string>
+
+#include <QByteArray>
+#include <QUrl>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Persistent, content-addressed cache of icons.
+ *
+ *  The content of each icon is stored once under `objects`, named after its
+ *  SHA-256 digest, so that the many bookmarks of a site share one copy of its
+ *  icon. The URLs of icons are mapped to digests by JSON files under `urls`,
+ *  named after the hash of the normalized URL. Files are written atomically,
+ *  so the cache can be shared by concurrent processes.
+ */
+class IconCache final {
+ public:
+  /**
+   *  Cached icon of a URL.
+   */
+  struct Entry {
+   public:
+    /**
+     *  Hexadecimal SHA-256 digest of the content of the icon.
+     */
+    std::string digest;
+
+    /**
+     *  MIME type of the icon, such as `image/png`.
+     */
+    std::string type;
+
+    /**
+     *  When the entry was stored, in seconds since epoch.
+     */
+    long long stored_at = 0;
+  };
+
+  /**
+   *  @param dir_path
+   *    Path to the cache directory. It is created if it does not exist.
+   */
+  explicit IconCache(const std::string &dir_path);
+
+  ~IconCache();
+
+  /**
+   *  Look up the icon of a URL.
+   *
+   *  @param url
+   *    URL of the icon.
+   *
+   *  @param entry
+   *    Entry that is set if it is found.
+   *
+   *  @return
+   *    Whether the entry is found and its content is in the cache.
+   */
+  bool Lookup(const QUrl &url, Entry &entry) const;
+
+  /**
+   *  Store the icon of a URL, replacing any existing entry of the URL.
+   *
+   *  The content is written only if no icon with the same content has been
+   *  stored.
+   *
+   *  @param url
+   *    URL of the icon.
+   *
+   *  @param data
+   *    Content of the icon.
+   *
+   *  @param type
+   *    MIME type of the icon.
+   *
+   *  @return
+   *    Whether the icon has been stored. Failing to cache is not an error.
+   */
+  bool Store(const QUrl &url, const QByteArray &data, const std::string &type);
+
+  /**
+   *  Read the content of an icon.
+   *
+   *  @param digest
+   *    Hexadecimal SHA-256 digest of the content.
+   *
+   *  @param data
+   *    Content that is set if it is found.
+   *
+   *  @return
+   *    Whether the content is found.
+   */
+  bool Read(const std::string &digest, QByteArray &data) const;
+
+  /**
+   *  Icon of a URL as a `data` URI, which is encoded once per content.
+   *
+   *  It can be called from multiple threads.
+   *
+   *  @param url
+   *    URL of the icon.
+   *
+   *  @return
+   *    `data` URI in base64, or an empty string if the icon is not in the
+   *    cache.
+   */
+  std::string DataUri(const QUrl &url) const;
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+/**
+ *  Path to the default directory of the icon cache, which is `xbelmark/icons`
+ *  under the cache location of the user.
+ */
+std::string DefaultIconCacheDir();
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef XBELMARK_HTML_ICON_FORMAT_H
+#define XBELMARK_HTML_ICON_FORMAT_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Edge in pixels of the icon size that is preferred, which is that of a
+ *  favicon on a high-density display.
+ */
+constexpr int kPreferredIconSize = 32;
+
+/**
+ *  Rank of an icon as the icon of a bookmark, where a lower rank is
+ *  preferred.
+ *
+ *  Icons with `icon` in `rel` are preferred over Apple touch icons, which
+ *  are large, and sizes closer to @link kPreferredIconSize @endlink are
+ *  preferred within each.
+ *
+ *  @param rel
+ *    Value of the `rel` attribute in lowercase.
+ *
+ *  @param sizes
+ *    Value of the `sizes` attribute, such as `16x16 32x32` or `any`, or an
+ *    empty string if there is none.
+ */
+inline int IconRank(const std::string &rel, const std::string &sizes) {
+  std::istringstream rel_tokens(rel);
+  std::string token;
+  bool is_icon = false;
+  while (rel_tokens >> token) {
+    is_icon = is_icon || token == "icon";
+  }
+  int distance = -1;
+  std::istringstream size_tokens(sizes);
+  while (size_tokens >> token) {
+    int d = -1;
+    if (token == "any") {
+      d = 8;
+    } else if (std::atoi(token.c_str()) > 0) {
+      d = std::abs(std::atoi(token.c_str()) - kPreferredIconSize);
+    }
+    if (d >= 0 && (distance < 0 || d < distance)) {
+      distance = d;
+    }
+  }
+  // Icons of unknown size are usually favicons.
+  if (distance < 0) {
+    distance = 16;
+  }
+  return (is_icon ? 0 : 1000) + distance;
+}
+
+/**
+ *  MIME type of an icon that is sniffed from its content, so that an error
+ *  page served in place of an icon is not taken as one.
+ *
+ *  @param data
+ *    Content of the icon.
+ *
+ *  @param size
+ *    Number of bytes in `data`.
+ *
+ *  @return
+ *    MIME type of the image, or an empty string if it is not a recognized
+ *    image format.
+ */
+inline std::string SniffIconType(const char *data, std::size_t size) {
+  const auto starts_with = [data, size](const char *magic, std::size_t n) {
+    return size >= n && std::memcmp(data, magic, n) == 0;
+  };
+  if (starts_with("\x89PNG\r\n\x1A\n", 8)) {
+    return "image/png";
+  }
+  if (starts_with("GIF87a", 6) || starts_with("GIF89a", 6)) {
+    return "image/gif";
+  }
+  if (starts_with("\xFF\xD8\xFF", 3)) {
+    return "image/jpeg";
+  }
+  if (starts_with("\x00\x00\x01\x00", 4)) {
+    return "image/x-icon";
+  }
+  if (starts_with("BM", 2)) {
+    return "image/bmp";
+  }
+  if (size >= 12 && std::memcmp(data, "RIFF", 4) == 0 &&
+      std::memcmp(data + 8, "WEBP", 4) == 0) {
+    return "image/webp";
+  }
+  // An SVG document begins with markup and has an `svg` element near the
+  // beginning.
+  std::size_t i = starts_with("\xEF\xBB\xBF", 3) ? 3 : 0;
+  while (i != size && data[i] != '\0' && std::strchr(" \t\r\n", data[i])) {
+    ++i;
+  }
+  if (i != size && data[i] == '<') {
+    const std::string head(data + i, size - i < 1024 ? size - i : 1024);
+    if (head.find("<svg") != std::string::npos &&
+        head.find("<html") == std::string::npos &&
+        head.find("<HTML") == std::string::npos) {
+      return "image/svg+xml";
+    }
+  }
+  return "";
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
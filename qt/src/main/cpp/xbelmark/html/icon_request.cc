@@ -0,0 +1,242 @@
+#include "xbelmark/html/icon_request.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QByteArray>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QtGlobal>
+
+#include "xbelmark/html/icon_cache.h"
+#include "xbelmark/html/icon_format.h"
+#include "xbelmark/html/tls_session_store.h"
+
+namespace xbelmark {
+namespace html {
+
+class IconRequest::Impl final {
+ public:
+  /**
+   *  Icon that is a candidate for the icon of the HTML document.
+   */
+  struct Candidate {
+   public:
+    QUrl url;
+
+    /**
+     *  Reply that is being read, or `nullptr` if there is none.
+     */
+    QNetworkReply *reply = nullptr;
+
+    /**
+     *  Whether the icon is in the icon cache.
+     */
+    bool is_cached = false;
+  };
+
+  /**
+   *  Select the candidates in the order of preference.
+   */
+  void SelectCandidates(const Info &info) {
+    std::vector<const Icon *> icons;
+    for (const Icon &icon : info.icons) {
+      const QString scheme(icon.url.scheme());
+      if (scheme == "http" || scheme == "https") {
+        icons.push_back(&icon);
+      }
+    }
+    std::stable_sort(
+        icons.begin(), icons.end(),
+        [](const Icon *a, const Icon *b) -> bool {
+          return IconRank(a->rel, a->sizes) < IconRank(b->rel, b->sizes);
+        });
+    for (const Icon *icon : icons) {
+      if (candidates_.size() == static_cast<std::size_t>(max_candidates)) {
+        break;
+      }
+      const bool is_duplicate = std::any_of(
+          candidates_.begin(), candidates_.end(),
+          [icon](const Candidate &candidate) -> bool {
+            return candidate.url == icon->url;
+          });
+      if (!is_duplicate) {
+        Candidate candidate;
+        candidate.url = icon->url;
+        candidates_.push_back(candidate);
+      }
+    }
+    // Browsers fall back to the conventional location.
+    const QUrl base(info.final_url.isEmpty() ? info.url : info.final_url);
+    if (candidates_.empty() &&
+        (base.scheme() == "http" || base.scheme() == "https")) {
+      Candidate candidate;
+      candidate.url = base.resolved(QUrl("/favicon.ico"));
+      candidates_.push_back(candidate);
+    }
+  }
+
+  /**
+   *  Send a GET request for a candidate, and store the icon once the reply
+   *  has finished.
+   */
+  void Fetch(std::size_t index) {
+    QNetworkRequest request(candidates_[index].url);
+    request.setAttribute(
+        QNetworkRequest::RedirectPolicyAttribute,
+        QNetworkRequest::NoLessSafeRedirectPolicy);
+    if (options_.total_timeout > 0) {
+      request.setTransferTimeout(
+          static_cast<int>(qMin<long long>(options_.total_timeout, INT_MAX)));
+    }
+    if (tls_sessions_) {
+      tls_sessions_->Apply(request);
+    }
+    QNetworkReply *reply = manager_->get(request);
+    if (tls_sessions_) {
+      tls_sessions_->Watch(reply);
+    }
+    candidates_[index].reply = reply;
+    ++num_pending_;
+    const long long max_bytes = options_.icon_max_bytes;
+    QObject::connect(
+        reply, &QNetworkReply::downloadProgress,
+        owner_, [reply, max_bytes](qint64 received, qint64) -> void {
+          if (max_bytes > 0 && received > max_bytes) {
+            reply->abort();
+          }
+        });
+    QObject::connect(
+        reply, &QNetworkReply::finished,
+        owner_, [this, index]() -> void {
+          Complete(index);
+        });
+  }
+
+  /**
+   *  Store the icon of a candidate whose reply has finished.
+   */
+  void Complete(std::size_t index) {
+    Candidate &candidate = candidates_[index];
+    QNetworkReply *reply = candidate.reply;
+    candidate.reply = nullptr;
+    if (reply->error() == QNetworkReply::NoError) {
+      const QByteArray data(reply->readAll());
+      const std::string type(SniffIconType(data.constData(), data.size()));
+      candidate.is_cached =
+          !type.empty() && cache_->Store(candidate.url, data, type);
+    }
+    reply->deleteLater();
+    if (--num_pending_ == 0) {
+      Finish();
+    }
+  }
+
+  /**
+   *  Finish the retrieval with the preferred icon that is cached.
+   */
+  void Finish() {
+    for (const Candidate &candidate : candidates_) {
+      if (candidate.is_cached) {
+        icon_url_ = candidate.url;
+        break;
+      }
+    }
+    is_finished_ = true;
+    if (on_finished_) {
+      on_finished_();
+    }
+  }
+
+  QNetworkAccessManager *manager_ = nullptr;
+
+  /**
+   *  Context of the connections to the signals of the replies.
+   */
+  QObject *owner_ = nullptr;
+
+  RetrievalOptions options_;
+
+  std::unique_ptr<IconCache> cache_;
+
+  /**
+   *  Store of the TLS sessions to resume, or `nullptr` if there is none.
+   */
+  std::unique_ptr<TlsSessionStore> tls_sessions_;
+
+  /**
+   *  Candidates in the order of preference.
+   */
+  std::vector<Candidate> candidates_;
+
+  /**
+   *  Number of replies that have not finished.
+   */
+  int num_pending_ = 0;
+
+  QUrl icon_url_;
+
+  std::function<void()> on_finished_;
+
+  bool is_finished_ = false;
+};
+
+IconRequest::IconRequest(
+    QNetworkAccessManager &manager,
+    const Info &info,
+    const RetrievalOptions &options) : p_impl_(new Impl()) {
+  p_impl_->manager_ = &manager;
+  p_impl_->owner_ = this;
+  p_impl_->options_ = options;
+  p_impl_->cache_.reset(new IconCache(options.icon_cache_dir));
+  if (!options.tls_session_dir.empty()) {
+    p_impl_->tls_sessions_.reset(new TlsSessionStore(options.tls_session_dir));
+  }
+  p_impl_->SelectCandidates(info);
+}
+
+IconRequest::~IconRequest() {
+  for (Impl::Candidate &candidate : p_impl_->candidates_) {
+    if (candidate.reply) {
+      QObject::disconnect(candidate.reply, nullptr, this, nullptr);
+      candidate.reply->abort();
+      candidate.reply->deleteLater();
+    }
+  }
+}
+
+void IconRequest::Start(std::function<void()> on_finished) {
+  Impl *impl = p_impl_.get();
+  impl->on_finished_ = std::move(on_finished);
+  // Icons that are preferred over a cached one are fetched concurrently, so
+  // that a site whose icon is cached costs no requests.
+  for (std::size_t i = 0; i != impl->candidates_.size(); ++i) {
+    IconCache::Entry entry;
+    if (impl->cache_->Lookup(impl->candidates_[i].url, entry)) {
+      impl->candidates_[i].is_cached = true;
+      break;
+    }
+    if (!impl->options_.cache_only) {
+      impl->Fetch(i);
+    }
+  }
+  if (impl->num_pending_ == 0) {
+    impl->Finish();
+  }
+}
+
+bool IconRequest::is_finished() const {
+  return p_impl_->is_finished_;
+}
+
+const QUrl &IconRequest::icon_url() const {
+  return p_impl_->icon_url_;
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,84 @@
+#ifndef XBELMARK_HTML_ICON_REQUEST_H
+#define XBELMARK_HTML_ICON_REQUEST_H
+
+#include <functional>
+#include <memory>
+
+#include <QNetworkAccessManager>
+#include <QObject>
+#include <QUrl>
+
+#include "xbelmark/html/info.h"
+#include "xbelmark/html/retrieval_options.h"
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Asynchronous retrieval of the icon of an HTML document into the icon
+ *  cache of @link RetrievalOptions::icon_cache_dir @endlink.
+ *
+ *  The best-ranked icons that are linked from the HTML document, or
+ *  `/favicon.ico` if none are, are fetched concurrently, except those that are
+ *  already in the icon cache. The preferred icon of those that are in the
+ *  icon cache afterward is the result. Progress is made only while an event
+ *  loop is running in the thread of the network access manager.
+ */
+class IconRequest final : public QObject {
+ public:
+  /**
+   *  Maximum number of icons of an HTML document that are fetched.
+   */
+  static constexpr int max_candidates = 3;
+
+  /**
+   *  @param manager
+   *    Network access manager that sends the requests. It must outlive the
+   *    retrieval.
+   *
+   *  @param info
+   *    Information about the HTML document, whose icons are fetched.
+   *
+   *  @param options
+   *    Options for the retrieval, where the icon cache must be given.
+   */
+  IconRequest(
+      QNetworkAccessManager &manager,
+      const Info &info,
+      const RetrievalOptions &options);
+
+  /**
+   *  The transfers are aborted if they have not finished.
+   */
+  virtual ~IconRequest();
+
+  /**
+   *  Start the retrieval.
+   *
+   *  @param on_finished
+   *    Function that is called once the retrieval has finished, which is
+   *    before `Start` returns if every icon is in the icon cache.
+   */
+  void Start(std::function<void()> on_finished);
+
+  /**
+   *  Whether the retrieval has finished.
+   */
+  bool is_finished() const;
+
+  /**
+   *  URL of the preferred icon that is in the icon cache, or an empty URL if
+   *  there is none.
+   */
+  const QUrl &icon_url() const;
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
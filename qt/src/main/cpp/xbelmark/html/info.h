@@ -0,0 +1,141 @@
+#ifndef XBELMARK_HTML_INFO_H
+#define XBELMARK_HTML_INFO_H
+
+#include <string>
+#include <vector>
+
+#include <QUrl>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Icon that is linked from an HTML document.
+ */
+struct Icon {
+ public:
+  /**
+   *  Absolute URL of the icon.
+   */
+  QUrl url;
+
+  /**
+   *  Value of the `rel` attribute in lowercase, such as `icon` or
+   *  `apple-touch-icon`.
+   */
+  std::string rel;
+
+  /**
+   *  Value of the `sizes` attribute, or an empty string if there is none.
+   */
+  std::string sizes;
+
+  /**
+   *  Value of the `type` attribute, or an empty string if there is none.
+   */
+  std::string type;
+};
+
+/**
+ *  Information about an HTML document.
+ */
+struct Info {
+ public:
+  /**
+   *  URL of the HTML document.
+   */
+  QUrl url;
+
+  /**
+   *  URL of the HTML document after redirects.
+   */
+  QUrl final_url;
+
+  /**
+   *  URLs that were redirected from, in order, beginning with @link url
+   *  @endlink if it was redirected. Redirects that are known from the cache
+   *  are included.
+   */
+  std::vector<QUrl> redirects;
+
+  /**
+   *  Beginning of the HTML document up to the end of the `head` element in its
+   *  original character encoding, or an empty string if the information is
+   *  from the cache.
+   */
+  std::string html;
+
+  /**
+   *  Title of the HTML document in UTF-8.
+   *
+   *  It is the content of the `title` element, or @link og_title @endlink or
+   *  @link twitter_title @endlink if there is none.
+   */
+  std::string title;
+
+  /**
+   *  Content of the `og:title` Open Graph property in UTF-8.
+   */
+  std::string og_title;
+
+  /**
+   *  Content of the `twitter:title` Twitter Card property in UTF-8.
+   */
+  std::string twitter_title;
+
+  /**
+   *  Content of the `description` metadata, or of the `og:description` Open
+   *  Graph property if there is none, in UTF-8.
+   */
+  std::string description;
+
+  /**
+   *  Absolute URL that is linked as canonical, or an empty URL if there is
+   *  none.
+   */
+  QUrl canonical_url;
+
+  /**
+   *  Icons in the order that they are linked.
+   */
+  std::vector<Icon> icons;
+
+  /**
+   *  URL of the preferred icon that is in the icon cache, or an empty URL if
+   *  icons were not fetched or none could be.
+   */
+  QUrl icon_url;
+
+  /**
+   *  Error message if the HTML document could not be retrieved, or an empty
+   *  string if there was no error.
+   */
+  std::string error;
+
+  /**
+   *  Whether the information is from the cache.
+   */
+  bool from_cache = false;
+
+  /**
+   *  Number of times that the request was retried after a transient failure.
+   */
+  int num_retries = 0;
+
+  /**
+   *  Number of duplicate requests that were sent because the request was
+   *  slow.
+   */
+  int num_hedges = 0;
+
+  /**
+   *  Number of duplicate requests that responded before the request that they
+   *  duplicated.
+   */
+  int num_hedge_wins = 0;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
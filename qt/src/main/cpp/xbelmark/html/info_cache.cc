@@ -0,0 +1,264 @@
+#include "xbelmark/html/info_cache.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QSaveFile>
+#include <QString>
+#include <QStringList>
+
+#include "xbelmark/url/url.h"
+
+using xbelmark::url::NormalizedUrl;
+
+namespace xbelmark {
+namespace html {
+
+class InfoCache::Impl final {
+ public:
+  /**
+   *  Path to the file of the entry of a URL.
+   *
+   *  @param dir
+   *    Directory of the kind of the entry.
+   */
+  static QString EntryPath(const QDir &dir, const std::string &normalized_url) {
+    const QByteArray digest(
+        QCryptographicHash::hash(
+            QByteArray(normalized_url.data(), normalized_url.size()),
+            QCryptographicHash::Sha1));
+    return dir.filePath(QString::fromLatin1(digest.toHex()) + ".json");
+  }
+
+  /**
+   *  Read the JSON object of an entry.
+   *
+   *  @return
+   *    Whether the entry is found.
+   */
+  bool Read(
+      const QString &entry_path,
+      const std::string &normalized_url,
+      QJsonObject &obj) const {
+    QFile file(entry_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+      return false;
+    }
+    obj = QJsonDocument::fromJson(file.readAll()).object();
+    // Guard against a corrupted entry or a hash collision.
+    return obj.value("url").toString().toStdString() == normalized_url;
+  }
+
+  /**
+   *  Write the JSON object of an entry atomically, and prune the entries of
+   *  its kind if there are too many.
+   *
+   *  @param dir
+   *    Directory of the kind of the entry.
+   */
+  void Write(
+      const QDir &dir,
+      const QString &entry_path,
+      const QJsonObject &obj) {
+    const bool is_new = !QFile::exists(entry_path);
+    // Failing to cache is not an error.
+    QSaveFile file(entry_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+      return;
+    }
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    if (!file.commit() || max_entries_ <= 0 || !is_new) {
+      return;
+    }
+    const long long num_entries = ReadCount(dir);
+    if (num_entries < 0 || num_entries + 1 > max_entries_) {
+      Prune(dir);
+    } else {
+      WriteCount(dir, num_entries + 1);
+    }
+  }
+
+  /**
+   *  Number of entries that is persisted in a directory, or `-1` if it has
+   *  not been counted.
+   *
+   *  The count is persisted so that a process, such as a single paste,
+   *  does not list the directory to store an entry. Increments that are lost
+   *  to concurrent processes are corrected when the entries are pruned.
+   */
+  static long long ReadCount(const QDir &dir) {
+    QFile file(dir.filePath("count"));
+    if (!file.open(QIODevice::ReadOnly)) {
+      return -1;
+    }
+    bool ok = false;
+    const long long retval = file.readAll().trimmed().toLongLong(&ok);
+    return ok && retval >= 0 ? retval : -1;
+  }
+
+  /**
+   *  Persist the number of entries in a directory.
+   */
+  static void WriteCount(const QDir &dir, long long num_entries) {
+    QSaveFile file(dir.filePath("count"));
+    if (file.open(QIODevice::WriteOnly)) {
+      file.write(QByteArray::number(num_entries));
+      file.commit();
+    }
+  }
+
+  /**
+   *  Count the entries in a directory, and remove the least recently stored
+   *  entries if there are too many.
+   *
+   *  One tenth of the maximum is removed at a time so that pruning is not
+   *  done for every entry stored.
+   */
+  void Prune(const QDir &dir) {
+    const QFileInfoList entries(
+        dir.entryInfoList(
+            QStringList("*.json"),
+            QDir::Files,
+            QDir::Time | QDir::Reversed));
+    long long num_entries = entries.size();
+    const long long target = max_entries_ - max_entries_ / 10;
+    if (num_entries > max_entries_) {
+      for (const QFileInfo &entry : entries) {
+        if (num_entries <= target) {
+          break;
+        }
+        if (QFile::remove(entry.filePath())) {
+          --num_entries;
+        }
+      }
+    }
+    WriteCount(dir, num_entries);
+  }
+
+  /**
+   *  Directory of the entries of HTML documents.
+   */
+  QDir title_dir_;
+
+  /**
+   *  Directory of the entries of permanent redirects.
+   */
+  QDir redirect_dir_;
+
+  long long max_entries_;
+};
+
+InfoCache::InfoCache(
+    const std::string &dir_path,
+    long long max_entries) : p_impl_(new Impl()) {
+  const QDir dir(QString::fromStdString(dir_path));
+  dir.mkpath("titles");
+  dir.mkpath("redirects");
+  p_impl_->title_dir_ = QDir(dir.filePath("titles"));
+  p_impl_->redirect_dir_ = QDir(dir.filePath("redirects"));
+  p_impl_->max_entries_ = max_entries;
+}
+
+InfoCache::~InfoCache() = default;
+
+bool InfoCache::Lookup(const QUrl &url, Entry &entry) const {
+  const std::string normalized_url(NormalizedUrl(url));
+  QJsonObject obj;
+  if (!p_impl_->Read(
+          Impl::EntryPath(p_impl_->title_dir_, normalized_url),
+          normalized_url, obj)) {
+    return false;
+  }
+  entry.title = obj.value("title").toString().toStdString();
+  entry.final_url = QUrl(obj.value("final_url").toString());
+  entry.redirects.clear();
+  for (const QJsonValue &value : obj.value("redirects").toArray()) {
+    entry.redirects.push_back(QUrl(value.toString()));
+  }
+  entry.description = obj.value("description").toString().toStdString();
+  entry.canonical_url = QUrl(obj.value("canonical_url").toString());
+  entry.icons.clear();
+  for (const QJsonValue &value : obj.value("icons").toArray()) {
+    const QJsonObject icon_obj(value.toObject());
+    Icon icon;
+    icon.url = QUrl(icon_obj.value("url").toString());
+    icon.rel = icon_obj.value("rel").toString().toStdString();
+    icon.sizes = icon_obj.value("sizes").toString().toStdString();
+    icon.type = icon_obj.value("type").toString().toStdString();
+    entry.icons.push_back(icon);
+  }
+  entry.etag = obj.value("etag").toString().toStdString();
+  entry.last_modified = obj.value("last_modified").toString().toStdString();
+  entry.stored_at = obj.value("stored_at").toInteger();
+  return true;
+}
+
+void InfoCache::Store(const QUrl &url, const Entry &entry) {
+  const std::string normalized_url(NormalizedUrl(url));
+  QJsonObject obj;
+  obj.insert("url", QString::fromStdString(normalized_url));
+  obj.insert("title", QString::fromStdString(entry.title));
+  obj.insert("final_url", entry.final_url.toString(QUrl::FullyEncoded));
+  QJsonArray redirects;
+  for (const QUrl &redirect : entry.redirects) {
+    redirects.append(redirect.toString(QUrl::FullyEncoded));
+  }
+  obj.insert("redirects", redirects);
+  obj.insert("description", QString::fromStdString(entry.description));
+  obj.insert(
+      "canonical_url", entry.canonical_url.toString(QUrl::FullyEncoded));
+  QJsonArray icons;
+  for (const Icon &icon : entry.icons) {
+    QJsonObject icon_obj;
+    icon_obj.insert("url", icon.url.toString(QUrl::FullyEncoded));
+    icon_obj.insert("rel", QString::fromStdString(icon.rel));
+    icon_obj.insert("sizes", QString::fromStdString(icon.sizes));
+    icon_obj.insert("type", QString::fromStdString(icon.type));
+    icons.append(icon_obj);
+  }
+  obj.insert("icons", icons);
+  obj.insert("etag", QString::fromStdString(entry.etag));
+  obj.insert("last_modified", QString::fromStdString(entry.last_modified));
+  obj.insert("stored_at", static_cast<qint64>(entry.stored_at));
+  p_impl_->Write(
+      p_impl_->title_dir_,
+      Impl::EntryPath(p_impl_->title_dir_, normalized_url),
+      obj);
+}
+
+bool InfoCache::LookupRedirect(const QUrl &url, QUrl &target) const {
+  const std::string normalized_url(NormalizedUrl(url));
+  QJsonObject obj;
+  if (!p_impl_->Read(
+          Impl::EntryPath(p_impl_->redirect_dir_, normalized_url),
+          normalized_url, obj)) {
+    return false;
+  }
+  target = QUrl(obj.value("target").toString());
+  return target.isValid();
+}
+
+void InfoCache::StoreRedirect(const QUrl &url, const QUrl &target) {
+  const std::string normalized_url(NormalizedUrl(url));
+  QJsonObject obj;
+  obj.insert("url", QString::fromStdString(normalized_url));
+  obj.insert("target", target.toString(QUrl::FullyEncoded));
+  obj.insert(
+      "stored_at", static_cast<qint64>(QDateTime::currentSecsSinceEpoch()));
+  p_impl_->Write(
+      p_impl_->redirect_dir_,
+      Impl::EntryPath(p_impl_->redirect_dir_, normalized_url),
+      obj);
+}
+
+} // namespace html
+} // namespace xbelmark
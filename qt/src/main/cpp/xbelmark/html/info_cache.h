@@ -0,0 +1,155 @@
+#ifndef XBELMARK_HTML_INFO_CACHE_H
+#define XBELMARK_HTML_INFO_CACHE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QUrl>
+
+#include "xbelmark/html/info.h"
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Persistent cache of information about HTML documents.
+ *
+ *  Each entry is a JSON file in a subdirectory of the cache directory for its
+ *  kind, named after the hash of the normalized URL. Entries are written
+ *  atomically, so the cache can be shared by concurrent processes.
+ *
+ *  The cache also maps URLs to the targets of their permanent redirects, so
+ *  that known redirects, such as those of URL shorteners, are followed
+ *  without accessing the network.
+ */
+class InfoCache final {
+ public:
+  /**
+   *  Cached information about an HTML document.
+   */
+  struct Entry {
+   public:
+    /**
+     *  Title of the HTML document.
+     */
+    std::string title;
+
+    /**
+     *  URL of the HTML document after redirects.
+     */
+    QUrl final_url;
+
+    /**
+     *  URLs that were redirected from, in order.
+     */
+    std::vector<QUrl> redirects;
+
+    /**
+     *  Description of the HTML document.
+     */
+    std::string description;
+
+    /**
+     *  Absolute URL that is linked as canonical, or an empty URL if there is
+     *  none.
+     */
+    QUrl canonical_url;
+
+    /**
+     *  Icons that are linked from the HTML document.
+     */
+    std::vector<Icon> icons;
+
+    /**
+     *  Value of the `ETag` header of the response, or an empty string if
+     *  there was none.
+     */
+    std::string etag;
+
+    /**
+     *  Value of the `Last-Modified` header of the response, or an empty
+     *  string if there was none.
+     */
+    std::string last_modified;
+
+    /**
+     *  When the entry was stored or last revalidated, in seconds since
+     *  epoch.
+     */
+    long long stored_at = 0;
+  };
+
+  /**
+   *  @param dir_path
+   *    Path to the cache directory. It is created if it does not exist.
+   *
+   *  @param max_entries
+   *    Maximum number of entries of each kind, or `0` for no limit. The
+   *    least recently stored entries of a kind are removed when the limit is
+   *    exceeded.
+   */
+  InfoCache(const std::string &dir_path, long long max_entries);
+
+  ~InfoCache();
+
+  /**
+   *  Look up the entry of a URL.
+   *
+   *  @param url
+   *    URL of the HTML document.
+   *
+   *  @param entry
+   *    Entry that is set if it is found.
+   *
+   *  @return
+   *    Whether the entry is found.
+   */
+  bool Lookup(const QUrl &url, Entry &entry) const;
+
+  /**
+   *  Store the entry of a URL, replacing any existing entry.
+   *
+   *  @param url
+   *    URL of the HTML document.
+   *
+   *  @param entry
+   *    Entry to store.
+   */
+  void Store(const QUrl &url, const Entry &entry);
+
+  /**
+   *  Look up the target of a permanent redirect.
+   *
+   *  @param url
+   *    URL that is redirected from.
+   *
+   *  @param target
+   *    Target of the redirect that is set if it is found.
+   *
+   *  @return
+   *    Whether the redirect is found.
+   */
+  bool LookupRedirect(const QUrl &url, QUrl &target) const;
+
+  /**
+   *  Store the target of a permanent redirect, replacing any existing one.
+   *
+   *  @param url
+   *    URL that is redirected from.
+   *
+   *  @param target
+   *    Target of the redirect.
+   */
+  void StoreRedirect(const QUrl &url, const QUrl &target);
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,1041 @@
+#include "xbelmark/html/info_request.h"
+
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRandomGenerator>
+#include <QString>
+#include <QTimer>
+#include <QtGlobal>
+
+#include "xbelmark/html/cache_policy.h"
+#include "xbelmark/html/charset.h"
+#include "xbelmark/html/content_type.h"
+#include "xbelmark/html/head_parser.h"
+#include "xbelmark/html/icon_request.h"
+#include "xbelmark/html/redirect_policy.h"
+#include "xbelmark/html/retry_policy.h"
+#include "xbelmark/html/title_scanner.h"
+#include "xbelmark/html/tls_session_store.h"
+
+namespace xbelmark {
+namespace html {
+
+class InfoRequest::Impl final {
+ public:
+  /**
+   *  Number of bytes at the beginning of a PDF file that are searched for its
+   *  title.
+   */
+  static constexpr long long pdf_probe_size = 64 * 1024;
+
+  /**
+   *  Size up to which a PDF file is searched for its title in its entirety,
+   *  since the document information dictionary is often near the end.
+   */
+  static constexpr long long pdf_full_probe_size = 256 * 1024;
+
+  /**
+   *  Maximum number of redirects that are followed.
+   */
+  static constexpr std::size_t max_redirects = 10;
+
+  /**
+   *  Number of latencies that must have been observed before their
+   *  percentile is used as the delay of hedging.
+   */
+  static constexpr std::size_t min_hedge_samples = 20;
+
+  /**
+   *  Maximum backoff in milliseconds before a retry.
+   */
+  static constexpr long long max_retry_backoff = 10000;
+
+  /**
+   *  Whether a network error is likely to be transient, so that the request
+   *  is worth retrying.
+   */
+  static bool IsTransientError(QNetworkReply::NetworkError error) {
+    switch (error) {
+      case QNetworkReply::ConnectionRefusedError:
+      case QNetworkReply::RemoteHostClosedError:
+      case QNetworkReply::TimeoutError:
+      case QNetworkReply::TemporaryNetworkFailureError:
+      case QNetworkReply::NetworkSessionFailedError:
+      case QNetworkReply::ProxyConnectionClosedError:
+      case QNetworkReply::ProxyTimeoutError:
+      case QNetworkReply::UnknownNetworkError:
+      case QNetworkReply::ServiceUnavailableError: {
+        return true;
+      }
+      default: {
+        return false;
+      }
+    }
+  }
+
+  /**
+   *  URL against which relative URLs in the HTML document are resolved.
+   */
+  QUrl base_url() const {
+    const std::string &base_href = parser_.base_href();
+    if (base_href.empty()) {
+      return reply_->url();
+    }
+    return reply_->url().resolved(QUrl(QString::fromStdString(base_href)));
+  }
+
+  /**
+   *  Record the title and the metadata that the parser has read, with the
+   *  URLs resolved against @link base_url @endlink.
+   */
+  void ReadHeadMetadata() {
+    if (info_.title.empty()) {
+      info_.title = parser_.title();
+    }
+    info_.og_title = parser_.og_title();
+    info_.twitter_title = parser_.twitter_title();
+    info_.description = parser_.description();
+    const QUrl base(base_url());
+    if (!parser_.canonical_href().empty()) {
+      info_.canonical_url = base.resolved(
+          QUrl(QString::fromStdString(parser_.canonical_href())));
+    }
+    for (const IconLink &link : parser_.icons()) {
+      Icon icon;
+      icon.url = base.resolved(QUrl(QString::fromStdString(link.href)));
+      icon.rel = link.rel;
+      icon.sizes = link.sizes;
+      icon.type = link.type;
+      info_.icons.push_back(icon);
+    }
+  }
+
+  /**
+   *  Feed the data that is available from the reply to the parser.
+   *
+   *  The data is buffered until the character encoding can be determined.
+   *  The transfer is aborted once the title has been read or the maximum
+   *  number of bytes has been reached.
+   */
+  void ReadAvailable() {
+    connect_timer_.stop();
+    first_byte_timer_.stop();
+    if (is_done_) {
+      return;
+    }
+    if (IsRedirectStatus(
+            reply_->attribute(
+                QNetworkRequest::HttpStatusCodeAttribute).toInt())) {
+      // The body of a redirect is not the HTML document.
+      reply_->readAll();
+      return;
+    }
+    if (probe_size_ > 0) {
+      ReadProbe();
+      return;
+    }
+    QByteArray chunk(reply_->readAll());
+    std::string &html = info_.html;
+    const long long max_bytes = options_.max_bytes;
+    if (max_bytes > 0 &&
+        static_cast<long long>(html.size() + chunk.size()) >= max_bytes) {
+      chunk.truncate(static_cast<int>(max_bytes - html.size()));
+      is_done_ = true;
+    }
+    html.append(chunk.constData(), chunk.size());
+    // Offset of the data that the parser has not consumed.
+    std::size_t unparsed = html.size() - chunk.size();
+    if (charset_.empty()) {
+      if (html.size() < kCharsetSniffSize && !is_done_ &&
+          !reply_->isFinished()) {
+        return;
+      }
+      SetCharset();
+      unparsed = 0;
+    }
+    if (is_scanning_) {
+      switch (scanner_.Scan(
+                  html.data(), html.size(), is_done_ || reply_->isFinished())) {
+        case TitleScanner::Status::FOUND: {
+          info_.title = scanner_.title();
+          is_done_ = true;
+          break;
+        }
+        case TitleScanner::Status::INCOMPLETE: {
+          break;
+        }
+        case TitleScanner::Status::FALLBACK: {
+          is_scanning_ = false;
+          unparsed = 0;
+          break;
+        }
+      }
+    }
+    if (!is_scanning_ && unparsed < html.size()) {
+      parser_.Parse(html.data() + unparsed, html.size() - unparsed, false);
+      is_done_ = is_done_ || parser_.is_done();
+    }
+    if (is_done_) {
+      reply_->abort();
+    }
+  }
+
+  /**
+   *  Determine the character encoding of the HTML document from, in order,
+   *  the `Content-Type` header, a declaration at the beginning of the HTML
+   *  document, and whether the beginning is valid UTF-8, and have the parser
+   *  decode from it.
+   *
+   *  UTF-8 is consumed by the parser without conversion. Any other character
+   *  encoding that is unknown to libxml2 is left to the parser to detect.
+   */
+  void SetCharset() {
+    const std::string &html = info_.html;
+    charset_ = CharsetFromContentType(
+        reply_->rawHeader("Content-Type").toStdString());
+    if (charset_.empty()) {
+      charset_ = SniffCharset(html.data(), html.size());
+    }
+    if (charset_.empty()) {
+      charset_ =
+          IsValidUtf8(html.data(), html.size(), !reply_->isFinished()) ?
+          "utf-8" : "windows-1252";
+    }
+    // Only the title of UTF-8 can be scanned without conversion.
+    is_scanning_ = !options_.metadata && charset_ == "utf-8";
+    if (charset_ != "utf-8") {
+      parser_.SetCharset(charset_);
+    }
+  }
+
+  /**
+   *  Inspect the response headers, and stop the transfer if the resource is
+   *  not HTML.
+   *
+   *  The title of a resource that is not HTML is its file name, or the title
+   *  in the metadata of a PDF file that is found by probing its beginning.
+   */
+  void InspectMetaData() {
+    connect_timer_.stop();
+    first_byte_timer_.stop();
+    const int status_code =
+        reply_->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status_code == 200 && !info_.html.empty()) {
+      // The HTML document has changed since the previous range was read, or
+      // the server has ignored the range.
+      range_end_ = 0;
+      ResetParser();
+    }
+    if (IsTransientStatus(status_code) &&
+        info_.num_retries < options_.max_retries) {
+      // The body of a response that is retried is not the HTML document.
+      is_done_ = true;
+      reply_->abort();
+      return;
+    }
+    if (!is_done_ && status_code >= 400) {
+      // The body is an error page rather than the document.
+      SetStatusError(status_code);
+      is_done_ = true;
+      reply_->abort();
+      return;
+    }
+    if (is_done_ || (status_code >= 300 && status_code < 400) ||
+        IsHtmlMediaType(reply_->rawHeader("Content-Type").toStdString())) {
+      return;
+    }
+    info_.title = FileNameFromContentDisposition(
+        reply_->rawHeader("Content-Disposition").toStdString());
+    if (info_.title.empty()) {
+      info_.title = reply_->url().fileName().toStdString();
+    }
+    if (MediaType(reply_->rawHeader("Content-Type").toStdString()) ==
+        "application/pdf") {
+      const long long content_length = reply_->header(
+          QNetworkRequest::ContentLengthHeader).toLongLong();
+      probe_size_ = pdf_probe_size;
+      if (content_length > 0 && content_length <= pdf_full_probe_size) {
+        probe_size_ = content_length;
+      }
+      return;
+    }
+    is_done_ = true;
+    reply_->abort();
+  }
+
+  /**
+   *  Set the error of a response with an HTTP status code of a failure,
+   *  unless there is already an error.
+   */
+  void SetStatusError(int status_code) {
+    if (!info_.error.empty()) {
+      return;
+    }
+    const QString reason(
+        reply_->attribute(
+            QNetworkRequest::HttpReasonPhraseAttribute).toString());
+    info_.error = "HTTP status " + std::to_string(status_code) +
+        (reason.isEmpty() ? "" : " " + reason.toStdString()) + ".";
+  }
+
+  /**
+   *  Read the data that is available from the reply into the probe of a PDF
+   *  file, and stop the transfer once enough has been read.
+   */
+  void ReadProbe() {
+    probe_.append(reply_->readAll());
+    if (static_cast<long long>(probe_.size()) < probe_size_ &&
+        !reply_->isFinished()) {
+      return;
+    }
+    const std::string pdf_title(PdfTitle(probe_.constData(), probe_.size()));
+    if (!pdf_title.empty()) {
+      info_.title = pdf_title;
+    }
+    probe_.clear();
+    is_done_ = true;
+    reply_->abort();
+  }
+
+  /**
+   *  Stop the transfer because a deadline has been exceeded.
+   *
+   *  Data that has been read but not yet parsed is parsed so that whatever
+   *  title has been read is kept.
+   *
+   *  @param deadline
+   *    Name of the deadline that has been exceeded.
+   */
+  void Expire(const std::string &deadline) {
+    if (retry_timer_.isActive()) {
+      // Give up on the retry that is waiting.
+      retry_timer_.stop();
+      info_.error = deadline + " deadline exceeded.";
+      is_done_ = true;
+      Finish();
+      return;
+    }
+    if (is_done_ || !reply_) {
+      return;
+    }
+    hedge_timer_.stop();
+    if (hedge_reply_) {
+      Drop(hedge_reply_);
+      hedge_reply_ = nullptr;
+    }
+    const std::string &html = info_.html;
+    if (probe_size_ == 0) {
+      if (charset_.empty() || is_scanning_) {
+        if (charset_.empty()) {
+          SetCharset();
+        }
+        is_scanning_ = false;
+        parser_.Parse(html.data(), html.size(), false);
+      }
+      parser_.Parse(nullptr, 0, true);
+    }
+    info_.error = deadline + " deadline exceeded.";
+    is_done_ = true;
+    reply_->abort();
+  }
+
+  /**
+   *  Start the timers of the deadlines.
+   */
+  void StartTimers(QObject *context) {
+    struct Deadline {
+      QTimer *timer;
+      long long timeout;
+      const char *name;
+    };
+    const Deadline deadlines[] = {
+      { &connect_timer_, options_.connect_timeout, "Connect" },
+      { &first_byte_timer_, options_.first_byte_timeout, "First-byte" },
+      { &total_timer_, options_.total_timeout, "Total" }
+    };
+    for (const Deadline &deadline : deadlines) {
+      if (deadline.timeout <= 0) {
+        continue;
+      }
+      const std::string name(deadline.name);
+      deadline.timer->setSingleShot(true);
+      QObject::connect(
+          deadline.timer, &QTimer::timeout,
+          context, [this, name]() -> void {
+            Expire(name);
+          });
+      deadline.timer->start(
+          static_cast<int>(qMin<long long>(deadline.timeout, INT_MAX)));
+    }
+  }
+
+  /**
+   *  Send a GET request, and read the reply.
+   *
+   *  A duplicate of the request is sent if it has not responded by the delay
+   *  of hedging.
+   */
+  void Get(QNetworkRequest request) {
+    is_claimed_ = false;
+    reply_ = Send(request);
+    attempt_timer_.start();
+    if (options_.hedge_percentile > 0) {
+      hedge_timer_.start(
+          static_cast<int>(qMin<long long>(HedgeDelay(), INT_MAX)));
+    }
+  }
+
+  /**
+   *  Send a GET request, and connect to the signals of the reply.
+   *
+   *  The signals of the reply are handled only once it has been claimed by
+   *  @link Claim @endlink.
+   */
+  QNetworkReply *Send(QNetworkRequest request) {
+    if (tls_sessions_) {
+      tls_sessions_->Apply(request);
+    }
+    QNetworkReply *reply = manager_->get(request);
+    if (tls_sessions_) {
+      tls_sessions_->Watch(reply);
+    }
+    QObject::connect(
+        reply, &QNetworkReply::requestSent,
+        owner_, [this]() -> void {
+          connect_timer_.stop();
+        });
+    QObject::connect(
+        reply, &QNetworkReply::metaDataChanged,
+        owner_, [this, reply]() -> void {
+          if (Claim(reply)) {
+            InspectMetaData();
+          }
+        });
+    QObject::connect(
+        reply, &QNetworkReply::readyRead,
+        owner_, [this, reply]() -> void {
+          if (Claim(reply)) {
+            ReadAvailable();
+          }
+        });
+    QObject::connect(
+        reply, &QNetworkReply::finished,
+        owner_, [this, reply]() -> void {
+          if (!is_claimed_ && hedge_reply_ &&
+              reply->error() != QNetworkReply::NoError) {
+            // Leave the retrieval to the other request.
+            if (reply == reply_) {
+              reply_ = hedge_reply_;
+              ++info_.num_hedge_wins;
+            }
+            hedge_reply_ = nullptr;
+            Drop(reply);
+            return;
+          }
+          if (Claim(reply)) {
+            Finish();
+          }
+        });
+    return reply;
+  }
+
+  /**
+   *  Time in milliseconds after which a duplicate of a request is sent.
+   */
+  long long HedgeDelay() const {
+    if (latency_tracker_ &&
+        latency_tracker_->size() >= min_hedge_samples) {
+      return latency_tracker_->Percentile(options_.hedge_percentile);
+    }
+    return options_.hedge_delay;
+  }
+
+  /**
+   *  Send a duplicate of the request that has not responded.
+   */
+  void SendHedge() {
+    if (is_claimed_ || is_done_ || !reply_ || hedge_reply_) {
+      return;
+    }
+    hedge_sent_at_ = attempt_timer_.elapsed();
+    hedge_reply_ = Send(reply_->request());
+    ++info_.num_hedges;
+  }
+
+  /**
+   *  Settle which reply is read once one of them responds, and abort the
+   *  other.
+   *
+   *  @param reply
+   *    Reply that has responded.
+   *
+   *  @return
+   *    Whether the reply is the one being read.
+   */
+  bool Claim(QNetworkReply *reply) {
+    if (is_claimed_) {
+      return reply == reply_;
+    }
+    is_claimed_ = true;
+    hedge_timer_.stop();
+    const bool is_hedge = reply == hedge_reply_;
+    if (latency_tracker_ && reply->error() == QNetworkReply::NoError) {
+      latency_tracker_->Record(
+          attempt_timer_.elapsed() - (is_hedge ? hedge_sent_at_ : 0));
+    }
+    if (hedge_reply_) {
+      QNetworkReply *loser = is_hedge ? reply_ : hedge_reply_;
+      if (is_hedge) {
+        ++info_.num_hedge_wins;
+      }
+      reply_ = reply;
+      hedge_reply_ = nullptr;
+      Drop(loser);
+    }
+    return true;
+  }
+
+  /**
+   *  Abort a reply that is no longer read.
+   */
+  void Drop(QNetworkReply *reply) {
+    QObject::disconnect(reply, nullptr, owner_, nullptr);
+    reply->abort();
+    reply->deleteLater();
+  }
+
+  /**
+   *  Discard what has been read, and start parsing from the beginning.
+   */
+  void ResetParser() {
+    parser_.Reset();
+    Info info;
+    info.url = info_.url;
+    info.redirects = info_.redirects;
+    info.num_retries = info_.num_retries;
+    info.num_hedges = info_.num_hedges;
+    info.num_hedge_wins = info_.num_hedge_wins;
+    info_ = info;
+    charset_.clear();
+    scanner_ = TitleScanner();
+    is_scanning_ = false;
+    is_done_ = false;
+  }
+
+  /**
+   *  Follow a redirect.
+   *
+   *  The target of a permanent redirect is stored in the cache. Redirects
+   *  from HTTPS to HTTP are not followed.
+   *
+   *  @param status_code
+   *    HTTP status code of the reply that has finished.
+   *
+   *  @return
+   *    Whether a request to the target has been sent.
+   */
+  bool FollowRedirect(int status_code) {
+    if (!IsRedirectStatus(status_code) || is_done_) {
+      return false;
+    }
+    const QUrl url(reply_->url());
+    const QUrl target(
+        url.resolved(QUrl::fromEncoded(reply_->rawHeader("Location"))));
+    const std::string error(
+        RedirectError(
+            url.scheme().toStdString(),
+            target.isValid() ? target.scheme().toStdString() : "",
+            info_.redirects.size(),
+            max_redirects));
+    if (!error.empty()) {
+      info_.error = error;
+      return false;
+    }
+    if (cache_ && IsPermanentRedirectStatus(status_code)) {
+      cache_->StoreRedirect(url, target);
+    }
+    info_.redirects.push_back(url);
+    QNetworkRequest request(reply_->request());
+    request.setUrl(target);
+    reply_->deleteLater();
+    Get(request);
+    return true;
+  }
+
+  /**
+   *  Request the rest of the HTML document after a range of it has been read
+   *  without finding the title.
+   *
+   *  @param status_code
+   *    HTTP status code of the reply that has finished.
+   *
+   *  @return
+   *    Whether another request has been sent.
+   */
+  bool ContinueRange(int status_code) {
+    if (range_end_ == 0 || is_done_) {
+      return false;
+    }
+    const long long offset = static_cast<long long>(info_.html.size());
+    QNetworkRequest request(reply_->request());
+    if (status_code == 206) {
+      long long first = 0;
+      long long last = 0;
+      long long complete_length = -1;
+      const bool is_valid = ParseContentRange(
+          reply_->rawHeader("Content-Range").toStdString(),
+          first, last, complete_length);
+      if (is_valid && (last + 1 == complete_length || last + 1 < range_end_)) {
+        // End of the HTML document.
+        return false;
+      }
+      QByteArray validator(reply_->rawHeader("ETag"));
+      if (validator.startsWith("W/")) {
+        // Weak validators cannot be used for ranges.
+        validator.clear();
+      }
+      if (validator.isEmpty()) {
+        validator = reply_->rawHeader("Last-Modified");
+      }
+      if (is_valid && !validator.isEmpty() && last + 1 == offset) {
+        // The next range is twice the size of the range that was read.
+        range_end_ = offset + 2 * (last + 1 - first);
+        request.setRawHeader(
+            "Range",
+            "bytes=" + QByteArray::number(offset) + "-" +
+            QByteArray::number(range_end_ - 1));
+        request.setRawHeader("If-Range", validator);
+      } else {
+        range_end_ = 0;
+      }
+    } else if (status_code == 416 && offset == 0) {
+      range_end_ = 0;
+    } else {
+      return false;
+    }
+    if (range_end_ == 0) {
+      // Start over with the whole HTML document.
+      request.setRawHeader("Range", QByteArray());
+      request.setRawHeader("If-Range", QByteArray());
+      ResetParser();
+    }
+    reply_->deleteLater();
+    Get(request);
+    return true;
+  }
+
+  /**
+   *  Schedule the request to be sent again after a transient failure.
+   *
+   *  The reply is kept until the request is sent again, so that the
+   *  retrieval can finish with it if a deadline is exceeded in the meantime.
+   *
+   *  @param status_code
+   *    HTTP status code of the reply that has finished.
+   *
+   *  @return
+   *    Whether the request has been scheduled.
+   */
+  bool Retry(int status_code) {
+    if (info_.num_retries >= options_.max_retries || !info_.error.empty() ||
+        (!IsTransientStatus(status_code) &&
+         !IsTransientError(reply_->error()))) {
+      return false;
+    }
+    long long delay = RetryDelay(
+        info_.num_retries + 1,
+        options_.retry_backoff,
+        max_retry_backoff,
+        QRandomGenerator::global()->generateDouble());
+    const long long retry_after =
+        RetryAfterDelay(reply_->rawHeader("Retry-After").toStdString());
+    if (retry_after > max_retry_backoff) {
+      return false;
+    }
+    delay = qMax(delay, retry_after);
+    ++info_.num_retries;
+    retry_timer_.start(static_cast<int>(delay));
+    return true;
+  }
+
+  /**
+   *  Send the request again from the beginning of the HTML document.
+   */
+  void Resend() {
+    QNetworkRequest request(reply_->request());
+    request.setRawHeader("If-Range", QByteArray());
+    request.setRawHeader("Range", QByteArray());
+    range_end_ = qMax<long long>(options_.range_bytes, 0);
+    if (range_end_ > 0) {
+      request.setRawHeader(
+          "Range", "bytes=0-" + QByteArray::number(range_end_ - 1));
+    }
+    reply_->deleteLater();
+    reply_ = nullptr;
+    probe_size_ = 0;
+    probe_.clear();
+    ResetParser();
+    Get(request);
+  }
+
+  /**
+   *  Use the cached entry as the information.
+   */
+  void UseCachedEntry() {
+    info_.title = cached_entry_.title;
+    info_.final_url = cached_entry_.final_url;
+    info_.redirects = cached_entry_.redirects;
+    info_.description = cached_entry_.description;
+    info_.canonical_url = cached_entry_.canonical_url;
+    info_.icons = cached_entry_.icons;
+    info_.from_cache = true;
+  }
+
+  /**
+   *  Finish the retrieval without accessing the network.
+   */
+  void FinishFromCache() {
+    if (has_cached_entry_) {
+      UseCachedEntry();
+    } else {
+      info_.error = "Not in the cache.";
+    }
+    FetchIcon();
+  }
+
+  /**
+   *  Finish the retrieval after the reply has finished.
+   */
+  void Finish() {
+    connect_timer_.stop();
+    first_byte_timer_.stop();
+    ReadAvailable();
+    const int status_code =
+        reply_->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (FollowRedirect(status_code) || ContinueRange(status_code) ||
+        Retry(status_code)) {
+      return;
+    }
+    total_timer_.stop();
+    info_.final_url = reply_->url();
+    if (IsRevalidated(status_code, has_cached_entry_)) {
+      UseCachedEntry();
+      cached_entry_.stored_at = QDateTime::currentSecsSinceEpoch();
+      cache_->Store(info_.url, cached_entry_);
+    } else {
+      if (!is_done_) {
+        parser_.Parse(nullptr, 0, true);
+        if (info_.error.empty() &&
+            reply_->error() != QNetworkReply::NoError) {
+          info_.error = reply_->errorString().toUtf8().constData();
+        }
+      }
+      // The title might have been found before the status was inspected.
+      if (status_code >= 400) {
+        SetStatusError(status_code);
+      }
+      ReadHeadMetadata();
+      if (info_.title.empty()) {
+        info_.title = info_.og_title.empty() ?
+            info_.twitter_title : info_.og_title;
+      }
+      // Only the title might have been read without the metadata.
+      if (cache_ &&
+          IsCacheableResponse(
+              status_code, options_.metadata, !info_.error.empty())) {
+        InfoCache::Entry entry;
+        entry.title = info_.title;
+        entry.final_url = info_.final_url;
+        entry.redirects = info_.redirects;
+        entry.description = info_.description;
+        entry.canonical_url = info_.canonical_url;
+        entry.icons = info_.icons;
+        entry.etag = reply_->rawHeader("ETag").constData();
+        entry.last_modified = reply_->rawHeader("Last-Modified").constData();
+        entry.stored_at = QDateTime::currentSecsSinceEpoch();
+        cache_->Store(info_.url, entry);
+      }
+    }
+    parser_.Free();
+    reply_->deleteLater();
+    reply_ = nullptr;
+    FetchIcon();
+  }
+
+  /**
+   *  Fetch the icon of the HTML document if an icon cache is given, and then
+   *  finish.
+   */
+  void FetchIcon() {
+    if (options_.icon_cache_dir.empty() || !info_.error.empty()) {
+      Complete();
+      return;
+    }
+    icon_request_.reset(new IconRequest(*manager_, info_, options_));
+    icon_request_->Start([this]() -> void {
+      info_.icon_url = icon_request_->icon_url();
+      Complete();
+    });
+  }
+
+  /**
+   *  Mark the retrieval as finished, and call the function for it.
+   */
+  void Complete() {
+    is_finished_ = true;
+    if (on_finished_) {
+      on_finished_();
+    }
+  }
+
+  QNetworkAccessManager *manager_ = nullptr;
+
+  /**
+   *  Context of the connections to the signals of the replies.
+   */
+  QObject *owner_ = nullptr;
+
+  RetrievalOptions options_;
+
+  /**
+   *  Cache to consult and update, or `nullptr` if there is none.
+   */
+  InfoCache *cache_ = nullptr;
+
+  /**
+   *  Store of the TLS sessions to resume, or `nullptr` if there is none.
+   */
+  std::unique_ptr<TlsSessionStore> tls_sessions_;
+
+  /**
+   *  Latencies shared with other retrievals, or `nullptr` if there are none.
+   */
+  LatencyTracker *latency_tracker_ = nullptr;
+
+  /**
+   *  Entry from the cache, which is valid only if @link has_cached_entry_
+   *  @endlink is `true`.
+   */
+  InfoCache::Entry cached_entry_;
+
+  bool has_cached_entry_ = false;
+
+  Info info_;
+
+  /**
+   *  Reply that is being read, or `nullptr` if there is none.
+   */
+  QNetworkReply *reply_ = nullptr;
+
+  /**
+   *  Duplicate of the request that is racing @link reply_ @endlink, or
+   *  `nullptr` if there is none.
+   */
+  QNetworkReply *hedge_reply_ = nullptr;
+
+  /**
+   *  Whether a reply to the request that was last sent has responded, which
+   *  settles the race with its duplicate.
+   */
+  bool is_claimed_ = false;
+
+  /**
+   *  Parser of the title and the metadata of the HTML document.
+   */
+  HeadParser parser_;
+
+  /**
+   *  Offset past the last byte that has been requested with a `Range` header,
+   *  or `0` if the whole HTML document has been requested.
+   */
+  long long range_end_ = 0;
+
+  /**
+   *  Timer of the deadline for sending the request.
+   */
+  QTimer connect_timer_;
+
+  /**
+   *  Timer of the deadline for the response to start arriving.
+   */
+  QTimer first_byte_timer_;
+
+  /**
+   *  Timer of the deadline for the retrieval to finish.
+   */
+  QTimer total_timer_;
+
+  /**
+   *  Timer of the delay before a duplicate of the request is sent.
+   */
+  QTimer hedge_timer_;
+
+  /**
+   *  Timer of the backoff before the request is sent again.
+   */
+  QTimer retry_timer_;
+
+  /**
+   *  Time since the request was last sent.
+   */
+  QElapsedTimer attempt_timer_;
+
+  /**
+   *  Time in milliseconds after the request was last sent at which its
+   *  duplicate was sent.
+   */
+  long long hedge_sent_at_ = 0;
+
+  /**
+   *  Number of bytes to read into @link probe_ @endlink, or `0` if the
+   *  resource is not being probed.
+   */
+  long long probe_size_ = 0;
+
+  /**
+   *  Beginning of a resource that is not HTML.
+   */
+  QByteArray probe_;
+
+  /**
+   *  Scanner of the title that is used instead of the parser for UTF-8 if
+   *  the metadata is not needed.
+   */
+  TitleScanner scanner_;
+
+  /**
+   *  Whether the title is being scanned by @link scanner_ @endlink rather
+   *  than parsed.
+   */
+  bool is_scanning_ = false;
+
+  /**
+   *  Canonical name of the character encoding of the HTML document, or an
+   *  empty string if it has not been determined.
+   */
+  std::string charset_;
+
+  std::function<void()> on_finished_;
+
+  /**
+   *  Retrieval of the icon, or `nullptr` if it has not started.
+   */
+  std::unique_ptr<IconRequest> icon_request_;
+
+  /**
+   *  Whether no more data is to be parsed.
+   */
+  bool is_done_ = false;
+
+  bool is_finished_ = false;
+};
+
+InfoRequest::InfoRequest(
+    QNetworkAccessManager &manager,
+    const QUrl &url,
+    const RetrievalOptions &options,
+    InfoCache *cache,
+    LatencyTracker *latency_tracker) : p_impl_(new Impl()) {
+  p_impl_->manager_ = &manager;
+  p_impl_->options_ = options;
+  p_impl_->cache_ = cache;
+  p_impl_->latency_tracker_ = latency_tracker;
+  p_impl_->info_.url = url;
+  if (!options.tls_session_dir.empty()) {
+    p_impl_->tls_sessions_.reset(new TlsSessionStore(options.tls_session_dir));
+  }
+}
+
+InfoRequest::~InfoRequest() {
+  if (p_impl_->reply_) {
+    QObject::disconnect(p_impl_->reply_, nullptr, this, nullptr);
+    p_impl_->reply_->abort();
+    p_impl_->reply_->deleteLater();
+  }
+  if (p_impl_->hedge_reply_) {
+    QObject::disconnect(p_impl_->hedge_reply_, nullptr, this, nullptr);
+    p_impl_->hedge_reply_->abort();
+    p_impl_->hedge_reply_->deleteLater();
+  }
+}
+
+void InfoRequest::Start(std::function<void()> on_finished) {
+  Impl *impl = p_impl_.get();
+  impl->on_finished_ = std::move(on_finished);
+  if (impl->cache_) {
+    impl->has_cached_entry_ =
+        impl->cache_->Lookup(impl->info_.url, impl->cached_entry_);
+  }
+  if (impl->options_.cache_only ||
+      (impl->has_cached_entry_ &&
+       IsFreshEntry(
+           impl->cached_entry_.stored_at,
+           QDateTime::currentSecsSinceEpoch(),
+           impl->options_.cache_ttl))) {
+    // Finish asynchronously as if the network were accessed.
+    QTimer::singleShot(0, this, [impl]() -> void {
+      impl->FinishFromCache();
+    });
+    return;
+  }
+  // Follow the redirects that are known from the cache.
+  QUrl url(impl->info_.url);
+  QUrl target;
+  while (impl->cache_ &&
+         impl->info_.redirects.size() < Impl::max_redirects &&
+         impl->cache_->LookupRedirect(url, target)) {
+    impl->info_.redirects.push_back(url);
+    url = target;
+  }
+  QNetworkRequest request(url);
+  request.setAttribute(
+      QNetworkRequest::RedirectPolicyAttribute,
+      QNetworkRequest::ManualRedirectPolicy);
+  if (impl->has_cached_entry_) {
+    for (const auto &header : RevalidationHeaders(
+             impl->cached_entry_.etag, impl->cached_entry_.last_modified)) {
+      request.setRawHeader(header.first.c_str(), header.second.c_str());
+    }
+  }
+  if (impl->options_.range_bytes > 0) {
+    impl->range_end_ = impl->options_.range_bytes;
+    request.setRawHeader(
+        "Range",
+        "bytes=0-" + QByteArray::number(impl->range_end_ - 1));
+  }
+  impl->owner_ = this;
+  impl->hedge_timer_.setSingleShot(true);
+  QObject::connect(
+      &impl->hedge_timer_, &QTimer::timeout,
+      this, [impl]() -> void {
+        impl->SendHedge();
+      });
+  impl->retry_timer_.setSingleShot(true);
+  QObject::connect(
+      &impl->retry_timer_, &QTimer::timeout,
+      this, [impl]() -> void {
+        impl->Resend();
+      });
+  impl->ResetParser();
+  impl->Get(request);
+  impl->StartTimers(this);
+}
+
+bool InfoRequest::is_finished() const {
+  return p_impl_->is_finished_;
+}
+
+const Info &InfoRequest::info() const {
+  return p_impl_->info_;
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,119 @@
+#ifndef XBELMARK_HTML_INFO_REQUEST_H
+#define XBELMARK_HTML_INFO_REQUEST_H
+
+#include <functional>
+#include <memory>
+
+#include <QNetworkAccessManager>
+#include <QObject>
+#include <QUrl>
+
+#include "xbelmark/html/info.h"
+#include "xbelmark/html/info_cache.h"
+#include "xbelmark/html/latency_tracker.h"
+#include "xbelmark/html/retrieval_options.h"
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Asynchronous retrieval of information about an HTML document.
+ *
+ *  The HTML document is parsed as it is being downloaded, and the transfer is
+ *  aborted as soon as the `head` element and the title have been read. The
+ *  metadata in the `head` element is gathered in the same pass. Progress is
+ *  made only while an event loop is running in the thread of the network
+ *  access manager.
+ *
+ *  If a cache is given, a fresh entry is used without accessing the network,
+ *  and a stale entry is revalidated with a conditional request so that an
+ *  unchanged HTML document is not downloaded again.
+ *
+ *  Redirects are followed by the request itself so that the chain of
+ *  redirects is recorded. If a cache is given, permanent redirects are stored
+ *  in it, and those that are known are followed without accessing the
+ *  network.
+ *
+ *  If @link RetrievalOptions::range_bytes @endlink is positive, the HTML
+ *  document is downloaded in widening ranges until the title has been read.
+ *
+ *  If @link RetrievalOptions::icon_cache_dir @endlink is given, the icons of
+ *  the HTML document are fetched by an @link IconRequest @endlink before the
+ *  retrieval finishes.
+ *
+ *  If @link RetrievalOptions::tls_session_dir @endlink is given, the TLS
+ *  sessions of earlier processes are resumed from a @link TlsSessionStore
+ *  @endlink, and the sessions that are established are stored in it.
+ *
+ *  If @link RetrievalOptions::hedge_percentile @endlink is positive, a
+ *  duplicate of a request that has not responded within the percentile of
+ *  the latencies in a @link LatencyTracker @endlink is sent, and the reply
+ *  that responds first is read. If @link RetrievalOptions::max_retries
+ *  @endlink is positive, a request that fails transiently is sent again after
+ *  a jittered exponential backoff.
+ */
+class InfoRequest final : public QObject {
+ public:
+  /**
+   *  @param manager
+   *    Network access manager that sends the request. It must outlive the
+   *    retrieval.
+   *
+   *  @param url
+   *    URL to the HTML document.
+   *
+   *  @param options
+   *    Options for the retrieval.
+   *
+   *  @param cache
+   *    Cache to consult and update, or `nullptr` for no cache. It must outlive
+   *    the retrieval.
+   *
+   *  @param latency_tracker
+   *    Latencies from which the delay of hedging is estimated, and to which
+   *    the latencies of this retrieval are added, or `nullptr` for hedging
+   *    after @link RetrievalOptions::hedge_delay @endlink. It must outlive the
+   *    retrieval.
+   */
+  InfoRequest(
+      QNetworkAccessManager &manager,
+      const QUrl &url,
+      const RetrievalOptions &options = RetrievalOptions(),
+      InfoCache *cache = nullptr,
+      LatencyTracker *latency_tracker = nullptr);
+
+  /**
+   *  The transfer is aborted if it has not finished.
+   */
+  virtual ~InfoRequest();
+
+  /**
+   *  Start the retrieval.
+   *
+   *  @param on_finished
+   *    Function that is called once the retrieval has finished. The request
+   *    must not be deleted from within the function, but it can be scheduled
+   *    for deletion with `deleteLater`.
+   */
+  void Start(std::function<void()> on_finished);
+
+  /**
+   *  Whether the retrieval has finished.
+   */
+  bool is_finished() const;
+
+  /**
+   *  Information that has been retrieved so far.
+   */
+  const Info &info() const;
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
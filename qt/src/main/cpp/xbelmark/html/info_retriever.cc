@@ -1,138 +1,100 @@
 #include "xbelmark/html/info_retriever.h"
 
-#include <functional>
-#include <regex>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <QEventLoop>
 #include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QNetworkRequest>
 #include <QString>
-#include <libxml/HTMLparser.h>
+
+#include "xbelmark/html/file_name.h"
+#include "xbelmark/html/info_cache.h"
+#include "xbelmark/html/info_request.h"
 
 namespace xbelmark {
 namespace html {
 
 class InfoRetriever::Impl final {
  public:
-  static const std::regex title_re;
-
-  static void StartElement(
-      void *ctx, const xmlChar *name, const xmlChar **atts) {
-    Impl *obj = static_cast<Impl *>(ctx);
-    if (std::regex_match(reinterpret_cast<const char *>(name), title_re)) {
-      obj->is_title_ = true;
-    }
-  }
-
-  static void EndElement(void *ctx, const xmlChar *name) {
-    Impl *obj = static_cast<Impl *>(ctx);
-    if (std::regex_match(reinterpret_cast<const char *>(name), title_re)) {
-      obj->is_title_ = false;
-    }
-  }
-
-  static void Characters(void *ctx, const xmlChar *ch, int len) {
-    Impl *obj = static_cast<Impl *>(ctx);
-    if (obj->is_title_) {
-      obj->title_ += reinterpret_cast<const char *>(ch);
-    }
-  }
-
-  static htmlSAXHandler html_sax_handler() {
-    htmlSAXHandler retval;
-    retval.internalSubset = nullptr;
-    retval.isStandalone = nullptr;
-    retval.hasInternalSubset = nullptr;
-    retval.hasExternalSubset = nullptr;
-    retval.resolveEntity = nullptr;
-    retval.getEntity = nullptr;
-    retval.entityDecl = nullptr;
-    retval.notationDecl = nullptr;
-    retval.attributeDecl = nullptr;
-    retval.elementDecl = nullptr;
-    retval.unparsedEntityDecl = nullptr;
-    retval.setDocumentLocator = nullptr;
-    retval.startDocument = nullptr;
-    retval.endDocument = nullptr;
-    retval.startElement = &StartElement;
-    retval.endElement = &EndElement;
-    retval.reference = nullptr;
-    retval.characters = &Characters;
-    retval.ignorableWhitespace = nullptr;
-    retval.processingInstruction = nullptr;
-    retval.comment = nullptr;
-    retval.warning = nullptr;
-    retval.error = nullptr;
-    retval.fatalError = nullptr;
-    retval.getParameterEntity = nullptr;
-    retval.cdataBlock = &Characters;
-    retval.externalSubset = nullptr;
-    return retval;
-  }
-
-  QUrl url_;
-
   QNetworkAccessManager manager_;
 
-  std::string html_;
-
-  std::string title_;
+  /**
+   *  Cache, or `nullptr` if there is none.
+   */
+  std::unique_ptr<InfoCache> cache_;
 
-  bool is_title_ = false;
+  Info info_;
 };
 
-const std::regex InfoRetriever::Impl::title_re(
-    "title",
-    std::regex_constants::icase | std::regex_constants::optimize);
-
-InfoRetriever::InfoRetriever(const QUrl &url) : p_impl_(new Impl()) {
-  p_impl_->url_ = url;
-  {
-    QNetworkReply *reply(p_impl_->manager_.get(QNetworkRequest(url)));
-    QEventLoop loop;
-    QObject::connect(
-        reply, &QNetworkReply::finished,
-        &loop, &QEventLoop::quit);
-    loop.exec();
-    p_impl_->html_ = QString(reply->readAll()).toUtf8().constData();
-    reply->deleteLater();
+InfoRetriever::InfoRetriever(
+    const QUrl &url,
+    const RetrievalOptions &options) : p_impl_(new Impl()) {
+  if (!options.cache_dir.empty()) {
+    p_impl_->cache_.reset(
+        new InfoCache(options.cache_dir, options.cache_max_entries));
   }
-  {
-    htmlSAXHandler handler(Impl::html_sax_handler());
-    htmlParserCtxtPtr ctxt(
-        htmlCreatePushParserCtxt(
-            &handler, p_impl_.get(), "", 0, "", XML_CHAR_ENCODING_NONE));
-    htmlParseChunk(ctxt, p_impl_->html_.data(), p_impl_->html_.size(), 0);
-    htmlParseChunk(ctxt, "", 0, 1);
-    htmlFreeParserCtxt(ctxt);
+  InfoRequest request(
+      p_impl_->manager_, url, options, p_impl_->cache_.get());
+  QEventLoop loop;
+  request.Start([&loop]() -> void {
+    loop.quit();
+  });
+  if (!request.is_finished()) {
+    loop.exec();
   }
+  p_impl_->info_ = request.info();
 }
 
 InfoRetriever::~InfoRetriever() = default;
 
 const QUrl &InfoRetriever::url() const {
-  return p_impl_->url_;
+  return p_impl_->info_.url;
+}
+
+const QUrl &InfoRetriever::final_url() const {
+  return p_impl_->info_.final_url;
+}
+
+const std::vector<QUrl> &InfoRetriever::redirects() const {
+  return p_impl_->info_.redirects;
 }
 
 const std::string &InfoRetriever::html() const {
-  return p_impl_->html_;
+  return p_impl_->info_.html;
 }
 
 const std::string &InfoRetriever::title() const {
-  return p_impl_->title_;
+  return p_impl_->info_.title;
+}
+
+const Info &InfoRetriever::info() const {
+  return p_impl_->info_;
+}
+
+/**
+ *  Title in Unicode Normalization Form C so that the same title gives the
+ *  same file name regardless of how it was composed.
+ */
+std::string NormalizedTitle(const std::string &title) {
+  for (char ch : title) {
+    if (static_cast<unsigned char>(ch) >= 0x80) {
+      return QString::fromStdString(title)
+          .normalized(QString::NormalizationForm_C).toStdString();
+    }
+  }
+  return title;
 }
 
 std::string InfoRetriever::win_title_name() const {
-  const std::regex reserved_re("<|>|:|\"|/|\\\\|\\||\\?|\\*");
-  std::string retval(title());
+  return WinTitleName(p_impl_->info_);
+}
+
+std::string WinTitleName(const Info &info, char space) {
+  std::string retval(SanitizedFileName(NormalizedTitle(info.title), space));
   if (retval.empty()) {
-    retval = url().toString().toUtf8().constData();
+    retval = SanitizedFileName(info.url.toString().toStdString(), space);
   }
-  retval = std::regex_replace(retval, std::regex("^\\s+|\\s+$"), "");
-  retval = std::regex_replace(retval, std::regex("\\s+"), " ");
-  retval = std::regex_replace(retval, reserved_re, "_");
   return retval;
 }
 
@@ -3,10 +3,14 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <QObject>
 #include <QUrl>
 
+#include "xbelmark/html/info.h"
+#include "xbelmark/html/retrieval_options.h"
+
 namespace xbelmark {
 namespace html {
 
@@ -18,10 +22,18 @@ class InfoRetriever final : public QObject {
 
  public:
   /**
+   *  The HTML document is parsed as it is being downloaded, and the transfer
+   *  is aborted as soon as the `head` element and the title have been read.
+   *
    *  @param url
    *    URL to the HTML document.
+   *
+   *  @param options
+   *    Options for the retrieval.
    */
-  InfoRetriever(const QUrl &url);
+  InfoRetriever(
+      const QUrl &url,
+      const RetrievalOptions &options = RetrievalOptions());
 
   virtual ~InfoRetriever();
 
@@ -31,15 +43,35 @@ class InfoRetriever final : public QObject {
   const QUrl &url() const;
 
   /**
-   *  HTML document as a string.
+   *  URL of the HTML document after redirects.
+   */
+  const QUrl &final_url() const;
+
+  /**
+   *  URLs that were redirected from, in order, beginning with @link url
+   *  @endlink if it was redirected.
+   */
+  const std::vector<QUrl> &redirects() const;
+
+  /**
+   *  HTML document as a string in its original character encoding.
+   *
+   *  Since the transfer is aborted once the title has been read, it is only
+   *  the beginning of the document up to the end of the `head` element.
    */
   const std::string &html() const;
 
   /**
-   *  Title of the HTML document.
+   *  Title of the HTML document in UTF-8.
    */
   const std::string &title() const;
 
+  /**
+   *  Information about the HTML document, including the metadata that is
+   *  read in the same pass as the title.
+   */
+  const Info &info() const;
+
   /**
    *  HTML title with illegal file name characters under Windows replaced with
    *  legal characters.
@@ -60,6 +92,22 @@ class InfoRetriever final : public QObject {
   std::unique_ptr<Impl> p_impl_;
 };
 
+/**
+ *  HTML title with illegal file name characters under Windows replaced with
+ *  legal characters.
+ *
+ *  @param info
+ *    Information about the HTML document.
+ *
+ *  @param space
+ *    Character that replaces a run of whitespace.
+ *
+ *  @return
+ *    Title in Normalization Form C that is sanitized by `SanitizedFileName`.
+ *    If the title has no legal characters, the URL is used.
+ */
+std::string WinTitleName(const Info &info, char space = ' ');
+
 } // namespace html
 } // namespace xbelmark
 
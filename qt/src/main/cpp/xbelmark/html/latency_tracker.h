@@ -0,0 +1,88 @@
+#ifndef XBELMARK_HTML_LATENCY_TRACKER_H
+#define XBELMARK_HTML_LATENCY_TRACKER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Recent latencies of requests, from which a percentile is estimated to
+ *  decide when a request is slow enough to be hedged.
+ *
+ *  Only the most recent latencies up to the capacity are kept, so that the
+ *  estimate follows changes in network conditions.
+ */
+class LatencyTracker final {
+ public:
+  /**
+   *  @param capacity
+   *    Maximum number of latencies that are kept. It must be positive.
+   */
+  explicit LatencyTracker(std::size_t capacity = 256)
+      : capacity_(capacity) {
+    samples_.reserve(capacity);
+  }
+
+  /**
+   *  Record the latency of a request.
+   *
+   *  @param latency
+   *    Latency in milliseconds. It replaces the oldest one if the tracker is
+   *    full.
+   */
+  void Record(long long latency) {
+    if (samples_.size() < capacity_) {
+      samples_.push_back(latency);
+    } else {
+      samples_[next_] = latency;
+    }
+    next_ = (next_ + 1) % capacity_;
+  }
+
+  /**
+   *  Number of latencies that are kept.
+   */
+  std::size_t size() const {
+    return samples_.size();
+  }
+
+  /**
+   *  Percentile of the kept latencies by the nearest-rank method.
+   *
+   *  @param percent
+   *    Percentile in `(0, 100]`.
+   *
+   *  @return
+   *    Latency in milliseconds, or `-1` if no latencies are kept.
+   */
+  long long Percentile(double percent) const {
+    if (samples_.empty()) {
+      return -1;
+    }
+    std::size_t rank = static_cast<std::size_t>(
+        std::ceil(percent / 100.0 * samples_.size()));
+    rank = std::min(std::max(rank, std::size_t(1)), samples_.size());
+    std::vector<long long> sorted(samples_);
+    std::nth_element(sorted.begin(), sorted.begin() + (rank - 1), sorted.end());
+    return sorted[rank - 1];
+  }
+
+ private:
+  std::size_t capacity_;
+
+  std::vector<long long> samples_;
+
+  /**
+   *  Index of the sample that is replaced next once the tracker is full.
+   */
+  std::size_t next_ = 0;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef XBELMARK_HTML_REDIRECT_POLICY_H
+#define XBELMARK_HTML_REDIRECT_POLICY_H
+
+#include <cstddef>
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Whether an HTTP status code is of a redirect that is followed.
+ */
+inline bool IsRedirectStatus(int status_code) {
+  return status_code == 301 || status_code == 302 || status_code == 303 ||
+      status_code == 307 || status_code == 308;
+}
+
+/**
+ *  Whether an HTTP status code is of a permanent redirect, whose target can
+ *  be cached.
+ */
+inline bool IsPermanentRedirectStatus(int status_code) {
+  return status_code == 301 || status_code == 308;
+}
+
+/**
+ *  Reason that a redirect is not followed.
+ *
+ *  Only targets that are HTTP or HTTPS are followed, and a redirect from
+ *  HTTPS to HTTP is not followed.
+ *
+ *  @param scheme
+ *    Scheme of the URL that is redirected from.
+ *
+ *  @param target_scheme
+ *    Scheme of the target, or an empty string if the target is invalid.
+ *
+ *  @param num_redirects
+ *    Number of redirects that have been followed.
+ *
+ *  @param max_redirects
+ *    Maximum number of redirects that are followed.
+ *
+ *  @return
+ *    Error message, or an empty string if the redirect is followed.
+ */
+inline std::string RedirectError(
+    const std::string &scheme,
+    const std::string &target_scheme,
+    std::size_t num_redirects,
+    std::size_t max_redirects) {
+  if (target_scheme != "http" && target_scheme != "https") {
+    return "Invalid redirect.";
+  }
+  if (scheme == "https" && target_scheme == "http") {
+    return "Insecure redirect.";
+  }
+  if (num_redirects >= max_redirects) {
+    return "Too many redirects.";
+  }
+  return "";
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
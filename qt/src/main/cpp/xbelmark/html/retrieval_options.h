@@ -0,0 +1,147 @@
+#ifndef XBELMARK_HTML_RETRIEVAL_OPTIONS_H
+#define XBELMARK_HTML_RETRIEVAL_OPTIONS_H
+
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Options for retrieving information about an HTML document.
+ */
+struct RetrievalOptions {
+ public:
+  /**
+   *  Maximum number of bytes of the HTML document to download before the
+   *  transfer is aborted, or `0` for no limit.
+   *
+   *  The title is almost always within the first few kilobytes, so the limit
+   *  only matters for documents without a title.
+   */
+  long long max_bytes = 1024 * 1024;
+
+  /**
+   *  Number of bytes at the beginning of the HTML document to request with a
+   *  `Range` header, or `0` to request the whole HTML document.
+   *
+   *  If the title is not in the range, a range of twice the size that follows
+   *  is requested, and so on. The whole HTML document is requested instead if
+   *  the server does not support ranges, or if it cannot tell whether the
+   *  HTML document has changed between ranges.
+   */
+  long long range_bytes = 0;
+
+  /**
+   *  Whether the metadata in the `head` element is gathered in addition to
+   *  the title.
+   *
+   *  If not, the title of an HTML document in UTF-8 is found by a scanner
+   *  that is faster than the HTML parser, and the result is not stored in the
+   *  cache.
+   */
+  bool metadata = true;
+
+  /**
+   *  Time in milliseconds within which the request must be sent to the
+   *  server, or `0` for no limit.
+   */
+  long long connect_timeout = 5000;
+
+  /**
+   *  Time in milliseconds within which the response must start arriving, or
+   *  `0` for no limit.
+   */
+  long long first_byte_timeout = 10000;
+
+  /**
+   *  Time in milliseconds within which the retrieval must finish, or `0` for
+   *  no limit.
+   *
+   *  The deadlines are measured from the start of the retrieval. When one is
+   *  exceeded, the transfer is aborted, and whatever title has been read is
+   *  kept.
+   */
+  long long total_timeout = 15000;
+
+  /**
+   *  Percentile of the latency to the first byte beyond which a duplicate of
+   *  a request is sent, or `0` for not hedging requests.
+   *
+   *  Whichever of the two replies responds first is read, and the other is
+   *  aborted. The percentile is estimated from the latencies that have been
+   *  observed by the process, so it only matters when many requests are made,
+   *  as in bulk or by the daemon.
+   */
+  double hedge_percentile = 0;
+
+  /**
+   *  Time in milliseconds after which a duplicate of a request is sent until
+   *  enough latencies have been observed to estimate the percentile.
+   */
+  long long hedge_delay = 1000;
+
+  /**
+   *  Maximum number of times that a request is retried after a transient
+   *  failure, such as a refused connection or a status of `503`.
+   *
+   *  Retries are bounded by the total deadline.
+   */
+  int max_retries = 0;
+
+  /**
+   *  Backoff in milliseconds before the first retry, which doubles with each
+   *  retry and is jittered.
+   */
+  long long retry_backoff = 250;
+
+  /**
+   *  Path to the directory of the persistent cache, or an empty string for no
+   *  cache.
+   */
+  std::string cache_dir;
+
+  /**
+   *  Maximum number of entries of each kind in the cache, or `0` for no
+   *  limit.
+   */
+  long long cache_max_entries = 10000;
+
+  /**
+   *  Age in seconds up to which a cached entry is used without being
+   *  revalidated with the server.
+   */
+  long long cache_ttl = 24 * 60 * 60;
+
+  /**
+   *  Whether only the cache is consulted, regardless of the age of the
+   *  entries, without accessing the network.
+   */
+  bool cache_only = false;
+
+  /**
+   *  Path to the directory of the persisted TLS sessions, or an empty string
+   *  for not resuming the TLS sessions of earlier processes.
+   */
+  std::string tls_session_dir;
+
+  /**
+   *  Path to the directory of the icon cache, or an empty string for not
+   *  fetching icons.
+   *
+   *  The icons that are linked from the HTML document are fetched
+   *  concurrently after it has been read, and those that are already in the
+   *  icon cache are not fetched again.
+   */
+  std::string icon_cache_dir;
+
+  /**
+   *  Maximum number of bytes of an icon, beyond which its transfer is
+   *  aborted.
+   */
+  long long icon_max_bytes = 256 * 1024;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
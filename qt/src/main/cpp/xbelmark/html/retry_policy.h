@@ -0,0 +1,79 @@
+#ifndef XBELMARK_HTML_RETRY_POLICY_H
+#define XBELMARK_HTML_RETRY_POLICY_H
+
+#include <cstdlib>
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Whether an HTTP status code is of a failure that is likely to be
+ *  transient, so that the request is worth retrying.
+ */
+inline bool IsTransientStatus(int status_code) {
+  return status_code == 408 || status_code == 425 || status_code == 429 ||
+      status_code == 502 || status_code == 503 || status_code == 504;
+}
+
+/**
+ *  Delay before a retry, which grows exponentially with the attempt and is
+ *  jittered so that clients that failed together do not retry together.
+ *
+ *  Half of the backoff is fixed, and the other half is random.
+ *
+ *  @param attempt
+ *    Number of the retry, starting at `1`.
+ *
+ *  @param base_delay
+ *    Backoff in milliseconds of the first retry.
+ *
+ *  @param max_delay
+ *    Maximum backoff in milliseconds.
+ *
+ *  @param random
+ *    Random number in `[0, 1)`.
+ *
+ *  @return
+ *    Delay in milliseconds.
+ */
+inline long long RetryDelay(
+    int attempt,
+    long long base_delay,
+    long long max_delay,
+    double random) {
+  long long backoff = base_delay;
+  for (int i = 1; i < attempt && backoff < max_delay; ++i) {
+    backoff *= 2;
+  }
+  if (backoff > max_delay) {
+    backoff = max_delay;
+  }
+  return backoff / 2 + static_cast<long long>(random * (backoff - backoff / 2));
+}
+
+/**
+ *  Delay that a server asks for in a `Retry-After` header.
+ *
+ *  @param retry_after
+ *    Value of the `Retry-After` header.
+ *
+ *  @return
+ *    Delay in milliseconds, or `-1` if the value is not a number of seconds.
+ *    HTTP dates are not supported.
+ */
+inline long long RetryAfterDelay(const std::string &retry_after) {
+  const std::size_t first = retry_after.find_first_not_of(" \t");
+  const std::size_t last = retry_after.find_last_not_of(" \t");
+  if (first == std::string::npos ||
+      retry_after.find_first_not_of("0123456789", first) <= last ||
+      last - first > 8) {
+    return -1;
+  }
+  return std::atoll(retry_after.c_str() + first) * 1000;
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,448 @@
+#ifndef XBELMARK_HTML_TITLE_SCANNER_H
+#define XBELMARK_HTML_TITLE_SCANNER_H
+
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define XBELMARK_HTML_TITLE_SCANNER_SSE2
+#endif
+
+#include "xbelmark/html/charset.h"
+#include "xbelmark/html/content_type.h"
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Pointer to the first byte in a range that is equal to a byte.
+ *
+ *  Sixteen bytes are compared at a time if SSE2 is available.
+ *
+ *  @return
+ *    Pointer to the first matching byte, or `last` if there is none.
+ */
+inline const char *Find(const char *first, const char *last, char c) {
+#ifdef XBELMARK_HTML_TITLE_SCANNER_SSE2
+  const __m128i c_vec = _mm_set1_epi8(c);
+  while (last - first >= 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, c_vec));
+    if (mask != 0) {
+      int offset = 0;
+      while ((mask & (1 << offset)) == 0) {
+        ++offset;
+      }
+      return first + offset;
+    }
+    first += 16;
+  }
+#endif
+  for (; first != last; ++first) {
+    if (*first == c) {
+      return first;
+    }
+  }
+  return last;
+}
+
+/**
+ *  Pointer to the first byte in a range that is equal to any of three bytes.
+ *
+ *  Sixteen bytes are compared at a time if SSE2 is available.
+ *
+ *  @return
+ *    Pointer to the first matching byte, or `last` if there is none.
+ */
+inline const char *FindAnyOf(
+    const char *first,
+    const char *last,
+    char a,
+    char b,
+    char c) {
+#ifdef XBELMARK_HTML_TITLE_SCANNER_SSE2
+  const __m128i a_vec = _mm_set1_epi8(a);
+  const __m128i b_vec = _mm_set1_epi8(b);
+  const __m128i c_vec = _mm_set1_epi8(c);
+  while (last - first >= 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+    const int mask = _mm_movemask_epi8(
+        _mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi8(block, a_vec), _mm_cmpeq_epi8(block, b_vec)),
+            _mm_cmpeq_epi8(block, c_vec)));
+    if (mask != 0) {
+      int offset = 0;
+      while ((mask & (1 << offset)) == 0) {
+        ++offset;
+      }
+      return first + offset;
+    }
+    first += 16;
+  }
+#endif
+  for (; first != last; ++first) {
+    if (*first == a || *first == b || *first == c) {
+      return first;
+    }
+  }
+  return last;
+}
+
+/**
+ *  Whether a range begins with a string, ignoring ASCII case.
+ *
+ *  @param lower
+ *    String in lowercase.
+ */
+inline bool StartsWithIgnoreCase(
+    const char *first,
+    const char *last,
+    const char *lower) {
+  for (; *lower != '\0'; ++first, ++lower) {
+    if (first == last ||
+        std::tolower(static_cast<unsigned char>(*first)) != *lower) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ *  Scanner of the title of an HTML document in UTF-8 that does not build a
+ *  parse tree.
+ *
+ *  Text between tags is skipped with @link Find @endlink. Comments, and
+ *  the contents of `script` and `style` elements, are skipped. Character
+ *  references in the title are decoded. Anything that the scanner does not
+ *  handle in the same way as an HTML parser, such as a named character
+ *  reference other than the most common ones, makes it give up so that the
+ *  HTML document can be parsed by an HTML parser instead.
+ *
+ *  The HTML document can be scanned as it is being downloaded, where scanning
+ *  resumes from where it stopped.
+ */
+class TitleScanner final {
+ public:
+  /**
+   *  Result of a scan.
+   */
+  enum class Status : int {
+    /**
+     *  Title has been read.
+     */
+    FOUND,
+
+    /**
+     *  More of the HTML document is needed.
+     */
+    INCOMPLETE,
+
+    /**
+     *  HTML document is to be parsed by an HTML parser, since there is no
+     *  title or the scanner cannot handle it.
+     */
+    FALLBACK
+  };
+
+  /**
+   *  Scan the HTML document for the title.
+   *
+   *  @param data
+   *    HTML document that has been downloaded so far. It must begin with the
+   *    data of the previous scan.
+   *
+   *  @param size
+   *    Number of bytes in `data`.
+   *
+   *  @param is_complete
+   *    Whether no more of the HTML document will be downloaded.
+   *
+   *  @return
+   *    Result of the scan.
+   */
+  Status Scan(const char *data, std::size_t size, bool is_complete) {
+    const char *last = data + size;
+    const Status incomplete =
+        is_complete ? Status::FALLBACK : Status::INCOMPLETE;
+    while (true) {
+      const char *it = Find(data + pos_, last, '<');
+      if (it == last) {
+        pos_ = size;
+        return incomplete;
+      }
+      pos_ = it - data;
+      if (last - it < 9) {
+        // Not enough to tell the kind of tag.
+        return incomplete;
+      }
+      const char *end = nullptr;
+      if (StartsWithIgnoreCase(it, last, "<!--")) {
+        end = FindIgnoreCase(it + 4, last, "-->");
+        if (end != last) {
+          end += 3;
+        }
+      } else if (IsTag(it, last, "title")) {
+        return ReadTitle(it, last, incomplete);
+      } else if (IsTag(it, last, "script")) {
+        end = SkipElement(it, last, "</script");
+      } else if (IsTag(it, last, "style")) {
+        end = SkipElement(it, last, "</style");
+      } else if (std::isalpha(static_cast<unsigned char>(it[1])) ||
+                 it[1] == '/' || it[1] == '!' || it[1] == '?') {
+        end = SkipTag(it, last);
+      } else {
+        end = it + 1;
+      }
+      if (end == last) {
+        return incomplete;
+      }
+      pos_ = end - data;
+    }
+  }
+
+  /**
+   *  Title in UTF-8 if the last scan has found it.
+   */
+  const std::string &title() const {
+    return title_;
+  }
+
+ private:
+  /**
+   *  Pointer to the first occurrence of a string in a range, ignoring ASCII
+   *  case.
+   *
+   *  @param lower
+   *    String in lowercase that begins with a character that is not a
+   *    letter.
+   *
+   *  @return
+   *    Pointer to the occurrence, or `last` if there is none.
+   */
+  static const char *FindIgnoreCase(
+      const char *first,
+      const char *last,
+      const char *lower) {
+    while ((first = Find(first, last, lower[0])) != last) {
+      if (static_cast<std::size_t>(last - first) < std::strlen(lower)) {
+        return last;
+      }
+      if (StartsWithIgnoreCase(first, last, lower)) {
+        return first;
+      }
+      ++first;
+    }
+    return last;
+  }
+
+  /**
+   *  Whether a tag is a start tag of an element.
+   *
+   *  @param it
+   *    Pointer to the `<` of the tag.
+   *
+   *  @param name
+   *    Name of the element in lowercase.
+   */
+  static bool IsTag(const char *it, const char *last, const char *name) {
+    const std::size_t len = std::strlen(name);
+    if (static_cast<std::size_t>(last - it) < len + 2 ||
+        !StartsWithIgnoreCase(it + 1, last, name)) {
+      return false;
+    }
+    const char next = it[len + 1];
+    return next == '>' || next == '/' ||
+        std::isspace(static_cast<unsigned char>(next));
+  }
+
+  /**
+   *  Pointer past the end of a tag, where `>` in quoted attribute values are
+   *  not the end.
+   *
+   *  @return
+   *    Pointer past the `>` that ends the tag, or `last` if it is not found.
+   */
+  static const char *SkipTag(const char *it, const char *last) {
+    char quote = '\0';
+    while ((it = FindAnyOf(it + 1, last, '>', '"', '\'')) != last) {
+      if (quote == '\0') {
+        if (*it == '>') {
+          return it + 1;
+        }
+        // A quote only begins an attribute value after `=`.
+        const char *prev = it - 1;
+        while (std::isspace(static_cast<unsigned char>(*prev))) {
+          --prev;
+        }
+        if (*prev == '=') {
+          quote = *it;
+        }
+      } else if (*it == quote) {
+        quote = '\0';
+      }
+    }
+    return last;
+  }
+
+  /**
+   *  Pointer past the end of an element whose content is not markup.
+   *
+   *  @param end_tag
+   *    Beginning of the end tag in lowercase.
+   *
+   *  @return
+   *    Pointer past the end tag, or `last` if it is not found.
+   */
+  static const char *SkipElement(
+      const char *it,
+      const char *last,
+      const char *end_tag) {
+    it = SkipTag(it, last);
+    if (it == last) {
+      return last;
+    }
+    const std::size_t len = std::strlen(end_tag);
+    while ((it = FindIgnoreCase(it, last, end_tag)) != last) {
+      if (static_cast<std::size_t>(last - it) <= len) {
+        return last;
+      }
+      const char next = it[len];
+      if (next == '>' || next == '/' ||
+          std::isspace(static_cast<unsigned char>(next))) {
+        return SkipTag(it, last);
+      }
+      it += len;
+    }
+    return last;
+  }
+
+  /**
+   *  Read the content of the `title` element.
+   *
+   *  @param it
+   *    Pointer to the `<` of the start tag.
+   *
+   *  @param incomplete
+   *    Status if the end tag is not found.
+   */
+  Status ReadTitle(const char *it, const char *last, Status incomplete) {
+    const char *first = SkipTag(it, last);
+    if (first == last) {
+      return incomplete;
+    }
+    const char *end = first;
+    while (true) {
+      end = FindIgnoreCase(end, last, "</title");
+      if (end == last || last - end < 8) {
+        return incomplete;
+      }
+      const char next = end[7];
+      if (next == '>' || next == '/' ||
+          std::isspace(static_cast<unsigned char>(next))) {
+        break;
+      }
+      end += 7;
+    }
+    title_.clear();
+    while (first != end) {
+      const char *amp = Find(first, end, '&');
+      title_.append(first, amp);
+      if (amp == end) {
+        break;
+      }
+      if (!DecodeReference(amp, end, first)) {
+        return Status::FALLBACK;
+      }
+    }
+    return IsValidUtf8(title_.data(), title_.size()) ?
+        Status::FOUND : Status::FALLBACK;
+  }
+
+  /**
+   *  Decode a character reference into the title.
+   *
+   *  @param it
+   *    Pointer to the `&` of the character reference.
+   *
+   *  @param next
+   *    Pointer past the character reference, which is set if it is decoded.
+   *
+   *  @return
+   *    Whether the character reference is decoded.
+   */
+  bool DecodeReference(const char *it, const char *last, const char *&next) {
+    const char *semicolon = it + 1;
+    while (semicolon != last && semicolon - it <= 10 &&
+           (std::isalnum(static_cast<unsigned char>(*semicolon)) ||
+            *semicolon == '#')) {
+      ++semicolon;
+    }
+    if (semicolon == it + 1) {
+      // Lone ampersand.
+      title_ += '&';
+      next = it + 1;
+      return true;
+    }
+    if (semicolon == last || *semicolon != ';') {
+      return false;
+    }
+    const std::string name(it + 1, semicolon);
+    unsigned long code_point = 0;
+    if (name[0] == '#') {
+      const bool is_hex = name.size() > 1 && (name[1] == 'x' || name[1] == 'X');
+      const std::string digits(name.substr(is_hex ? 2 : 1));
+      if (digits.empty()) {
+        return false;
+      }
+      for (char ch : digits) {
+        if (is_hex ? !std::isxdigit(static_cast<unsigned char>(ch)) :
+            !std::isdigit(static_cast<unsigned char>(ch))) {
+          return false;
+        }
+      }
+      code_point = std::stoul(digits, nullptr, is_hex ? 16 : 10);
+      if (code_point == 0 || code_point > 0x10FFFF ||
+          (code_point >= 0xD800 && code_point <= 0xDFFF) ||
+          (code_point >= 0x80 && code_point <= 0x9F)) {
+        // Replaced or remapped by HTML parsers.
+        return false;
+      }
+    } else if (name == "amp") {
+      code_point = '&';
+    } else if (name == "lt") {
+      code_point = '<';
+    } else if (name == "gt") {
+      code_point = '>';
+    } else if (name == "quot") {
+      code_point = '"';
+    } else if (name == "apos") {
+      code_point = '\'';
+    } else if (name == "nbsp") {
+      code_point = 0xA0;
+    } else {
+      return false;
+    }
+    AppendUtf8(title_, code_point);
+    next = semicolon + 1;
+    return true;
+  }
+
+  /**
+   *  Offset in the HTML document from which scanning resumes.
+   */
+  std::size_t pos_ = 0;
+
+  std::string title_;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
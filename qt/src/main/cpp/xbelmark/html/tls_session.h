@@ -0,0 +1,147 @@
+#ifndef XBELMARK_HTML_TLS_SESSION_H
+#define XBELMARK_HTML_TLS_SESSION_H
+
+#include <string>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Maximum age in seconds of a persisted TLS session, which bounds the
+ *  lifetime hints of servers.
+ *
+ *  It is the limit of TLS 1.3 on the lifetime of a session ticket.
+ */
+constexpr long long kMaxTlsSessionAge = 7 * 24 * 60 * 60;
+
+/**
+ *  Lifetime in seconds of a TLS session that is assumed if the server does
+ *  not hint one.
+ */
+constexpr long long kDefaultTlsSessionLifetime = 2 * 60 * 60;
+
+/**
+ *  TLS session with a server that is persisted.
+ */
+struct TlsSession {
+ public:
+  /**
+   *  Key of the server as in @link TlsSessionKey @endlink.
+   */
+  std::string key;
+
+  /**
+   *  Session ticket in Base64.
+   */
+  std::string ticket;
+
+  /**
+   *  Lifetime in seconds that the server hinted for the session ticket, or a
+   *  nonpositive number if there was no hint.
+   */
+  long long lifetime_hint = 0;
+
+  /**
+   *  When the session was stored, in seconds since epoch.
+   */
+  long long stored_at = 0;
+};
+
+/**
+ *  Key of the TLS sessions with a server.
+ *
+ *  @param host
+ *    Host name of the server, which is compared without regard to case.
+ *
+ *  @param port
+ *    Port of the server.
+ *
+ *  @return
+ *    Host name in lowercase and port, such as `example.com:443`.
+ */
+inline std::string TlsSessionKey(const std::string &host, int port) {
+  std::string retval(host);
+  for (char &ch : retval) {
+    if (ch >= 'A' && ch <= 'Z') {
+      ch = static_cast<char>(ch - 'A' + 'a');
+    }
+  }
+  return retval + ":" + std::to_string(port);
+}
+
+/**
+ *  Whether a persisted TLS session is still worth resuming.
+ *
+ *  @param stored_at
+ *    When the session was stored, in seconds since epoch.
+ *
+ *  @param lifetime_hint
+ *    Lifetime in seconds that the server hinted for the session ticket, or a
+ *    nonpositive number if there was no hint.
+ *
+ *  @param now
+ *    Current time in seconds since epoch.
+ */
+inline bool IsTlsSessionFresh(
+    long long stored_at,
+    long long lifetime_hint,
+    long long now) {
+  long long lifetime =
+      lifetime_hint > 0 ? lifetime_hint : kDefaultTlsSessionLifetime;
+  if (lifetime > kMaxTlsSessionAge) {
+    lifetime = kMaxTlsSessionAge;
+  }
+  // A clock that went backward makes the age unknown.
+  return now >= stored_at && now - stored_at < lifetime;
+}
+
+/**
+ *  Whether the session ticket of a connection that has finished is to be
+ *  stored, which is the case if there is one and it is not the one that was
+ *  resumed.
+ *
+ *  @param ticket
+ *    Session ticket of the connection, or an empty string if there is none.
+ *
+ *  @param resumed_ticket
+ *    Session ticket that the connection was to resume, or an empty string if
+ *    there was none.
+ */
+inline bool IsNewTlsSession(
+    const std::string &ticket,
+    const std::string &resumed_ticket) {
+  return !ticket.empty() && ticket != resumed_ticket;
+}
+
+/**
+ *  Session ticket of a stored session to resume with a server.
+ *
+ *  @param session
+ *    Session that is stored for the server.
+ *
+ *  @param key
+ *    Key of the server, which must match that of the session to guard
+ *    against a corrupted session or a hash collision.
+ *
+ *  @param now
+ *    Current time in seconds since epoch.
+ *
+ *  @return
+ *    Session ticket in Base64, or an empty string if the session is not to be
+ *    resumed.
+ */
+inline std::string ResumableTlsTicket(
+    const TlsSession &session,
+    const std::string &key,
+    long long now) {
+  if (session.key != key ||
+      !IsTlsSessionFresh(session.stored_at, session.lifetime_hint, now)) {
+    return "";
+  }
+  return session.ticket;
+}
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,133 @@
+#include "xbelmark/html/tls_session_store.h"
+
+#include <string>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileDevice>
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QSaveFile>
+#include <QSsl>
+#include <QSslConfiguration>
+#include <QString>
+#include <QUrl>
+
+#include "xbelmark/html/tls_session.h"
+
+namespace xbelmark {
+namespace html {
+
+class TlsSessionStore::Impl final {
+ public:
+  /**
+   *  Key of the TLS sessions with the server of a URL.
+   */
+  static std::string KeyOf(const QUrl &url) {
+    return TlsSessionKey(url.host().toStdString(), url.port(443));
+  }
+
+  /**
+   *  Path to the file of the session with a server.
+   */
+  static QString SessionPath(const QDir &dir, const std::string &key) {
+    const QByteArray digest(
+        QCryptographicHash::hash(
+            QByteArray(key.data(), key.size()), QCryptographicHash::Sha1));
+    return dir.filePath(QString::fromLatin1(digest.toHex()) + ".json");
+  }
+
+  /**
+   *  Store the session of a reply that has finished, unless it is the one
+   *  that was resumed.
+   */
+  static void Save(const QDir &dir, QNetworkReply *reply) {
+    const QSslConfiguration conf(reply->sslConfiguration());
+    const QByteArray ticket(conf.sessionTicket());
+    if (!IsNewTlsSession(
+            ticket.toStdString(),
+            reply->request().sslConfiguration().sessionTicket()
+                .toStdString())) {
+      return;
+    }
+    const std::string key(KeyOf(reply->url()));
+    QJsonObject obj;
+    obj.insert("key", QString::fromStdString(key));
+    obj.insert("ticket", QString::fromLatin1(ticket.toBase64()));
+    obj.insert(
+        "lifetime_hint",
+        static_cast<qint64>(conf.sessionTicketLifeTimeHint()));
+    obj.insert(
+        "stored_at",
+        static_cast<qint64>(QDateTime::currentSecsSinceEpoch()));
+    // Failing to store is not an error.
+    QSaveFile file(SessionPath(dir, key));
+    if (!file.open(QIODevice::WriteOnly)) {
+      return;
+    }
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    file.commit();
+  }
+
+  QDir dir_;
+};
+
+TlsSessionStore::TlsSessionStore(
+    const std::string &dir_path) : p_impl_(new Impl()) {
+  p_impl_->dir_ = QDir(QString::fromStdString(dir_path));
+  if (!p_impl_->dir_.exists()) {
+    p_impl_->dir_.mkpath(".");
+    QFile::setPermissions(
+        p_impl_->dir_.path(),
+        QFileDevice::ReadOwner | QFileDevice::WriteOwner |
+            QFileDevice::ExeOwner);
+  }
+}
+
+TlsSessionStore::~TlsSessionStore() = default;
+
+void TlsSessionStore::Apply(QNetworkRequest &request) const {
+  if (request.url().scheme() != "https") {
+    return;
+  }
+  QSslConfiguration conf(request.sslConfiguration());
+  // Sessions are not kept for resumption by default.
+  conf.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+  const std::string key(Impl::KeyOf(request.url()));
+  QFile file(Impl::SessionPath(p_impl_->dir_, key));
+  if (file.open(QIODevice::ReadOnly)) {
+    const QJsonObject obj(QJsonDocument::fromJson(file.readAll()).object());
+    TlsSession session;
+    session.key = obj.value("key").toString().toStdString();
+    session.ticket = obj.value("ticket").toString().toStdString();
+    session.lifetime_hint = obj.value("lifetime_hint").toInteger();
+    session.stored_at = obj.value("stored_at").toInteger();
+    const std::string ticket(
+        ResumableTlsTicket(
+            session, key, QDateTime::currentSecsSinceEpoch()));
+    if (!ticket.empty()) {
+      conf.setSessionTicket(
+          QByteArray::fromBase64(
+              QByteArray(ticket.data(), static_cast<int>(ticket.size()))));
+    }
+  }
+  request.setSslConfiguration(conf);
+}
+
+void TlsSessionStore::Watch(QNetworkReply *reply) const {
+  const QDir dir(p_impl_->dir_);
+  QObject::connect(
+      reply, &QNetworkReply::finished,
+      reply, [dir, reply]() -> void {
+        Impl::Save(dir, reply);
+      });
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,61 @@
+#ifndef XBELMARK_HTML_TLS_SESSION_STORE_H
+#define XBELMARK_HTML_TLS_SESSION_STORE_H
+
+#include <memory>
+#include <string>
+
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  Persistent store of TLS session tickets by server, so that a short-lived
+ *  process resumes the TLS sessions of earlier ones instead of doing a full
+ *  handshake.
+ *
+ *  Each session is a JSON file in the store directory, named after the hash
+ *  of the host and port, and readable only by the user since a ticket grants
+ *  resumption of the session. Files are written atomically, so the store can
+ *  be shared by concurrent processes. Resumption takes effect only with a TLS
+ *  backend of Qt that supports session tickets, such as OpenSSL.
+ */
+class TlsSessionStore final {
+ public:
+  /**
+   *  @param dir_path
+   *    Path to the store directory. It is created if it does not exist.
+   */
+  explicit TlsSessionStore(const std::string &dir_path);
+
+  ~TlsSessionStore();
+
+  /**
+   *  Prepare an HTTPS request to resume the stored session with its server,
+   *  if there is a fresh one, and to keep the session that it establishes.
+   *
+   *  @param request
+   *    Request that is modified. Requests of other schemes are unchanged.
+   */
+  void Apply(QNetworkRequest &request) const;
+
+  /**
+   *  Store the session of a reply once it has finished.
+   *
+   *  @param reply
+   *    Reply to a request that was prepared by @link Apply @endlink. The store
+   *    need not outlive it.
+   */
+  void Watch(QNetworkReply *reply) const;
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+} // namespace html
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef XBELMARK_JOURNAL_FRAME_H
+#define XBELMARK_JOURNAL_FRAME_H
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace xbelmark {
+namespace journal {
+
+/**
+ *  CRC-32 (IEEE 802.3) of a byte sequence.
+ *
+ *  @param data
+ *    Byte sequence.
+ *
+ *  @param size
+ *    Number of bytes in `data`.
+ */
+inline std::uint32_t Crc32(const char *data, std::size_t size) {
+  static const struct Table {
+    Table() {
+      for (std::uint32_t i = 0; i != 256; ++i) {
+        std::uint32_t value = i;
+        for (int j = 0; j != 8; ++j) {
+          value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+        }
+        entries[i] = value;
+      }
+    }
+
+    std::uint32_t entries[256];
+  } table;
+  std::uint32_t retval = 0xFFFFFFFFu;
+  for (std::size_t i = 0; i != size; ++i) {
+    retval = table.entries[(retval ^ static_cast<unsigned char>(data[i])) &
+                           0xFF] ^ (retval >> 8);
+  }
+  return retval ^ 0xFFFFFFFFu;
+}
+
+/**
+ *  Line of a journal that holds a record.
+ *
+ *  The line is the CRC-32 of the record as eight lowercase hexadecimal
+ *  digits, a space, the record, and LF. A line that was only partially
+ *  written, or that was interleaved with another line, fails the checksum.
+ *
+ *  @param payload
+ *    Record, which must not contain LF.
+ */
+inline std::string FrameRecord(const std::string &payload) {
+  static const char kDigits[] = "0123456789abcdef";
+  const std::uint32_t crc = Crc32(payload.data(), payload.size());
+  std::string retval(8, '0');
+  for (int i = 0; i != 8; ++i) {
+    retval[7 - i] = kDigits[(crc >> (4 * i)) & 0xF];
+  }
+  retval += ' ';
+  retval += payload;
+  retval += '\n';
+  return retval;
+}
+
+/**
+ *  Record in a line of a journal.
+ *
+ *  @param line
+ *    Line without LF.
+ *
+ *  @param payload
+ *    Record, which is set if the line is intact.
+ *
+ *  @return
+ *    Whether the line is intact.
+ */
+inline bool UnframeRecord(const std::string &line, std::string &payload) {
+  if (line.size() < 9 || line[8] != ' ') {
+    return false;
+  }
+  std::uint32_t crc = 0;
+  for (int i = 0; i != 8; ++i) {
+    const char ch = line[i];
+    if (!std::isxdigit(static_cast<unsigned char>(ch))) {
+      return false;
+    }
+    crc = (crc << 4) |
+        static_cast<std::uint32_t>(
+            std::isdigit(static_cast<unsigned char>(ch)) ?
+                ch - '0' :
+                std::tolower(static_cast<unsigned char>(ch)) - 'a' + 10);
+  }
+  if (Crc32(line.data() + 9, line.size() - 9) != crc) {
+    return false;
+  }
+  payload = line.substr(9);
+  return true;
+}
+
+} // namespace journal
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,393 @@
+#include "xbelmark/journal/journal.h"
+
+#include <cerrno>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QString>
+#include <QStringList>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include "xbelmark/journal/frame.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+/**
+ *  Time in milliseconds to wait for another compaction of the same XBEL
+ *  document.
+ */
+#define LOCK_TIMEOUT_MILLISECONDS 30000
+
+namespace xbelmark {
+namespace journal {
+
+/**
+ *  Line of a journal that holds a record.
+ */
+std::string EncodeRecord(const Record &record) {
+  QJsonObject obj;
+  obj.insert("href", QString::fromStdString(record.href));
+  obj.insert("title", QString::fromStdString(record.title));
+  if (!record.description.empty()) {
+    obj.insert("desc", QString::fromStdString(record.description));
+  }
+  obj.insert("added", QString::fromStdString(record.added));
+  if (!record.icon.empty()) {
+    obj.insert("icon", QString::fromStdString(record.icon));
+  }
+  // Compact JSON escapes line breaks, so the record is one line.
+  return FrameRecord(
+      QJsonDocument(obj).toJson(QJsonDocument::Compact).toStdString());
+}
+
+/**
+ *  Record in a line of a journal.
+ *
+ *  @return
+ *    Whether the line is intact.
+ */
+bool DecodeRecord(const std::string &line, Record &record) {
+  std::string payload;
+  if (!UnframeRecord(line, payload)) {
+    return false;
+  }
+  const QJsonObject obj(
+      QJsonDocument::fromJson(
+          QByteArray(payload.data(), payload.size())).object());
+  record.href = obj.value("href").toString().toStdString();
+  record.title = obj.value("title").toString().toStdString();
+  record.description = obj.value("desc").toString().toStdString();
+  record.added = obj.value("added").toString().toStdString();
+  record.icon = obj.value("icon").toString().toStdString();
+  return !record.href.empty();
+}
+
+/**
+ *  Records in the lines of a journal.
+ *
+ *  @param records
+ *    Records that the intact lines are appended to.
+ *
+ *  @return
+ *    Number of lines that were torn or corrupted.
+ */
+std::size_t DecodeRecords(
+    const QByteArray &journal_data,
+    std::vector<Record> &records) {
+  std::size_t retval = 0;
+  const char *it = journal_data.constData();
+  const char *last = it + journal_data.size();
+  while (it != last) {
+    const char *line_end = static_cast<const char *>(
+        std::memchr(it, '\n', last - it));
+    if (!line_end) {
+      line_end = last;
+    }
+    Record record;
+    if (DecodeRecord(std::string(it, line_end), record)) {
+      records.push_back(record);
+    } else {
+      ++retval;
+    }
+    it = line_end == last ? last : line_end + 1;
+  }
+  return retval;
+}
+
+/**
+ *  Lock on the file next to a journal that appends share, and that a
+ *  compaction takes exclusively while it renames the journal.
+ *
+ *  Once a compaction has the lock, every append that opened the journal
+ *  before it was renamed has finished, and every later append opens the new
+ *  journal.
+ */
+class RenameLock final {
+ public:
+  /**
+   *  Wait for the lock.
+   *
+   *  @param journal_path
+   *    Path to the journal.
+   *
+   *  @param is_exclusive
+   *    Whether the lock is taken exclusively.
+   *
+   *  @throw std::runtime_error
+   *    Lock file cannot be opened or locked.
+   */
+  RenameLock(const std::string &journal_path, bool is_exclusive) {
+    const std::string lock_path(journal_path + ".lock");
+#ifdef WIN32
+    file_ = CreateFileW(
+        QString::fromStdString(lock_path).toStdWString().c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    OVERLAPPED overlapped = {};
+    if (file_ == INVALID_HANDLE_VALUE ||
+        !LockFileEx(
+            file_, is_exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, 1, 0,
+            &overlapped)) {
+      if (file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_);
+      }
+      throw std::runtime_error("Cannot lock the journal at\n" + journal_path);
+    }
+#else
+    fd_ = open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    int status = -1;
+    if (fd_ != -1) {
+      do {
+        status = flock(fd_, is_exclusive ? LOCK_EX : LOCK_SH);
+      } while (status == -1 && errno == EINTR);
+    }
+    if (status == -1) {
+      if (fd_ != -1) {
+        close(fd_);
+      }
+      throw std::runtime_error("Cannot lock the journal at\n" + journal_path);
+    }
+#endif
+  }
+
+  RenameLock(const RenameLock &) = delete;
+
+  RenameLock &operator=(const RenameLock &) = delete;
+
+  /**
+   *  Release the lock.
+   */
+  ~RenameLock() {
+#ifdef WIN32
+    OVERLAPPED overlapped = {};
+    UnlockFileEx(file_, 0, 1, 0, &overlapped);
+    CloseHandle(file_);
+#else
+    close(fd_);
+#endif
+  }
+
+ private:
+#ifdef WIN32
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+#else
+  int fd_ = -1;
+#endif
+};
+
+void Append(const std::string &journal_path, const Record &record) {
+  const std::string line(EncodeRecord(record));
+  const RenameLock rename_lock(journal_path, false);
+#ifdef WIN32
+  // Writes with only `FILE_APPEND_DATA` access are atomic appends.
+  HANDLE file = CreateFileW(
+      QString::fromStdString(journal_path).toStdWString().c_str(),
+      FILE_APPEND_DATA,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      nullptr,
+      OPEN_ALWAYS,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot open the journal at\n" + journal_path);
+  }
+  DWORD num_bytes = 0;
+  const BOOL is_written = WriteFile(
+      file,
+      line.data(),
+      static_cast<DWORD>(line.size()),
+      &num_bytes,
+      nullptr);
+  CloseHandle(file);
+  if (!is_written || num_bytes != line.size()) {
+    throw std::runtime_error(
+        "Cannot append to the journal at\n" + journal_path);
+  }
+#else
+  const int fd = open(
+      journal_path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666);
+  if (fd == -1) {
+    throw std::runtime_error("Cannot open the journal at\n" + journal_path);
+  }
+  const ssize_t num_bytes = write(fd, line.data(), line.size());
+  close(fd);
+  if (num_bytes != static_cast<ssize_t>(line.size())) {
+    throw std::runtime_error(
+        "Cannot append to the journal at\n" + journal_path);
+  }
+#endif
+}
+
+/**
+ *  Value of an attribute of an element, or an empty string if it is not set.
+ */
+std::string AttributeValue(xmlNodePtr node, const char *name) {
+  xmlChar *value =
+      xmlGetProp(node, reinterpret_cast<const xmlChar *>(name));
+  if (!value) {
+    return "";
+  }
+  std::string retval(reinterpret_cast<const char *>(value));
+  xmlFree(value);
+  return retval;
+}
+
+/**
+ *  Append a child element with text content.
+ */
+void AppendTextChild(
+    xmlNodePtr parent,
+    const char *name,
+    const std::string &content) {
+  xmlNodePtr child = xmlNewChild(
+      parent, nullptr, reinterpret_cast<const xmlChar *>(name), nullptr);
+  xmlNodeAddContent(child, reinterpret_cast<const xmlChar *>(content.c_str()));
+}
+
+std::vector<Record> PendingRecords(const std::string &journal_path) {
+  std::vector<Record> retval;
+  const QString journal_file_path(QString::fromStdString(journal_path));
+  // A journal left by an interrupted compaction precedes the current one.
+  for (const QString &path :
+       QStringList({ journal_file_path + ".compacting", journal_file_path })) {
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly)) {
+      DecodeRecords(file.readAll(), retval);
+    }
+  }
+  return retval;
+}
+
+CompactResult Compact(
+    const std::string &journal_path,
+    const std::string &xbel_path) {
+  const QString journal_file_path(QString::fromStdString(journal_path));
+  const QString xbel_file_path(QString::fromStdString(xbel_path));
+  QLockFile lock_file(xbel_file_path + ".lock");
+  if (!lock_file.tryLock(LOCK_TIMEOUT_MILLISECONDS)) {
+    throw std::runtime_error("Cannot lock the XBEL document at\n" + xbel_path);
+  }
+  CompactResult retval;
+  // A journal left by an interrupted compaction is compacted first, and the
+  // current journal is left for the next compaction.
+  const QString pending_path(journal_file_path + ".compacting");
+  if (!QFile::exists(pending_path)) {
+    const RenameLock rename_lock(journal_path, true);
+    if (!QFile::exists(journal_file_path)) {
+      return retval;
+    }
+    if (!QFile::rename(journal_file_path, pending_path)) {
+      throw std::runtime_error("Cannot rename the journal at\n" + journal_path);
+    }
+  }
+  QFile pending_file(pending_path);
+  if (!pending_file.open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Cannot read the journal at\n" + journal_path);
+  }
+  const QByteArray journal_data(pending_file.readAll());
+  pending_file.close();
+  // Read or create the XBEL document.
+  xmlDocPtr doc = nullptr;
+  if (QFile::exists(xbel_file_path)) {
+    doc = xmlReadFile(xbel_path.c_str(), nullptr, XML_PARSE_NOBLANKS);
+    if (!doc || !xmlDocGetRootElement(doc)) {
+      xmlFreeDoc(doc);
+      throw std::runtime_error(
+          "Cannot parse the XBEL document at\n" + xbel_path);
+    }
+  } else {
+    doc = xmlNewDoc(reinterpret_cast<const xmlChar *>("1.0"));
+    xmlNodePtr root = xmlNewNode(
+        nullptr, reinterpret_cast<const xmlChar *>("xbel"));
+    xmlNewProp(
+        root,
+        reinterpret_cast<const xmlChar *>("version"),
+        reinterpret_cast<const xmlChar *>("1.0"));
+    xmlDocSetRootElement(doc, root);
+  }
+  xmlNodePtr root = xmlDocGetRootElement(doc);
+  std::set<std::pair<std::string, std::string>> existing;
+  for (xmlNodePtr node = root->children; node; node = node->next) {
+    if (node->type == XML_ELEMENT_NODE &&
+        std::strcmp(reinterpret_cast<const char *>(node->name), "bookmark") ==
+            0) {
+      existing.emplace(
+          AttributeValue(node, "href"), AttributeValue(node, "added"));
+    }
+  }
+  // Append the bookmarks in the order that they were recorded.
+  std::vector<Record> records;
+  retval.num_corrupted = DecodeRecords(journal_data, records);
+  for (const Record &record : records) {
+    if (!existing.emplace(record.href, record.added).second) {
+      ++retval.num_duplicates;
+    } else {
+      xmlNodePtr bookmark = xmlNewChild(
+          root, nullptr, reinterpret_cast<const xmlChar *>("bookmark"),
+          nullptr);
+      xmlNewProp(
+          bookmark,
+          reinterpret_cast<const xmlChar *>("href"),
+          reinterpret_cast<const xmlChar *>(record.href.c_str()));
+      if (!record.added.empty()) {
+        xmlNewProp(
+            bookmark,
+            reinterpret_cast<const xmlChar *>("added"),
+            reinterpret_cast<const xmlChar *>(record.added.c_str()));
+      }
+      if (!record.icon.empty()) {
+        xmlNewProp(
+            bookmark,
+            reinterpret_cast<const xmlChar *>("icon"),
+            reinterpret_cast<const xmlChar *>(record.icon.c_str()));
+      }
+      AppendTextChild(bookmark, "title", record.title);
+      if (!record.description.empty()) {
+        AppendTextChild(bookmark, "desc", record.description);
+      }
+      ++retval.num_added;
+    }
+  }
+  // Replace the XBEL document atomically.
+  xmlChar *xbel_data = nullptr;
+  int xbel_size = 0;
+  xmlDocDumpFormatMemoryEnc(doc, &xbel_data, &xbel_size, "UTF-8", 1);
+  xmlFreeDoc(doc);
+  QSaveFile xbel_file(xbel_file_path);
+  bool is_saved = xbel_data && xbel_file.open(QIODevice::WriteOnly);
+  if (is_saved) {
+    xbel_file.write(reinterpret_cast<const char *>(xbel_data), xbel_size);
+    is_saved = xbel_file.commit();
+  }
+  xmlFree(xbel_data);
+  if (!is_saved) {
+    throw std::runtime_error("Cannot write the XBEL document at\n" + xbel_path);
+  }
+  QFile::remove(pending_path);
+  return retval;
+}
+
+} // namespace journal
+} // namespace xbelmark
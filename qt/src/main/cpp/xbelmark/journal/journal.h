@@ -0,0 +1,124 @@
+#ifndef XBELMARK_JOURNAL_JOURNAL_H
+#define XBELMARK_JOURNAL_JOURNAL_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace xbelmark {
+namespace journal {
+
+/**
+ *  Bookmark that is recorded in a journal.
+ */
+struct Record {
+ public:
+  /**
+   *  URI that the bookmark specifies.
+   */
+  std::string href;
+
+  /**
+   *  Title in UTF-8.
+   */
+  std::string title;
+
+  /**
+   *  Description in UTF-8, or an empty string for none.
+   */
+  std::string description;
+
+  /**
+   *  Time that the bookmark was added in the format of the `added` attribute
+   *  of XBEL.
+   */
+  std::string added;
+
+  /**
+   *  URL of the icon in the icon cache, or an empty string for none.
+   */
+  std::string icon;
+};
+
+/**
+ *  Result of compacting a journal.
+ */
+struct CompactResult {
+ public:
+  /**
+   *  Number of bookmarks added to the XBEL document.
+   */
+  std::size_t num_added = 0;
+
+  /**
+   *  Number of bookmarks that were already in the XBEL document.
+   */
+  std::size_t num_duplicates = 0;
+
+  /**
+   *  Number of lines that were torn or corrupted, and were skipped.
+   */
+  std::size_t num_corrupted = 0;
+};
+
+/**
+ *  Append a record to a journal.
+ *
+ *  The record is written by a single write to the file opened in append mode,
+ *  so many processes can append to the same journal at the same time. They
+ *  share a lock on a file next to the journal, which a compaction takes
+ *  exclusively only while it renames the journal. The journal is created if
+ *  it does not exist.
+ *
+ *  @param journal_path
+ *    Path to the journal.
+ *
+ *  @throw std::runtime_error
+ *    Record cannot be written.
+ */
+void Append(const std::string &journal_path, const Record &record);
+
+/**
+ *  Records of a journal that have not been folded into an XBEL document yet,
+ *  including those of a compaction that was interrupted.
+ *
+ *  Lines that were torn or corrupted, or that are being appended, are
+ *  skipped.
+ *
+ *  @param journal_path
+ *    Path to the journal.
+ *
+ *  @return
+ *    Records in the order that they were recorded, which is empty if the
+ *    journal does not exist.
+ */
+std::vector<Record> PendingRecords(const std::string &journal_path);
+
+/**
+ *  Fold the records of a journal into an XBEL document.
+ *
+ *  The journal is first renamed, once the appends to it have finished, so
+ *  that appends made during the compaction go to a new journal. Bookmarks
+ *  are appended to the root element of the XBEL document, which is created
+ *  if it does not exist and is replaced atomically. A bookmark with the same
+ *  `href` and `added` as one in the XBEL document is not added again, so a
+ *  compaction that is interrupted can be resumed. Compactions of the same
+ *  XBEL document are serialized by another lock file.
+ *
+ *  @param journal_path
+ *    Path to the journal.
+ *
+ *  @param xbel_path
+ *    Path to the XBEL document.
+ *
+ *  @throw std::runtime_error
+ *    Journal or XBEL document cannot be read or written.
+ */
+CompactResult Compact(
+    const std::string &journal_path,
+    const std::string &xbel_path);
+
+} // namespace journal
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef XBELMARK_PASTE_BOOKMARK_PATH_H
+#define XBELMARK_PASTE_BOOKMARK_PATH_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  File name with a number to make it distinct from a file that exists.
+ *
+ *  @param base_file_name
+ *    File name without the extension.
+ *
+ *  @param extension
+ *    Extension with the leading dot, such as `.xbel`.
+ *
+ *  @param number
+ *    Number of the attempt, where `1` is the file name without a number.
+ *
+ *  @return
+ *    File name, such as `Example (2).xbel`.
+ */
+inline std::string NumberedFileName(
+    const std::string &base_file_name,
+    const std::string &extension,
+    int number) {
+  if (number <= 1) {
+    return base_file_name + extension;
+  }
+  return base_file_name + " (" + std::to_string(number) + ")" + extension;
+}
+
+/**
+ *  Subdirectory of a bookmark file in the layout that shards by hash.
+ *
+ *  @param base_file_name
+ *    File name without the extension.
+ *
+ *  @return
+ *    Two lowercase hexadecimal digits of the FNV-1a hash of the file name,
+ *    which spread the bookmark files over 256 subdirectories.
+ */
+inline std::string HashShard(const std::string &base_file_name) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::uint32_t hash = UINT32_C(0x811C9DC5);
+  for (char ch : base_file_name) {
+    hash ^= static_cast<unsigned char>(ch);
+    hash *= UINT32_C(0x01000193);
+  }
+  // Fold the hash so that every bit affects the digits.
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return std::string({ kDigits[(hash >> 4) & 0xF], kDigits[hash & 0xF] });
+}
+
+/**
+ *  Subdirectory of a bookmark file in the layout that shards by date.
+ *
+ *  @param local_date_time
+ *    Time that the bookmark is added in the local time zone.
+ *
+ *  @return
+ *    Year and month, such as `2024/05`.
+ */
+inline std::string DateShard(const std::tm &local_date_time) {
+  char retval[16];
+  std::strftime(retval, sizeof(retval), "%Y/%m", &local_date_time);
+  return retval;
+}
+
+/**
+ *  Whether a file is in a directory tree.
+ *
+ *  @param file_path
+ *    Absolute path to the file without `.` or `..` segments, and with `/` as
+ *    the separator.
+ *
+ *  @param dir_path
+ *    Absolute path to the root of the directory tree in the same form.
+ */
+inline bool IsInDirTree(
+    const std::string &file_path,
+    const std::string &dir_path) {
+  if (dir_path.empty() || file_path.size() <= dir_path.size() ||
+      file_path.compare(0, dir_path.size(), dir_path) != 0) {
+    return false;
+  }
+  return dir_path.back() == '/' || file_path[dir_path.size()] == '/';
+}
+
+} // namespace paste
+} // namespace xbelmark
+
+#endif
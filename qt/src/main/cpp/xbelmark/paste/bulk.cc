@@ -0,0 +1,253 @@
+#include "xbelmark/paste/bulk.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+#include <QClipboard>
+#include <QDir>
+#include <QFile>
+#include <QGuiApplication>
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+#include <libxml/xmlIO.h>
+#include <libxml/xmlwriter.h>
+
+#include "xbelmark/html/batch_resolver.h"
+#include "xbelmark/html/info.h"
+#include "xbelmark/paste/duplicates.h"
+#include "xbelmark/paste/paste.h"
+#include "xbelmark/paste/url_list.h"
+#include "xbelmark/url/url.h"
+#include "xbelmark/urlindex/url_index.h"
+#include "xbelmark/xml/writer.h"
+
+using xbelmark::html::BatchResolver;
+using xbelmark::html::Info;
+using xbelmark::url::NormalizedUrl;
+using xbelmark::urlindex::UrlIndex;
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  Reads the list of URLs to paste.
+ */
+std::string ReadUrlList(const CmdArgs &cmd_args) {
+  if (cmd_args.input_path.empty()) {
+    return QGuiApplication::clipboard()->text().toUtf8().toStdString();
+  }
+  if (cmd_args.input_path == "-") {
+    return std::string(
+        std::istreambuf_iterator<char>(std::cin),
+        std::istreambuf_iterator<char>());
+  }
+  QFile file(QString::fromStdString(cmd_args.input_path));
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Cannot read URLs from " + cmd_args.input_path);
+  }
+  return file.readAll().toStdString();
+}
+
+/**
+ *  Writes the progress of a URL to the standard error as a JSON line.
+ *
+ *  @param index
+ *    Zero-based index of the URL in the list.
+ *
+ *  @param html_info
+ *    Information that has been retrieved, whose error and numbers of retries
+ *    and duplicate requests are written.
+ *
+ *  @param is_duplicate
+ *    Whether the URL is already bookmarked in the collection or earlier in
+ *    the list.
+ *
+ *  @param num_done
+ *    Number of URLs that have been pasted or have failed so far.
+ *
+ *  @param num_urls
+ *    Number of URLs in the list.
+ */
+void WriteProgress(
+    std::size_t index,
+    const std::string &url,
+    const std::string &title,
+    const Info &html_info,
+    bool is_duplicate,
+    std::size_t num_done,
+    std::size_t num_urls) {
+  QJsonObject obj;
+  obj.insert("index", static_cast<qint64>(index));
+  obj.insert("url", QString::fromStdString(url));
+  obj.insert("title", QString::fromStdString(title));
+  if (!html_info.error.empty()) {
+    obj.insert("error", QString::fromStdString(html_info.error));
+  }
+  if (html_info.num_retries > 0) {
+    obj.insert("retries", html_info.num_retries);
+  }
+  if (html_info.num_hedges > 0) {
+    obj.insert("hedges", html_info.num_hedges);
+    obj.insert("hedge_wins", html_info.num_hedge_wins);
+  }
+  if (is_duplicate) {
+    obj.insert("duplicate", true);
+  }
+  obj.insert("done", static_cast<qint64>(num_done));
+  obj.insert("total", static_cast<qint64>(num_urls));
+  std::cerr <<
+      QJsonDocument(obj).toJson(QJsonDocument::Compact).toStdString() <<
+      std::endl;
+}
+
+int PasteBulk(const CmdArgs &cmd_args) {
+  const std::vector<std::string> urls(UrlLines(ReadUrlList(cmd_args)));
+  xmlTextWriterPtr text_writer = nullptr;
+  if (cmd_args.output_path.empty()) {
+    xmlOutputBufferPtr out_buffer = xmlOutputBufferCreateFile(stdout, nullptr);
+    if (out_buffer) {
+      text_writer = xmlNewTextWriter(out_buffer);
+    }
+  } else {
+    text_writer = xmlNewTextWriterFilename(cmd_args.output_path.c_str(), 0);
+  }
+  if (!text_writer) {
+    throw std::runtime_error(
+        "Cannot write bookmarks to " +
+        (cmd_args.output_path.empty() ?
+             std::string("the standard output") : cmd_args.output_path));
+  }
+  xbelmark::xml::Writer xml_writer(text_writer);
+  xml_writer.StartDocument("1.0", "UTF-8", "");
+  xml_writer.StartElement("xbel");
+  xml_writer.WriteAttribute("version", "1.0");
+  xml_writer.Flush();
+  std::size_t num_done = 0;
+  std::size_t num_failed = 0;
+  // Exceptions are not thrown through the event loop.
+  std::string write_error;
+  const std::unique_ptr<UrlIndex> url_index(
+      OpenUrlIndex(cmd_args, QDir::current()));
+  PrepareCollection(cmd_args, url_index.get());
+  // Bookmarks are indexed only if the XBEL document is in the collection.
+  const bool is_indexed =
+      IsInCollection(cmd_args, QDir::current(), cmd_args.output_path);
+  // Normalized URLs that have been pasted so far, or are being retrieved,
+  // so that a URL that is repeated in the list is a duplicate even if the
+  // bookmarks are not indexed.
+  std::set<std::string> pasted_urls;
+  const auto is_duplicate_url = [&](const QUrl &url) -> bool {
+    return cmd_args.duplicates != Duplicates::ALLOW &&
+        (pasted_urls.count(NormalizedUrl(url)) != 0 ||
+         !DuplicateWarning(cmd_args, url_index.get(), url).empty());
+  };
+  const bool needs_retrieval = NeedsRetrieval(cmd_args);
+  BatchResolver resolver(cmd_args.jobs, cmd_args.retrieval_options);
+  for (std::size_t i = 0; i != urls.size(); ++i) {
+    const QUrl url(QString::fromStdString(urls[i]));
+    if (!url.isValid() || url.isRelative()) {
+      ++num_done;
+      ++num_failed;
+      if (cmd_args.progress) {
+        Info html_info;
+        html_info.error = "Not a valid URL.";
+        WriteProgress(
+            i, urls[i], "", html_info, false, num_done, urls.size());
+      }
+      continue;
+    }
+    // The pasted URL is checked before the HTML document is retrieved.
+    bool is_pasted_duplicate = false;
+    try {
+      is_pasted_duplicate = is_duplicate_url(url);
+    } catch (const std::exception &e) {
+      write_error = e.what();
+      break;
+    }
+    if (is_pasted_duplicate && cmd_args.duplicates == Duplicates::SKIP) {
+      ++num_done;
+      if (cmd_args.progress) {
+        WriteProgress(
+            i, urls[i], "", Info(), is_pasted_duplicate, num_done, urls.size());
+      }
+      continue;
+    }
+    const std::string normalized_url(NormalizedUrl(url));
+    pasted_urls.insert(normalized_url);
+    const auto on_info =
+        [&, i, is_pasted_duplicate, normalized_url](
+            const Info &html_info) -> void {
+      const std::string bookmark_uri(BookmarkUri(cmd_args, html_info));
+      const std::string title(
+          html_info.title.empty() ? bookmark_uri : html_info.title);
+      bool is_duplicate = is_pasted_duplicate;
+      if (write_error.empty()) {
+        try {
+          const QUrl bookmark_url(QString::fromStdString(bookmark_uri));
+          // The pasted URL itself is in the pasted URLs.
+          const std::string normalized_bookmark_url(
+              NormalizedUrl(bookmark_url));
+          if (!is_duplicate && normalized_bookmark_url != normalized_url) {
+            is_duplicate = is_duplicate_url(bookmark_url);
+          }
+          if (!is_duplicate || cmd_args.duplicates != Duplicates::SKIP) {
+            WriteXbelBookmark(
+                xml_writer,
+                title,
+                html_info.description,
+                bookmark_uri,
+                html_info.icon_url.toString(QUrl::FullyEncoded)
+                    .toStdString());
+            xml_writer.Flush();
+            pasted_urls.insert(normalized_bookmark_url);
+            if (is_indexed) {
+              url_index->Insert(bookmark_url);
+            }
+          }
+        } catch (const std::exception &e) {
+          write_error = e.what();
+        }
+      }
+      ++num_done;
+      if (!html_info.error.empty()) {
+        ++num_failed;
+      }
+      if (cmd_args.progress) {
+        WriteProgress(
+            i,
+            urls[i],
+            title,
+            html_info,
+            is_duplicate,
+            num_done,
+            urls.size());
+      }
+    };
+    if (needs_retrieval) {
+      resolver.Enqueue(url, on_info);
+    } else {
+      on_info(GivenInfo(cmd_args, url));
+    }
+  }
+  resolver.WaitForAll();
+  if (!write_error.empty()) {
+    throw std::runtime_error(write_error);
+  }
+  xml_writer.EndElement();
+  xml_writer.EndDocument();
+  xml_writer.Flush();
+  return num_failed == 0 ? 0 : 1;
+}
+
+} // namespace paste
+} // namespace xbelmark
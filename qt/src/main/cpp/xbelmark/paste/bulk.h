@@ -0,0 +1,33 @@
+#ifndef XBELMARK_PASTE_BULK_H
+#define XBELMARK_PASTE_BULK_H
+
+#include "xbelmark/paste/cmd_args.h"
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  Pastes many URLs as bookmarks in one XBEL document.
+ *
+ *  The titles are retrieved concurrently, and each bookmark is written as
+ *  soon as its title has been retrieved, so the XBEL document grows as the
+ *  retrieval progresses. A `QCoreApplication` must exist, which must be a
+ *  `QGuiApplication` if the URLs are read from the clipboard.
+ *
+ *  @param cmd_args
+ *    Command-line arguments of the `paste` subcommand with `--bulk`, whose
+ *    retrieval options have been completed.
+ *
+ *  @return
+ *    Exit status, which is nonzero if the title of any URL could not be
+ *    retrieved.
+ *
+ *  @throw std::runtime_error
+ *    URLs cannot be read, or the XBEL document cannot be written.
+ */
+int PasteBulk(const CmdArgs &cmd_args);
+
+} // namespace paste
+} // namespace xbelmark
+
+#endif
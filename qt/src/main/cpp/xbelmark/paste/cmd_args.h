@@ -4,7 +4,11 @@
 #include <string>
 
 #include "xbelmark/cmd_args.h"
+#include "xbelmark/html/retrieval_options.h"
+#include "xbelmark/paste/duplicates.h"
 #include "xbelmark/paste/format.h"
+#include "xbelmark/paste/href.h"
+#include "xbelmark/paste/layout.h"
 
 namespace xbelmark {
 namespace paste {
@@ -25,6 +29,16 @@ struct CmdArgs : public xbelmark::CmdArgs {
    */
   std::string uri;
 
+  /**
+   *  URL that is written as the target of the bookmark.
+   */
+  Href href = Href::PASTED;
+
+  /**
+   *  Layout of the directories of bookmark files.
+   */
+  Layout layout = Layout::FLAT;
+
   /**
    *  Whether the spaces in a file name are preserved.
    */
@@ -34,6 +48,92 @@ struct CmdArgs : public xbelmark::CmdArgs {
    *  Whether the bookmark is written to the standard output.
    */
   bool std_out = false;
+
+  /**
+   *  Path to the journal that the bookmark is appended to instead of being
+   *  written to a file, or an empty string for none.
+   */
+  std::string journal_path;
+
+  /**
+   *  Options for retrieving information about the HTML document at the URI.
+   */
+  xbelmark::html::RetrievalOptions retrieval_options;
+
+  /**
+   *  Path to the root of the directory tree of bookmark files that is checked
+   *  for duplicates, or an empty string for none.
+   */
+  std::string collection_dir;
+
+  /**
+   *  How a URL that is already bookmarked in the collection is handled.
+   */
+  Duplicates duplicates = Duplicates::WARN;
+
+  /**
+   *  Whether the index of the URLs in the collection is rebuilt.
+   */
+  bool reindex = false;
+
+  /**
+   *  Title of the bookmark, or an empty string for the HTML title.
+   */
+  std::string title;
+
+  /**
+   *  Whether the bookmark is pasted without retrieving the HTML document.
+   */
+  bool no_fetch = false;
+
+  /**
+   *  Whether the persistent cache is disabled.
+   */
+  bool no_cache = false;
+
+  /**
+   *  Whether the icon of the HTML document is fetched into the icon cache and
+   *  referenced by a bookmark in the XBEL format.
+   */
+  bool icons = false;
+
+  /**
+   *  Whether the bookmark is pasted by the daemon if it is running.
+   */
+  bool daemon = false;
+
+  /**
+   *  Name of the local server of the daemon, or an empty string for the
+   *  default.
+   */
+  std::string daemon_name;
+
+  /**
+   *  Whether many URLs are pasted as bookmarks in one XBEL document.
+   */
+  bool bulk = false;
+
+  /**
+   *  Path to the file of URLs to paste in bulk, `-` for the standard input, or
+   *  an empty string for the clipboard text.
+   */
+  std::string input_path;
+
+  /**
+   *  Path to the XBEL document of bookmarks pasted in bulk, or an empty
+   *  string for the standard output.
+   */
+  std::string output_path;
+
+  /**
+   *  Maximum number of URLs whose titles are retrieved at a time in bulk.
+   */
+  int jobs = 8;
+
+  /**
+   *  Whether progress in bulk is written to the standard error as JSON lines.
+   */
+  bool progress = false;
 };
 
 } // namespace paste
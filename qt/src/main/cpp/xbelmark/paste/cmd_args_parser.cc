@@ -1,6 +1,8 @@
 #include "xbelmark/paste/cmd_args_parser.h"
 
+#include <cstddef>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 #define SUBCOMMAND_NAME "paste"
@@ -47,6 +49,23 @@ class CmdArgsParser::Impl final {
         "\n" +
         "      URI of the resource specified by the bookmark. If not\n" +
         "      specified, the clipboard text is used.\n\n";
+    help = help +
+        "  --href [href]\n" +
+        "\n" +
+        "      URL that is written as the target of the bookmark. Valid\n" +
+        "      values are `PASTED` (URL as pasted), `FINAL` (URL after\n" +
+        "      redirects), and `CANONICAL` (URL that the HTML document\n" +
+        "      links as canonical, or else the URL after redirects). If\n" +
+        "      not specified, it is `PASTED`.\n\n";
+    help = help +
+        "  --layout [layout]\n" +
+        "\n" +
+        "      Layout of the directories of bookmark files, which keeps\n" +
+        "      directories small. Valid values are `FLAT` (in the current\n" +
+        "      directory), `HASH` (in 256 subdirectories named by a hash\n" +
+        "      of the file name), and `DATE` (in subdirectories named by\n" +
+        "      year and month, such as `2024/05`). If not specified, it\n" +
+        "      is `FLAT`.\n\n";
     help = help +
         "  --spaces\n" +
         "\n" +
@@ -57,6 +76,188 @@ class CmdArgsParser::Impl final {
         "  --stdout\n" +
         "\n" +
         "      Write the bookmark to the standard output.\n\n";
+    help = help +
+        "  --journal [path]\n" +
+        "\n" +
+        "      Append the bookmark to a journal, which can be appended to\n" +
+        "      by many processes at a time, instead of writing a file. The\n" +
+        "      journal is folded into an XBEL document by\n" +
+        "      `" + cmd_args_->command_name + " compact`.\n\n";
+    help = help +
+        "  --collection [dir]\n" +
+        "\n" +
+        "      Root of the directory tree of `.xbel` and `.url` files that\n" +
+        "      is checked for the URL before pasting. The URLs in it are\n" +
+        "      indexed in `.xbelmark-index` at the root, which is built on\n" +
+        "      first use and updated as bookmarks are pasted. A journal in\n" +
+        "      it is indexed along with the `.xbel` and `.url` files.\n\n";
+    help = help +
+        "  --duplicates [duplicates]\n" +
+        "\n" +
+        "      How a URL that is already in the collection is handled.\n" +
+        "      Valid values are `ALLOW` (paste silently), `WARN` (paste\n" +
+        "      with a warning), and `SKIP` (do not paste, but warn). If\n" +
+        "      not specified, it is `WARN`.\n\n";
+    help = help +
+        "  --reindex\n" +
+        "\n" +
+        "      Rebuild the index of the collection before pasting, such as\n" +
+        "      after bookmark files were removed.\n\n";
+    help = help +
+        "  --title [title]\n" +
+        "\n" +
+        "      Title of the bookmark. If specified, the HTML document is\n" +
+        "      retrieved only if `--href` or `--icons` needs it.\n\n";
+    help = help +
+        "  --no-fetch\n" +
+        "\n" +
+        "      Paste without retrieving the HTML document. The URL is\n" +
+        "      written as pasted, and is used as the title unless\n" +
+        "      `--title` is specified.\n\n";
+    help = help +
+        "  --max-bytes [bytes]\n" +
+        "\n" +
+        "      Maximum number of bytes of the HTML document to download\n" +
+        "      while looking for its title, or `0` for no limit. If not\n" +
+        "      specified, it is `1048576`.\n\n";
+    help = help +
+        "  --range-bytes [bytes]\n" +
+        "\n" +
+        "      Request only the first given number of bytes of the HTML\n" +
+        "      document, and request more only if the title is not in\n" +
+        "      them, or `0` to request the whole HTML document. If not\n" +
+        "      specified, it is `0`.\n\n";
+    help = help +
+        "  --cache-dir [dir]\n" +
+        "\n" +
+        "      Directory of the persistent cache of HTML titles. The\n" +
+        "      cache is used by default, unless `--no-cache` is set. If not\n" +
+        "      specified, `xbelmark/titles` under the cache location of\n" +
+        "      the user is used.\n\n";
+    help = help +
+        "  --tls-session-dir [dir]\n" +
+        "\n" +
+        "      Directory of the TLS session tickets that are kept per\n" +
+        "      server, so that the next paste resumes the TLS session\n" +
+        "      instead of doing a full handshake. The tickets grant\n" +
+        "      resumption of the sessions, so they are kept only if this\n" +
+        "      is specified.\n\n";
+    help = help +
+        "  --icons\n" +
+        "\n" +
+        "      Fetch the icon of the HTML document into the icon cache,\n" +
+        "      and reference it by the `icon` attribute of a bookmark in\n" +
+        "      the `XBEL` format. Each icon is stored once however many\n" +
+        "      bookmarks share it, and the `xslt` subcommand can embed it\n" +
+        "      without accessing the network.\n\n";
+    help = help +
+        "  --icon-cache [dir]\n" +
+        "\n" +
+        "      Directory of the icon cache, which implies `--icons`. If\n" +
+        "      not specified, `xbelmark/icons` under the cache location of\n" +
+        "      the user is used.\n\n";
+    help = help +
+        "  --cache-ttl [seconds]\n" +
+        "\n" +
+        "      Age up to which a cached title is used without being\n" +
+        "      revalidated with the server. If not specified, it is\n" +
+        "      `86400`.\n\n";
+    help = help +
+        "  --cache-max-entries [entries]\n" +
+        "\n" +
+        "      Maximum number of cached titles, and of cached redirects,\n" +
+        "      or `0` for no limit. If not specified, it is `10000`.\n\n";
+    help = help +
+        "  --cache-only\n" +
+        "\n" +
+        "      Use only the cache without accessing the network. The URL\n" +
+        "      is used as the title if it is not in the cache.\n\n";
+    help = help +
+        "  --no-cache\n" +
+        "\n" +
+        "      Neither consult nor update the cache.\n\n";
+    help = help +
+        "  --connect-timeout [ms]\n" +
+        "\n" +
+        "      Time within which the request for the title must be sent,\n" +
+        "      or `0` for no limit. If not specified, it is `5000`.\n\n";
+    help = help +
+        "  --first-byte-timeout [ms]\n" +
+        "\n" +
+        "      Time within which the response must start arriving, or `0`\n" +
+        "      for no limit. If not specified, it is `10000`.\n\n";
+    help = help +
+        "  --timeout [ms]\n" +
+        "\n" +
+        "      Time within which the title must be retrieved, or `0` for\n" +
+        "      no limit. If not specified, it is `15000`. When a deadline\n" +
+        "      is exceeded, the title read so far is used, or the URL if\n" +
+        "      none has been read.\n\n";
+    help = help +
+        "  --hedge-percentile [percentile]\n" +
+        "\n" +
+        "      Send a duplicate of a request that has not responded within\n" +
+        "      this percentile of the latencies observed so far, and use\n" +
+        "      whichever responds first, or `0` for no duplicates. It is\n" +
+        "      meant for `--bulk` and `--daemon`, such as `95`. If not\n" +
+        "      specified, it is `0`.\n\n";
+    help = help +
+        "  --hedge-delay [ms]\n" +
+        "\n" +
+        "      Time after which a duplicate of a request is sent until\n" +
+        "      enough latencies have been observed. If not specified, it\n" +
+        "      is `1000`.\n\n";
+    help = help +
+        "  --retries [retries]\n" +
+        "\n" +
+        "      Maximum number of times that a request is retried after a\n" +
+        "      transient failure, such as a refused connection or a status\n" +
+        "      of `429` or `503`, within `--timeout`. If not specified, it\n" +
+        "      is `0`.\n\n";
+    help = help +
+        "  --retry-backoff [ms]\n" +
+        "\n" +
+        "      Backoff before the first retry, which doubles with each\n" +
+        "      retry and is jittered. If not specified, it is `250`.\n\n";
+    help = help +
+        "  --daemon\n" +
+        "\n" +
+        "      Have the bookmark pasted by the daemon, which is started by\n" +
+        "      `" + cmd_args_->command_name + " daemon`. If it is not\n" +
+        "      running, the bookmark is pasted by this process.\n\n";
+    help = help +
+        "  --daemon-name [name]\n" +
+        "\n" +
+        "      Name of the local server of the daemon. If not specified,\n" +
+        "      the default name of the daemon is used.\n\n";
+    help = help +
+        "  --bulk\n" +
+        "\n" +
+        "      Paste many URLs, one per line, as bookmarks in one XBEL\n" +
+        "      document. Empty lines and lines beginning with `#` are\n" +
+        "      skipped. The bookmarks are written in the order that their\n" +
+        "      titles are retrieved. A URL that is repeated in the list is\n" +
+        "      handled as one in the collection by `--duplicates`.\n\n";
+    help = help +
+        "  --input [path]\n" +
+        "\n" +
+        "      File of URLs to paste with `--bulk`, or `-` for the standard\n" +
+        "      input. If not specified, the clipboard text is used.\n\n";
+    help = help +
+        "  --output [path]\n" +
+        "\n" +
+        "      XBEL document to write with `--bulk`. If not specified, it\n" +
+        "      is written to the standard output.\n\n";
+    help = help +
+        "  --jobs [jobs]\n" +
+        "\n" +
+        "      Maximum number of titles retrieved at a time with `--bulk`.\n" +
+        "      If not specified, it is `8`.\n\n";
+    help = help +
+        "  --progress\n" +
+        "\n" +
+        "      Write a JSON object to the standard error for each URL\n" +
+        "      pasted with `--bulk`.\n\n";
     help = help +
         "  --help, -h\n" +
         "\n" +
@@ -85,6 +286,28 @@ class CmdArgsParser::Impl final {
     cmd_args_->uri = *arg_it_++;
   }
 
+  /**
+   *  Set the URL that is written as the target of the bookmark.
+   */
+  void SetHref() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--href`.");
+    }
+    cmd_args_->href = EnumValueOf<Href>(*arg_it_++);
+  }
+
+  /**
+   *  Set the layout of the directories of bookmark files.
+   */
+  void SetLayout() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--layout`.");
+    }
+    cmd_args_->layout = EnumValueOf<Layout>(*arg_it_++);
+  }
+
   /**
    *  Whether the spaces in a file name are preserved.
    */
@@ -101,6 +324,318 @@ class CmdArgsParser::Impl final {
     cmd_args_->std_out = true;
   }
 
+  /**
+   *  Set the root of the collection that is checked for duplicates.
+   */
+  void SetCollection() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--collection`.");
+    }
+    cmd_args_->collection_dir = *arg_it_++;
+  }
+
+  /**
+   *  Set how a URL that is already in the collection is handled.
+   */
+  void SetDuplicates() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--duplicates`.");
+    }
+    cmd_args_->duplicates = EnumValueOf<Duplicates>(*arg_it_++);
+  }
+
+  /**
+   *  Set that the index of the collection is rebuilt.
+   */
+  void SetReindex() {
+    ++arg_it_;
+    cmd_args_->reindex = true;
+  }
+
+  /**
+   *  Set the path to the journal.
+   */
+  void SetJournal() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--journal`.");
+    }
+    cmd_args_->journal_path = *arg_it_++;
+  }
+
+  /**
+   *  Set the title of the bookmark.
+   */
+  void SetTitle() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--title`.");
+    }
+    cmd_args_->title = *arg_it_++;
+  }
+
+  /**
+   *  Set that the HTML document is not retrieved.
+   */
+  void SetNoFetch() {
+    ++arg_it_;
+    cmd_args_->no_fetch = true;
+  }
+
+  /**
+   *  Set the maximum number of bytes of the HTML document to download.
+   */
+  void SetMaxBytes() {
+    cmd_args_->retrieval_options.max_bytes = NonNegativeIntArg("--max-bytes");
+  }
+
+  /**
+   *  Set the number of bytes of the HTML document to request at first.
+   */
+  void SetRangeBytes() {
+    cmd_args_->retrieval_options.range_bytes =
+        NonNegativeIntArg("--range-bytes");
+  }
+
+  /**
+   *  Set the directory of the persistent cache.
+   */
+  void SetCacheDir() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--cache-dir`.");
+    }
+    cmd_args_->retrieval_options.cache_dir = *arg_it_++;
+  }
+
+  /**
+   *  Set the directory of the TLS sessions.
+   */
+  void SetTlsSessionDir() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error(
+          "Insufficient arguments for `--tls-session-dir`.");
+    }
+    cmd_args_->retrieval_options.tls_session_dir = *arg_it_++;
+  }
+
+  /**
+   *  Set that icons are fetched.
+   */
+  void SetIcons() {
+    ++arg_it_;
+    cmd_args_->icons = true;
+  }
+
+  /**
+   *  Set the directory of the icon cache.
+   */
+  void SetIconCache() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--icon-cache`.");
+    }
+    cmd_args_->retrieval_options.icon_cache_dir = *arg_it_++;
+    cmd_args_->icons = true;
+  }
+
+  /**
+   *  Set the age up to which a cached title is used without revalidation.
+   */
+  void SetCacheTtl() {
+    cmd_args_->retrieval_options.cache_ttl = NonNegativeIntArg("--cache-ttl");
+  }
+
+  /**
+   *  Set the maximum number of cached titles.
+   */
+  void SetCacheMaxEntries() {
+    cmd_args_->retrieval_options.cache_max_entries =
+        NonNegativeIntArg("--cache-max-entries");
+  }
+
+  /**
+   *  Set that only the cache is used.
+   */
+  void SetCacheOnly() {
+    ++arg_it_;
+    cmd_args_->retrieval_options.cache_only = true;
+  }
+
+  /**
+   *  Set that the cache is disabled.
+   */
+  void SetNoCache() {
+    ++arg_it_;
+    cmd_args_->no_cache = true;
+  }
+
+  /**
+   *  Set the deadline for sending the request.
+   */
+  void SetConnectTimeout() {
+    cmd_args_->retrieval_options.connect_timeout =
+        NonNegativeIntArg("--connect-timeout");
+  }
+
+  /**
+   *  Set the deadline for the response to start arriving.
+   */
+  void SetFirstByteTimeout() {
+    cmd_args_->retrieval_options.first_byte_timeout =
+        NonNegativeIntArg("--first-byte-timeout");
+  }
+
+  /**
+   *  Set the deadline for the retrieval to finish.
+   */
+  void SetTimeout() {
+    cmd_args_->retrieval_options.total_timeout =
+        NonNegativeIntArg("--timeout");
+  }
+
+  /**
+   *  Set the percentile of the latency beyond which a request is hedged.
+   */
+  void SetHedgePercentile() {
+    const long long percentile = NonNegativeIntArg("--hedge-percentile");
+    if (percentile > 100) {
+      throw std::runtime_error(
+          "Invalid argument for `--hedge-percentile`: " +
+          std::to_string(percentile));
+    }
+    cmd_args_->retrieval_options.hedge_percentile =
+        static_cast<double>(percentile);
+  }
+
+  /**
+   *  Set the delay of hedging before enough latencies have been observed.
+   */
+  void SetHedgeDelay() {
+    cmd_args_->retrieval_options.hedge_delay =
+        NonNegativeIntArg("--hedge-delay");
+  }
+
+  /**
+   *  Set the maximum number of retries after a transient failure.
+   */
+  void SetRetries() {
+    const long long retries = NonNegativeIntArg("--retries");
+    if (retries > 100) {
+      throw std::runtime_error(
+          "Invalid argument for `--retries`: " + std::to_string(retries));
+    }
+    cmd_args_->retrieval_options.max_retries = static_cast<int>(retries);
+  }
+
+  /**
+   *  Set the backoff before the first retry.
+   */
+  void SetRetryBackoff() {
+    cmd_args_->retrieval_options.retry_backoff =
+        NonNegativeIntArg("--retry-backoff");
+  }
+
+  /**
+   *  Set that the bookmark is pasted by the daemon.
+   */
+  void SetDaemon() {
+    ++arg_it_;
+    cmd_args_->daemon = true;
+  }
+
+  /**
+   *  Set the name of the local server of the daemon.
+   */
+  void SetDaemonName() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--daemon-name`.");
+    }
+    cmd_args_->daemon_name = *arg_it_++;
+  }
+
+  /**
+   *  Set that URLs are pasted in bulk.
+   */
+  void SetBulk() {
+    ++arg_it_;
+    cmd_args_->bulk = true;
+  }
+
+  /**
+   *  Set the path to the file of URLs to paste in bulk.
+   */
+  void SetInput() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--input`.");
+    }
+    cmd_args_->input_path = *arg_it_++;
+  }
+
+  /**
+   *  Set the path to the XBEL document of bookmarks pasted in bulk.
+   */
+  void SetOutput() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--output`.");
+    }
+    cmd_args_->output_path = *arg_it_++;
+  }
+
+  /**
+   *  Set the maximum number of titles retrieved at a time in bulk.
+   */
+  void SetJobs() {
+    const long long jobs = NonNegativeIntArg("--jobs");
+    if (jobs < 1 || jobs > 256) {
+      throw std::runtime_error(
+          "Invalid argument for `--jobs`: " + std::to_string(jobs));
+    }
+    cmd_args_->jobs = static_cast<int>(jobs);
+  }
+
+  /**
+   *  Set that progress in bulk is written to the standard error.
+   */
+  void SetProgress() {
+    ++arg_it_;
+    cmd_args_->progress = true;
+  }
+
+  /**
+   *  Consume an option and its argument as a non-negative integer.
+   *
+   *  @param opt
+   *    Name of the option.
+   *
+   *  @return
+   *    Argument of the option.
+   */
+  long long NonNegativeIntArg(const std::string &opt) {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `" + opt + "`.");
+    }
+    const std::string arg(*arg_it_++);
+    std::size_t num_chars = 0;
+    long long retval = -1;
+    try {
+      retval = std::stoll(arg, &num_chars);
+    } catch (const std::exception &) {
+    }
+    if (retval < 0 || num_chars != arg.size()) {
+      throw std::runtime_error(
+          "Invalid argument for `" + opt + "`: " + arg);
+    }
+    return retval;
+  }
+
   /**
    *  Parsed command-line arguments.
    */
@@ -144,10 +679,74 @@ std::unique_ptr<CmdArgs> CmdArgsParser::Parse(char **first, char **last) {
         p_impl_->SetFormat();
       } else if (opt == "--uri") {
         p_impl_->SetUri();
+      } else if (opt == "--href") {
+        p_impl_->SetHref();
+      } else if (opt == "--layout") {
+        p_impl_->SetLayout();
       } else if (opt == "--spaces") {
         p_impl_->SetSpaces();
       } else if (opt == "--stdout") {
         p_impl_->SetStdOut();
+      } else if (opt == "--collection") {
+        p_impl_->SetCollection();
+      } else if (opt == "--duplicates") {
+        p_impl_->SetDuplicates();
+      } else if (opt == "--reindex") {
+        p_impl_->SetReindex();
+      } else if (opt == "--journal") {
+        p_impl_->SetJournal();
+      } else if (opt == "--title") {
+        p_impl_->SetTitle();
+      } else if (opt == "--no-fetch") {
+        p_impl_->SetNoFetch();
+      } else if (opt == "--max-bytes") {
+        p_impl_->SetMaxBytes();
+      } else if (opt == "--range-bytes") {
+        p_impl_->SetRangeBytes();
+      } else if (opt == "--cache-dir") {
+        p_impl_->SetCacheDir();
+      } else if (opt == "--tls-session-dir") {
+        p_impl_->SetTlsSessionDir();
+      } else if (opt == "--icons") {
+        p_impl_->SetIcons();
+      } else if (opt == "--icon-cache") {
+        p_impl_->SetIconCache();
+      } else if (opt == "--cache-ttl") {
+        p_impl_->SetCacheTtl();
+      } else if (opt == "--cache-max-entries") {
+        p_impl_->SetCacheMaxEntries();
+      } else if (opt == "--cache-only") {
+        p_impl_->SetCacheOnly();
+      } else if (opt == "--no-cache") {
+        p_impl_->SetNoCache();
+      } else if (opt == "--connect-timeout") {
+        p_impl_->SetConnectTimeout();
+      } else if (opt == "--first-byte-timeout") {
+        p_impl_->SetFirstByteTimeout();
+      } else if (opt == "--timeout") {
+        p_impl_->SetTimeout();
+      } else if (opt == "--hedge-percentile") {
+        p_impl_->SetHedgePercentile();
+      } else if (opt == "--hedge-delay") {
+        p_impl_->SetHedgeDelay();
+      } else if (opt == "--retries") {
+        p_impl_->SetRetries();
+      } else if (opt == "--retry-backoff") {
+        p_impl_->SetRetryBackoff();
+      } else if (opt == "--daemon") {
+        p_impl_->SetDaemon();
+      } else if (opt == "--daemon-name") {
+        p_impl_->SetDaemonName();
+      } else if (opt == "--bulk") {
+        p_impl_->SetBulk();
+      } else if (opt == "--input") {
+        p_impl_->SetInput();
+      } else if (opt == "--output") {
+        p_impl_->SetOutput();
+      } else if (opt == "--jobs") {
+        p_impl_->SetJobs();
+      } else if (opt == "--progress") {
+        p_impl_->SetProgress();
       } else if (opt.front() == '-') {
         throw std::runtime_error("Unrecognized option: " + opt);
       } else {
@@ -158,6 +757,40 @@ std::unique_ptr<CmdArgs> CmdArgsParser::Parse(char **first, char **last) {
       throw std::runtime_error("Unrecognized positional argument: " + arg);
     }
   }
+  // Ensure the cache options are consistent.
+  if (p_impl_->cmd_args_->no_cache &&
+      p_impl_->cmd_args_->retrieval_options.cache_only) {
+    throw std::invalid_argument(
+        "`--cache-only` and `--no-cache` are mutually exclusive.");
+  }
+  if (p_impl_->cmd_args_->reindex &&
+      p_impl_->cmd_args_->collection_dir.empty()) {
+    throw std::invalid_argument("`--reindex` requires `--collection`.");
+  }
+  // Ensure the journal options are consistent.
+  if (!p_impl_->cmd_args_->journal_path.empty()) {
+    if (p_impl_->cmd_args_->format != Format::XBEL) {
+      throw std::invalid_argument("`--journal` requires the `XBEL` format.");
+    }
+    if (p_impl_->cmd_args_->std_out || p_impl_->cmd_args_->bulk) {
+      throw std::invalid_argument(
+          "`--journal` is mutually exclusive with `--stdout` and `--bulk`.");
+    }
+  }
+  // Ensure the bulk options are consistent.
+  const CmdArgs &cmd_args = *p_impl_->cmd_args_;
+  if (cmd_args.bulk) {
+    if (cmd_args.format != Format::XBEL) {
+      throw std::invalid_argument("`--bulk` requires the `XBEL` format.");
+    }
+    if (!cmd_args.uri.empty() || !cmd_args.title.empty()) {
+      throw std::invalid_argument(
+          "`--bulk` is mutually exclusive with `--uri` and `--title`.");
+    }
+  } else if (!cmd_args.input_path.empty() || !cmd_args.output_path.empty()) {
+    throw std::invalid_argument(
+        "`--input` and `--output` require `--bulk`.");
+  }
   return std::move(p_impl_->cmd_args_);
 }
 
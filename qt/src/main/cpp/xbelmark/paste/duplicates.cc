@@ -0,0 +1,42 @@
+#include "xbelmark/paste/duplicates.h"
+
+#include <array>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+using xbelmark::paste::Duplicates;
+
+namespace xbelmark {
+namespace enumeration {
+
+template <>
+std::string EnumNameOf(Duplicates enumerator) {
+  static const std::map<Duplicates, std::string> mapping = {
+    { Duplicates::ALLOW, "ALLOW" },
+    { Duplicates::WARN, "WARN" },
+    { Duplicates::SKIP, "SKIP" }
+  };
+
+  return mapping.at(enumerator);
+}
+
+template <>
+Duplicates EnumValueOf(const std::string &name) {
+  static const std::array<Duplicates, 3> enumerators = {
+    Duplicates::ALLOW,
+    Duplicates::WARN,
+    Duplicates::SKIP
+  };
+
+  for (const auto &enumerator : enumerators) {
+    if (EnumNameOf(enumerator) == name) {
+      return enumerator;
+    }
+  }
+
+  throw std::out_of_range("Invalid enumerator name: " + name);
+}
+
+} // namespace enumeration
+} // namespace xbelmark
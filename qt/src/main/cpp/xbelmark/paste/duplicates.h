@@ -0,0 +1,47 @@
+#ifndef XBELMARK_PASTE_DUPLICATES_H
+#define XBELMARK_PASTE_DUPLICATES_H
+
+#include <string>
+
+#include "xbelmark/enumeration/name.h"
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  Enumeration of the ways that the `paste` subcommand handles a URL that is
+ *  already bookmarked in the collection.
+ */
+enum class Duplicates : int {
+  /**
+   *  Bookmark is pasted silently.
+   */
+  ALLOW,
+
+  /**
+   *  Bookmark is pasted with a warning.
+   */
+  WARN,
+
+  /**
+   *  Bookmark is not pasted, and a warning is given instead.
+   */
+  SKIP
+};
+
+} // namespace paste
+} // namespace xbelmark
+
+namespace xbelmark {
+namespace enumeration {
+
+template <>
+std::string EnumNameOf(xbelmark::paste::Duplicates enumerator);
+
+template <>
+xbelmark::paste::Duplicates EnumValueOf(const std::string &name);
+
+} // namespace enumeration
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,42 @@
+#include "xbelmark/paste/href.h"
+
+#include <array>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+using xbelmark::paste::Href;
+
+namespace xbelmark {
+namespace enumeration {
+
+template <>
+std::string EnumNameOf(Href enumerator) {
+  static const std::map<Href, std::string> mapping = {
+    { Href::PASTED, "PASTED" },
+    { Href::FINAL, "FINAL" },
+    { Href::CANONICAL, "CANONICAL" }
+  };
+
+  return mapping.at(enumerator);
+}
+
+template <>
+Href EnumValueOf(const std::string &name) {
+  static const std::array<Href, 3> enumerators = {
+    Href::PASTED,
+    Href::FINAL,
+    Href::CANONICAL
+  };
+
+  for (const auto &enumerator : enumerators) {
+    if (EnumNameOf(enumerator) == name) {
+      return enumerator;
+    }
+  }
+
+  throw std::out_of_range("Invalid enumerator name: " + name);
+}
+
+} // namespace enumeration
+} // namespace xbelmark
@@ -0,0 +1,48 @@
+#ifndef XBELMARK_PASTE_HREF_H
+#define XBELMARK_PASTE_HREF_H
+
+#include <string>
+
+#include "xbelmark/enumeration/name.h"
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  Enumeration of the URLs that can be written as the target of a bookmark
+ *  from the `paste` subcommand.
+ */
+enum class Href : int {
+  /**
+   *  URL as it was pasted.
+   */
+  PASTED,
+
+  /**
+   *  URL after redirects.
+   */
+  FINAL,
+
+  /**
+   *  URL that the HTML document links as canonical, or the URL after
+   *  redirects if there is none.
+   */
+  CANONICAL
+};
+
+} // namespace paste
+} // namespace xbelmark
+
+namespace xbelmark {
+namespace enumeration {
+
+template <>
+std::string EnumNameOf(xbelmark::paste::Href enumerator);
+
+template <>
+xbelmark::paste::Href EnumValueOf(const std::string &name);
+
+} // namespace enumeration
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,42 @@
+#include "xbelmark/paste/layout.h"
+
+#include <array>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+using xbelmark::paste::Layout;
+
+namespace xbelmark {
+namespace enumeration {
+
+template <>
+std::string EnumNameOf(Layout enumerator) {
+  static const std::map<Layout, std::string> mapping = {
+    { Layout::FLAT, "FLAT" },
+    { Layout::HASH, "HASH" },
+    { Layout::DATE, "DATE" }
+  };
+
+  return mapping.at(enumerator);
+}
+
+template <>
+Layout EnumValueOf(const std::string &name) {
+  static const std::array<Layout, 3> enumerators = {
+    Layout::FLAT,
+    Layout::HASH,
+    Layout::DATE
+  };
+
+  for (const auto &enumerator : enumerators) {
+    if (EnumNameOf(enumerator) == name) {
+      return enumerator;
+    }
+  }
+
+  throw std::out_of_range("Invalid enumerator name: " + name);
+}
+
+} // namespace enumeration
+} // namespace xbelmark
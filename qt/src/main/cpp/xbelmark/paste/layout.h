@@ -0,0 +1,49 @@
+#ifndef XBELMARK_PASTE_LAYOUT_H
+#define XBELMARK_PASTE_LAYOUT_H
+
+#include <string>
+
+#include "xbelmark/enumeration/name.h"
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  Enumeration of the layouts of the directories of bookmark files from the
+ *  `paste` subcommand.
+ */
+enum class Layout : int {
+  /**
+   *  Bookmark files are in the output directory.
+   */
+  FLAT,
+
+  /**
+   *  Bookmark files are in 256 subdirectories named by a hash of the file
+   *  name, such as `3f`.
+   */
+  HASH,
+
+  /**
+   *  Bookmark files are in subdirectories named by the year and month that
+   *  they are added, such as `2024/05`.
+   */
+  DATE
+};
+
+} // namespace paste
+} // namespace xbelmark
+
+namespace xbelmark {
+namespace enumeration {
+
+template <>
+std::string EnumNameOf(xbelmark::paste::Layout enumerator);
+
+template <>
+xbelmark::paste::Layout EnumValueOf(const std::string &name);
+
+} // namespace enumeration
+} // namespace xbelmark
+
+#endif
@@ -1,29 +1,54 @@
 #include "xbelmark/paste/paste.h"
 
+#include <climits>
 #include <cstdio>
 #include <ctime>
 #include <iostream>
-#include <regex>
+#include <memory>
+#include <stdexcept>
 #include <string>
 
 #include <QClipboard>
+#include <QCoreApplication>
 #include <QDir>
 #include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
 #include <QGuiApplication>
 #include <QIODevice>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QMessageBox>
 #include <QMimeData>
+#include <QStandardPaths>
 #include <QTextStream>
 #include <QUrl>
+#include <QtGlobal>
+#include <libxml/tree.h>
 #include <libxml/xmlwriter.h>
 
+#include "xbelmark/daemon/client.h"
+#include "xbelmark/daemon/protocol.h"
+#include "xbelmark/html/icon_cache.h"
 #include "xbelmark/html/info_retriever.h"
+#include "xbelmark/journal/journal.h"
+#include "xbelmark/paste/bookmark_path.h"
+#include "xbelmark/paste/bulk.h"
 #include "xbelmark/paste/cmd_args.h"
 #include "xbelmark/paste/cmd_args_parser.h"
+#include "xbelmark/paste/duplicates.h"
 #include "xbelmark/paste/format.h"
+#include "xbelmark/paste/href.h"
+#include "xbelmark/paste/layout.h"
+#include "xbelmark/urlindex/url_index.h"
 #include "xbelmark/xml/writer.h"
 
+/**
+ *  Largest number that is appended to the file name of a bookmark to make it
+ *  distinct.
+ */
+#define MAX_FILE_NAME_NUMBER 1000
+
 #ifdef WIN32
 #include <codecvt>
 
@@ -32,6 +57,8 @@
 #define TIMEOUT_MILLISECONDS 5000
 #endif
 
+using xbelmark::urlindex::UrlIndex;
+
 namespace xbelmark {
 namespace paste {
 
@@ -114,138 +141,588 @@ void DisplayError(const std::string &message) {
 }
 
 /**
- *  Pastes a URI as a bookmark file in the URL format with the `.url` extension
- *  in the current working directory.
+ *  Selects a pasted bookmark file in the File Explorer window in the
+ *  foreground on Windows, and does nothing elsewhere.
+ *
+ *  @param out_file_path
+ *    Path to the bookmark file.
+ */
+void SelectInFileExplorer(const std::string &out_file_path) {
+#ifdef WIN32
+  CoInitialize(nullptr);
+  try {
+    xbelmark::winshell::FolderView fv(GetForegroundWindow());
+    WinSelectItem(
+        fv,
+        QFileInfo(QString::fromStdString(out_file_path))
+            .fileName().toUtf8().constData(),
+        TIMEOUT_MILLISECONDS);
+  } catch (const std::exception &) {
+  }
+  CoUninitialize();
+#else
+  static_cast<void>(out_file_path);
+#endif
+}
+
+/**
+ *  Creates the file of a new bookmark exclusively, so that a file that exists
+ *  or is created by another process at the same time is not overwritten.
+ *
+ *  If the file name is taken, a number is appended to it, such as
+ *  `Example (2).xbel`.
+ *
+ *  @param dir
+ *    Directory of the file.
+ *
+ *  @param base_file_name
+ *    Name of the file without the extension.
+ *
+ *  @param extension
+ *    Extension of the file with the leading dot.
+ *
+ *  @return
+ *    Path to the empty file that has been created.
+ */
+std::string NewBookmarkPath(
+    const QDir &dir,
+    const std::string &base_file_name,
+    const std::string &extension) {
+  for (int number = 1; number <= MAX_FILE_NAME_NUMBER; ++number) {
+    const QString out_file_path(
+        dir.filePath(
+            QString::fromStdString(
+                NumberedFileName(base_file_name, extension, number))));
+    QFile out_file(out_file_path);
+    if (out_file.open(QIODevice::WriteOnly | QIODevice::NewOnly)) {
+      return out_file_path.toStdString();
+    }
+    if (!out_file.exists()) {
+      throw std::runtime_error(
+          "Cannot write bookmark at\n" + out_file_path.toStdString());
+    }
+  }
+  throw std::runtime_error(
+      "Too many bookmarks with the same file name:\n" +
+      dir.filePath(QString::fromStdString(base_file_name + extension))
+          .toStdString());
+}
+
+/**
+ *  Directory of a bookmark file in a layout, which is created if it does not
+ *  exist.
+ *
+ *  @param dir
+ *    Output directory.
+ *
+ *  @param base_file_name
+ *    File name without the extension of the bookmark file.
+ */
+QDir BookmarkDir(
+    Layout layout,
+    const QDir &dir,
+    const std::string &base_file_name) {
+  std::string shard;
+  switch (layout) {
+    case Layout::FLAT: {
+      return dir;
+    }
+    case Layout::HASH: {
+      shard = HashShard(base_file_name);
+      break;
+    }
+    case Layout::DATE: {
+      const std::time_t t(std::time(nullptr));
+      shard = DateShard(*std::localtime(&t));
+      break;
+    }
+    default: {
+      throw std::logic_error(
+          "Internal error: enumeration is not exhaustive.");
+    }
+  }
+  const QString shard_path(dir.filePath(QString::fromStdString(shard)));
+  if (!QDir().mkpath(shard_path)) {
+    throw std::runtime_error(
+        "Cannot create directory at\n" + shard_path.toStdString());
+  }
+  return QDir(shard_path);
+}
+
+/**
+ *  Pastes a URI as a bookmark file in the URL format with the `.url`
+ *  extension.
+ *
+ *  @param dir
+ *    Directory of the output file.
  *
  *  @param base_file_name
  *    File name without the extension of the output file, or empty string for
- *    the standard output.
+ *    `out`.
  *
  *  @param bookmark_uri
  *    URI to paste.
  *
+ *  @param icon_url
+ *    URL of the icon in the icon cache, or an empty string for none.
+ *
+ *  @param out
+ *    Stream that the bookmark is written to if `base_file_name` is empty.
+ *
  *  @return
- *    Exit status, where `0` indicates success.
+ *    Path to the output file, or empty string if the bookmark is written to
+ *    `out`.
  */
-int PasteUrl(
+std::string PasteUrl(
+    const QDir &dir,
     const std::string &base_file_name,
-    const std::string &bookmark_uri) {
+    const std::string &bookmark_uri,
+    std::ostream &out) {
   std::string url_file_text;
   url_file_text += "[InternetShortcut]\n";
   url_file_text += "URL=" + bookmark_uri + "\n";
   if (base_file_name.empty()) {
-    std::cout << url_file_text << std::endl;
-  } else {
-    const std::string file_name(base_file_name + ".url");
-    QFile out_file(QDir::current().filePath(file_name.data()));
-    const std::string out_file_path(out_file.fileName().toUtf8().constData());
-    if (out_file.exists()) {
-      std::string message;
-      message += "Bookmark with the same file name exists:\n";
-      message += out_file_path;
-      DisplayError(message);
-      return 1;
-    }
-    if (!out_file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-      std::string message;
-      message += "Cannot write bookmark at\n";
-      message += out_file_path;
-      DisplayError(message);
-      return 1;
-    }
-    QTextStream(&out_file) << url_file_text.data();
-#ifdef WIN32
-    try {
-      xbelmark::winshell::FolderView fv(GetForegroundWindow());
-      WinSelectItem(fv, file_name, TIMEOUT_MILLISECONDS);
-    } catch (const std::exception &) {
-    }
-#endif
+    out << url_file_text << std::endl;
+    return "";
   }
-  return 0;
+  const std::string out_file_path(
+      NewBookmarkPath(dir, base_file_name, ".url"));
+  QFile out_file(QString::fromStdString(out_file_path));
+  bool is_written = out_file.open(QIODevice::WriteOnly | QIODevice::Text);
+  if (is_written) {
+    QTextStream out_stream(&out_file);
+    out_stream << url_file_text.data();
+    out_stream.flush();
+    is_written = out_stream.status() == QTextStream::Ok && out_file.flush();
+    out_file.close();
+  }
+  if (!is_written) {
+    // Release the file name that was claimed.
+    QFile::remove(QString::fromStdString(out_file_path));
+    throw std::runtime_error("Cannot write bookmark at\n" + out_file_path);
+  }
+  return out_file_path;
+}
+
+/**
+ *  Current time in the format of the `added` attribute of XBEL.
+ */
+std::string AddedDateTime() {
+  char dt[255];
+  std::time_t t(std::time(nullptr));
+  std::strftime(dt, sizeof(dt), "%FT%T%z", std::localtime(&t));
+  std::string retval(dt);
+  if (retval.back() != 'Z') {
+    retval.insert(retval.size() - 2, 1, ':');
+  }
+  return retval;
+}
+
+void WriteXbelBookmark(
+    xbelmark::xml::Writer &xml_writer,
+    const std::string &html_title,
+    const std::string &html_description,
+    const std::string &bookmark_uri,
+    const std::string &icon_url) {
+  xml_writer.StartElement("bookmark");
+  xml_writer.WriteAttribute("href", bookmark_uri);
+  xml_writer.WriteAttribute("added", AddedDateTime());
+  if (!icon_url.empty()) {
+    xml_writer.WriteAttribute("icon", icon_url);
+  }
+  xml_writer.StartElement("title");
+  xml_writer.WriteString(html_title);
+  xml_writer.EndElement();
+  if (!html_description.empty()) {
+    xml_writer.StartElement("desc");
+    xml_writer.WriteString(html_description);
+    xml_writer.EndElement();
+  }
+  xml_writer.EndElement();
 }
 
 /**
  *  Pastes a URI as a bookmark file in the XBEL format with the `.xbel`
- *  extension in the current working directory.
+ *  extension.
+ *
+ *  @param dir
+ *    Directory of the output file.
  *
  *  @param base_file_name
  *    File name without the extension of the output file, or empty string for
- *    the standard output.
+ *    `out`.
  *
  *  @param html_title
  *    HTML title.
  *
+ *  @param html_description
+ *    Description of the HTML document, or an empty string for none.
+ *
  *  @param bookmark_uri
  *    URI to paste.
  *
+ *  @param icon_url
+ *    URL of the icon in the icon cache, or an empty string for none.
+ *
+ *  @param out
+ *    Stream that the bookmark is written to if `base_file_name` is empty.
+ *
  *  @return
- *    Exit status, where `0` indicates success.
+ *    Path to the output file, or empty string if the bookmark is written to
+ *    `out`.
  */
-int PasteXbel(
+std::string PasteXbel(
+    const QDir &dir,
     const std::string &base_file_name,
     const std::string &html_title,
-    const std::string &bookmark_uri) {
-  const std::string file_name(base_file_name + ".xbel");
-  QFile out_file(QDir::current().filePath(file_name.data()));
-  const std::string out_file_path(out_file.fileName().toUtf8().constData());
-  if (out_file.exists()) {
-    std::string message;
-    message += "Bookmark with the same file name exists:\n";
-    message += out_file_path;
-    DisplayError(message);
-    return 1;
+    const std::string &html_description,
+    const std::string &bookmark_uri,
+    const std::string &icon_url,
+    std::ostream &out) {
+  std::string out_file_path;
+  xmlBufferPtr buffer = nullptr;
+  xmlTextWriterPtr text_writer;
+  if (base_file_name.empty()) {
+    buffer = xmlBufferCreate();
+    text_writer = xmlNewTextWriterMemory(buffer, 0);
+  } else {
+    out_file_path = NewBookmarkPath(dir, base_file_name, ".xbel");
+    text_writer = xmlNewTextWriterFilename(out_file_path.c_str(), 0);
   }
   try {
-    xmlTextWriterPtr text_writer;
-    if (base_file_name.empty()) {
-      text_writer =
-          xmlNewTextWriter(xmlOutputBufferCreateFile(stdout, nullptr));
-    } else {
-      text_writer = xmlNewTextWriterFilename(out_file_path.c_str(), 0);
-    }
     xbelmark::xml::Writer xml_writer(text_writer);
     xml_writer.StartDocument("1.0", "UTF-8", "");
     xml_writer.StartElement("xbel");
     xml_writer.WriteAttribute("version", "1.0");
-    xml_writer.StartElement("bookmark");
-    xml_writer.WriteAttribute("href", bookmark_uri);
-    // Set the added time of the bookmark.
-    {
-      char dt[255];
-      std::time_t t(std::time(nullptr));
-      std::strftime(dt, sizeof(dt), "%FT%T%z", std::localtime(&t));
-      std::string dt_str(dt);
-      if (dt_str.back() != 'Z') {
-        dt_str.insert(dt_str.size() - 2, 1, ':');
-      }
-      xml_writer.WriteAttribute("added", dt_str);
-    }
-    xml_writer.StartElement("title");
-    xml_writer.WriteString(html_title);
-    xml_writer.EndElement();
-    xml_writer.EndElement();
+    WriteXbelBookmark(
+        xml_writer, html_title, html_description, bookmark_uri, icon_url);
     xml_writer.EndElement();
     xml_writer.EndDocument();
-  } catch (const std::exception &e) {
-    DisplayError(e.what());
-    return 1;
-  }
-#ifdef WIN32
-  try {
-    xbelmark::winshell::FolderView fv(GetForegroundWindow());
-    WinSelectItem(fv, file_name, TIMEOUT_MILLISECONDS);
   } catch (const std::exception &) {
+    if (buffer) {
+      xmlBufferFree(buffer);
+    } else {
+      // Release the file name that was claimed.
+      QFile::remove(QString::fromStdString(out_file_path));
+    }
+    throw;
+  }
+  if (buffer) {
+    out.write(
+        reinterpret_cast<const char *>(xmlBufferContent(buffer)),
+        xmlBufferLength(buffer));
+    xmlBufferFree(buffer);
+  }
+  return out_file_path;
+}
+
+QUrl PastedUrl(const CmdArgs &cmd_args) {
+  QUrl url;
+  if (cmd_args.uri.empty()) {
+    const QClipboard &clipboard = *QGuiApplication::clipboard();
+    if (!clipboard.mimeData()->hasText() || clipboard.text().isEmpty()) {
+      throw std::runtime_error("No text in clipboard.");
+    }
+    url = clipboard.text();
+  } else {
+    url = cmd_args.uri.data();
+  }
+  if (!url.isValid() || url.isRelative()) {
+    throw std::runtime_error(
+        "Not a valid URL:\n" + url.toString().toStdString());
+  }
+  return url;
+}
+
+void CompleteRetrievalOptions(CmdArgs &cmd_args) {
+  xbelmark::html::RetrievalOptions &retrieval_options =
+      cmd_args.retrieval_options;
+  if (cmd_args.no_cache) {
+    retrieval_options.cache_dir = "";
+  } else if (retrieval_options.cache_dir.empty()) {
+    retrieval_options.cache_dir =
+        QDir(QStandardPaths::writableLocation(
+                 QStandardPaths::GenericCacheLocation))
+            .filePath("xbelmark/titles").toUtf8().constData();
+  }
+  // Icons are referenced only by XBEL.
+  if (!cmd_args.icons || cmd_args.format != Format::XBEL) {
+    retrieval_options.icon_cache_dir = "";
+  } else if (retrieval_options.icon_cache_dir.empty()) {
+    retrieval_options.icon_cache_dir =
+        xbelmark::html::DefaultIconCacheDir();
+  }
+  // The title alone can be found faster than with the metadata.
+  retrieval_options.metadata =
+      cmd_args.format == Format::XBEL || cmd_args.href == Href::CANONICAL;
+}
+
+/**
+ *  Displays a Qt message box with a warning if the clipboard was read, and
+ *  writes it to the standard error otherwise.
+ */
+void DisplayWarning(const CmdArgs &cmd_args, const std::string &message) {
+  if (cmd_args.uri.empty()) {
+    QMessageBox::warning(nullptr, "Warning", message.data());
+  } else {
+    std::cerr << message << std::endl;
+  }
+}
+
+/**
+ *  Absolute path to a file without `.` or `..` segments, and without symbolic
+ *  links if the file exists.
+ */
+std::string ResolvedPath(const QDir &dir, const std::string &path) {
+  const QFileInfo file_info(dir.absoluteFilePath(QString::fromStdString(path)));
+  const QString canonical_path(file_info.canonicalFilePath());
+  return (canonical_path.isEmpty() ?
+              QDir::cleanPath(file_info.absoluteFilePath()) :
+              canonical_path).toStdString();
+}
+
+bool IsInCollection(
+    const CmdArgs &cmd_args,
+    const QDir &dir,
+    const std::string &file_path) {
+  return !cmd_args.collection_dir.empty() && !file_path.empty() &&
+      IsInDirTree(
+          ResolvedPath(dir, file_path),
+          ResolvedPath(dir, cmd_args.collection_dir));
+}
+
+std::unique_ptr<UrlIndex> OpenUrlIndex(
+    const CmdArgs &cmd_args,
+    const QDir &dir) {
+  if (cmd_args.collection_dir.empty()) {
+    return nullptr;
+  }
+  // Bookmarks that are pending in a journal in the collection are indexed.
+  return std::unique_ptr<UrlIndex>(
+      new UrlIndex(
+          dir.absoluteFilePath(QString::fromStdString(cmd_args.collection_dir))
+              .toStdString(),
+          IsInCollection(cmd_args, dir, cmd_args.journal_path) ?
+              ResolvedPath(dir, cmd_args.journal_path) : ""));
+}
+
+void PrepareCollection(const CmdArgs &cmd_args, UrlIndex *url_index) {
+  if (cmd_args.reindex && url_index) {
+    url_index->Rebuild();
+  }
+}
+
+std::string DuplicateWarning(
+    const CmdArgs &cmd_args,
+    const UrlIndex *url_index,
+    const QUrl &url) {
+  if (cmd_args.duplicates == Duplicates::ALLOW ||
+      !url_index || !url_index->Contains(url)) {
+    return "";
+  }
+  return
+      (cmd_args.duplicates == Duplicates::SKIP ?
+           "Not pasted, since it is already bookmarked:\n" :
+           "Already bookmarked:\n") +
+      url.toString().toStdString();
+}
+
+bool NeedsRetrieval(const CmdArgs &cmd_args) {
+  if (cmd_args.no_fetch) {
+    return false;
+  }
+  if (cmd_args.href != Href::PASTED ||
+      (cmd_args.icons && cmd_args.format == Format::XBEL)) {
+    return true;
+  }
+  // The title is written in an XBEL document and is the file name.
+  return cmd_args.title.empty() &&
+      (cmd_args.format == Format::XBEL || !cmd_args.std_out);
+}
+
+xbelmark::html::Info GivenInfo(const CmdArgs &cmd_args, const QUrl &url) {
+  xbelmark::html::Info retval;
+  retval.url = url;
+  retval.title = cmd_args.title.empty() ?
+      url.toString().toUtf8().toStdString() : cmd_args.title;
+  return retval;
+}
+
+std::string BookmarkUri(
+    const CmdArgs &cmd_args,
+    const xbelmark::html::Info &html_info) {
+  QUrl bookmark_url(html_info.url);
+  if (cmd_args.href != Href::PASTED && html_info.final_url.isValid()) {
+    bookmark_url = html_info.final_url;
+  }
+  if (cmd_args.href == Href::CANONICAL &&
+      html_info.canonical_url.isValid() &&
+      (html_info.canonical_url.scheme() == "http" ||
+       html_info.canonical_url.scheme() == "https")) {
+    bookmark_url = html_info.canonical_url;
+  }
+  return bookmark_url.toString().toUtf8().constData();
+}
+
+/**
+ *  Writes the bookmark of an HTML document to a file, to the journal, or to
+ *  `out`, as `cmd_args` specifies.
+ *
+ *  @return
+ *    Path to the bookmark file, or empty string if the bookmark is written to
+ *    the journal or `out`.
+ */
+std::string WriteBookmarkFile(
+    const CmdArgs &cmd_args,
+    const QDir &dir,
+    const xbelmark::html::Info &html_info,
+    const std::string &bookmark_uri,
+    std::ostream &out) {
+  if (!cmd_args.journal_path.empty()) {
+    xbelmark::journal::Record record;
+    record.href = bookmark_uri;
+    record.title = html_info.title;
+    record.description = html_info.description;
+    record.added = AddedDateTime();
+    record.icon = html_info.icon_url.toString(QUrl::FullyEncoded).toStdString();
+    xbelmark::journal::Append(
+        dir.absoluteFilePath(QString::fromStdString(cmd_args.journal_path))
+            .toStdString(),
+        record);
+    return "";
+  }
+  std::string base_file_name;
+  if (cmd_args.std_out) {
+    base_file_name = "";
+  } else {
+    base_file_name =
+        xbelmark::html::WinTitleName(html_info, cmd_args.spaces ? ' ' : '_');
+  }
+  const QDir out_dir(
+      cmd_args.std_out ?
+          dir : BookmarkDir(cmd_args.layout, dir, base_file_name));
+  switch (cmd_args.format) {
+    case Format::URL: {
+      return PasteUrl(out_dir, base_file_name, bookmark_uri, out);
+    }
+    case Format::XBEL: {
+      return PasteXbel(
+          out_dir,
+          base_file_name,
+          html_info.title,
+          html_info.description,
+          bookmark_uri,
+          html_info.icon_url.toString(QUrl::FullyEncoded).toStdString(),
+          out);
+    }
+    default: {
+      throw std::logic_error(
+          "Internal error: enumeration is not exhaustive.");
+    }
   }
-#endif
-  return 0;
+}
+
+std::string WriteBookmark(
+    const CmdArgs &cmd_args,
+    const QDir &dir,
+    const xbelmark::html::Info &html_info,
+    UrlIndex *url_index,
+    std::ostream &out) {
+  const std::string bookmark_uri(BookmarkUri(cmd_args, html_info));
+  const std::string out_file_path(
+      WriteBookmarkFile(cmd_args, dir, html_info, bookmark_uri, out));
+  // A bookmark that is appended to a journal is indexed as if the journal
+  // were a bookmark file.
+  if (url_index &&
+      IsInCollection(
+          cmd_args,
+          dir,
+          cmd_args.journal_path.empty() ?
+              out_file_path : cmd_args.journal_path)) {
+    url_index->Insert(QUrl(QString::fromStdString(bookmark_uri)));
+  }
+  return out_file_path;
+}
+
+/**
+ *  Has the daemon paste the bookmark.
+ *
+ *  @param exit_status
+ *    Exit status that is set if the daemon is running.
+ *
+ *  @return
+ *    Whether the daemon is running.
+ */
+bool PasteWithDaemon(
+    int argc,
+    char *argv[],
+    const CmdArgs &cmd_args,
+    int &exit_status) {
+  QJsonObject response;
+  std::string error;
+  {
+    // The clipboard is read by the daemon, so no GUI is needed.
+    QCoreApplication core_app(argc, argv);
+    QJsonObject request;
+    request.insert("cwd", QDir::currentPath());
+    QJsonArray args;
+    for (int i = 2; i < argc; ++i) {
+      args.append(QString::fromLocal8Bit(argv[i]));
+    }
+    request.insert("args", args);
+    // Allow the daemon some time beyond the deadline of the retrieval.
+    const long long total_timeout =
+        cmd_args.retrieval_options.total_timeout;
+    int timeout = -1;
+    if (total_timeout > 0) {
+      timeout = static_cast<int>(
+          qMin<long long>(total_timeout + 5000, INT_MAX));
+    }
+    try {
+      if (!xbelmark::daemon::Request(
+              cmd_args.daemon_name.empty() ?
+                  xbelmark::daemon::DefaultServerName() :
+                  QString::fromStdString(cmd_args.daemon_name),
+              request,
+              timeout,
+              response)) {
+        return false;
+      }
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+  }
+  if (error.empty()) {
+    std::cout << response.value("output").toString().toStdString();
+    error = response.value("error").toString().toStdString();
+    exit_status = response.value("status").toInt(1);
+  } else {
+    exit_status = 1;
+  }
+  if (!error.empty()) {
+    if (cmd_args.uri.empty()) {
+      QGuiApplication gui_app(argc, argv);
+      DisplayError(error);
+    } else {
+      std::cerr << error << std::endl;
+    }
+    return true;
+  }
+  const std::string warning(response.value("warning").toString().toStdString());
+  if (!warning.empty()) {
+    std::unique_ptr<QGuiApplication> gui_app(
+        cmd_args.uri.empty() ? new QGuiApplication(argc, argv) : nullptr);
+    DisplayWarning(cmd_args, warning);
+  }
+  const std::string out_file_path(
+      response.value("path").toString().toStdString());
+  if (!out_file_path.empty()) {
+    SelectInFileExplorer(out_file_path);
+  }
+  return true;
 }
 
 int Execute(int argc, char *argv[]) {
-  QGuiApplication gui_app(argc, argv);
-#ifdef WIN32
-  CoInitialize(nullptr);
-#endif
   std::unique_ptr<CmdArgs> cmd_args;
   try {
     cmd_args = CmdArgsParser().Parse(&argv[2], &argv[argc]);
@@ -257,59 +734,86 @@ int Execute(int argc, char *argv[]) {
     std::cout << cmd_args->help << std::endl;
     return 1;
   }
-  QUrl url;
-  if (cmd_args->uri.empty()) {
-    const QClipboard &clipboard = *QGuiApplication::clipboard();
-    if (!clipboard.mimeData()->hasText() || clipboard.text().isEmpty()) {
-      DisplayError("No text in clipboard.");
+  if (cmd_args->bulk) {
+    // The clipboard is read only if no input file is specified.
+    std::unique_ptr<QCoreApplication> app(
+        cmd_args->input_path.empty() ?
+            new QGuiApplication(argc, argv) :
+            new QCoreApplication(argc, argv));
+    try {
+      CompleteRetrievalOptions(*cmd_args);
+      return PasteBulk(*cmd_args);
+    } catch (const std::exception &e) {
+      std::cerr << e.what() << std::endl;
       return 1;
     }
-    url = clipboard.text();
-  } else {
-    url = cmd_args->uri.data();
   }
-  if (!url.isValid() || url.isRelative()) {
-    std::string message;
-    message += "Not a valid URL:\n";
-    message += url.toString().toUtf8().constData();
-    DisplayError(message);
-    return 1;
+  const bool needs_retrieval = NeedsRetrieval(*cmd_args);
+  int exit_status = 0;
+  if (cmd_args->daemon && needs_retrieval &&
+      PasteWithDaemon(argc, argv, *cmd_args, exit_status)) {
+    return exit_status;
   }
-  const std::string bookmark_uri(url.toString().toUtf8().constData());
-  xbelmark::html::InfoRetriever html_info_retriever(url);
-  std::string base_file_name;
-  if (cmd_args->std_out) {
-    base_file_name = "";
-  } else {
-    base_file_name = html_info_retriever.win_title_name();
-    if (!cmd_args->spaces) {
-      base_file_name =
-          std::regex_replace(base_file_name, std::regex("\\s"), "_");
-    }
+  // A display server is needed only to read the clipboard, and an event loop
+  // only to retrieve the HTML document.
+  std::unique_ptr<QCoreApplication> app;
+  if (cmd_args->uri.empty()) {
+    app.reset(new QGuiApplication(argc, argv));
+  } else if (needs_retrieval) {
+    app.reset(new QCoreApplication(argc, argv));
   }
-  int exit_status;
-  switch (cmd_args->format) {
-    case Format::URL: {
-      exit_status = PasteUrl(base_file_name, bookmark_uri);
-      break;
+  std::string out_file_path;
+  std::string warning;
+  try {
+    const QUrl url(PastedUrl(*cmd_args));
+    const std::unique_ptr<UrlIndex> url_index(
+        OpenUrlIndex(*cmd_args, QDir::current()));
+    PrepareCollection(*cmd_args, url_index.get());
+    // The pasted URL is checked before the HTML document is retrieved.
+    warning = DuplicateWarning(*cmd_args, url_index.get(), url);
+    if (!warning.empty() && cmd_args->duplicates == Duplicates::SKIP) {
+      DisplayWarning(*cmd_args, warning);
+      return 0;
     }
-    case Format::XBEL: {
-      exit_status =
-          PasteXbel(base_file_name, html_info_retriever.title(), bookmark_uri);
-      break;
+    xbelmark::html::Info html_info;
+    if (needs_retrieval) {
+      CompleteRetrievalOptions(*cmd_args);
+      xbelmark::html::InfoRetriever html_info_retriever(
+          url, cmd_args->retrieval_options);
+      html_info = html_info_retriever.info();
+      if (!cmd_args->title.empty()) {
+        html_info.title = cmd_args->title;
+      }
+    } else {
+      html_info = GivenInfo(*cmd_args, url);
     }
-    default: {
-      std::cerr <<
-          "Internal error: enumeration is not exhaustive." <<
-          std::endl;
-      exit_status = 1;
-      break;
+    if (warning.empty()) {
+      warning = DuplicateWarning(
+          *cmd_args,
+          url_index.get(),
+          QUrl(QString::fromStdString(BookmarkUri(*cmd_args, html_info))));
+      if (!warning.empty() && cmd_args->duplicates == Duplicates::SKIP) {
+        DisplayWarning(*cmd_args, warning);
+        return 0;
+      }
     }
+    out_file_path = WriteBookmark(
+        *cmd_args, QDir::current(), html_info, url_index.get(), std::cout);
+  } catch (const std::exception &e) {
+    if (cmd_args->uri.empty()) {
+      DisplayError(e.what());
+    } else {
+      std::cerr << e.what() << std::endl;
+    }
+    return 1;
   }
-#ifdef WIN32
-  CoUninitialize();
-#endif
-  return exit_status;
+  if (!warning.empty()) {
+    DisplayWarning(*cmd_args, warning);
+  }
+  if (!out_file_path.empty()) {
+    SelectInFileExplorer(out_file_path);
+  }
+  return 0;
 }
 
 } // namespace paste
@@ -1,6 +1,18 @@
 #ifndef XBELMARK_PASTE_PASTE_H
 #define XBELMARK_PASTE_PASTE_H
 
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <QDir>
+#include <QUrl>
+
+#include "xbelmark/html/info.h"
+#include "xbelmark/paste/cmd_args.h"
+#include "xbelmark/urlindex/url_index.h"
+#include "xbelmark/xml/writer.h"
+
 namespace xbelmark {
 namespace paste {
 
@@ -9,6 +21,174 @@ namespace paste {
  */
 int Execute(int argc, char *argv[]);
 
+/**
+ *  URL to paste, which is the specified URI, or the clipboard text if none
+ *  was specified.
+ *
+ *  A `QGuiApplication` must exist if the clipboard is read.
+ *
+ *  @throw std::runtime_error
+ *    There is no text in the clipboard, or the URL is not valid.
+ */
+QUrl PastedUrl(const CmdArgs &cmd_args);
+
+/**
+ *  Complete the options for retrieving information about the HTML document
+ *  with the defaults that depend on the other command-line arguments.
+ */
+void CompleteRetrievalOptions(CmdArgs &cmd_args);
+
+/**
+ *  Whether the HTML document is retrieved, which is the case only if its
+ *  title or URL after redirects is written.
+ */
+bool NeedsRetrieval(const CmdArgs &cmd_args);
+
+/**
+ *  Information about an HTML document that is given by the command-line
+ *  arguments instead of being retrieved.
+ *
+ *  @param url
+ *    URL to the HTML document.
+ */
+xbelmark::html::Info GivenInfo(const CmdArgs &cmd_args, const QUrl &url);
+
+/**
+ *  Rebuild the index of the collection if `cmd_args` requests it.
+ *
+ *  @param url_index
+ *    Index of the collection, which has been opened with @link OpenUrlIndex
+ *    @endlink, or `nullptr` if no collection is specified.
+ *
+ *  @throw std::runtime_error
+ *    Index cannot be written.
+ */
+void PrepareCollection(
+    const CmdArgs &cmd_args,
+    xbelmark::urlindex::UrlIndex *url_index);
+
+/**
+ *  Index of the URLs in the collection.
+ *
+ *  The index is opened once per paste, or once per bulk run, and is passed
+ *  to the functions that look up or add URLs. If the journal is in the
+ *  collection, its pending records are indexed as well.
+ *
+ *  @param dir
+ *    Directory that a relative path to the collection is resolved against.
+ *
+ *  @return
+ *    Index, or `nullptr` if no collection is specified.
+ */
+std::unique_ptr<xbelmark::urlindex::UrlIndex> OpenUrlIndex(
+    const CmdArgs &cmd_args,
+    const QDir &dir);
+
+/**
+ *  Whether a bookmark file is in the collection, so that its bookmarks
+ *  belong in the index of the collection.
+ *
+ *  @param dir
+ *    Directory that relative paths to the collection and to the bookmark
+ *    file are resolved against.
+ *
+ *  @param file_path
+ *    Path to the bookmark file, or an empty string for none.
+ */
+bool IsInCollection(
+    const CmdArgs &cmd_args,
+    const QDir &dir,
+    const std::string &file_path);
+
+/**
+ *  Warning about a URL that is already bookmarked in the collection, whose
+ *  index has been opened with @link OpenUrlIndex @endlink.
+ *
+ *  @param url_index
+ *    Index of the collection, or `nullptr` if no collection is specified.
+ *
+ *  @return
+ *    Warning, or an empty string if no collection is specified, duplicates
+ *    are allowed, or the URL is not bookmarked.
+ *
+ *  @throw std::runtime_error
+ *    Index of the collection cannot be built.
+ */
+std::string DuplicateWarning(
+    const CmdArgs &cmd_args,
+    const xbelmark::urlindex::UrlIndex *url_index,
+    const QUrl &url);
+
+/**
+ *  URI that is written as the target of the bookmark of an HTML document.
+ */
+std::string BookmarkUri(
+    const CmdArgs &cmd_args,
+    const xbelmark::html::Info &html_info);
+
+/**
+ *  Writes a `bookmark` element of an XBEL document that is added now.
+ *
+ *  @param xml_writer
+ *    Writer of the XBEL document, which is within the parent element of the
+ *    bookmark.
+ *
+ *  @param html_title
+ *    HTML title.
+ *
+ *  @param html_description
+ *    Description of the HTML document, or an empty string for none.
+ *
+ *  @param bookmark_uri
+ *    URI that the bookmark specifies.
+ *
+ *  @param icon_url
+ *    URL of the icon in the icon cache, or an empty string for none.
+ */
+void WriteXbelBookmark(
+    xbelmark::xml::Writer &xml_writer,
+    const std::string &html_title,
+    const std::string &html_description,
+    const std::string &bookmark_uri,
+    const std::string &icon_url);
+
+/**
+ *  Writes the bookmark of an HTML document.
+ *
+ *  @param cmd_args
+ *    Command-line arguments of the `paste` subcommand.
+ *
+ *  @param dir
+ *    Directory of the bookmark file, which relative paths to the journal and
+ *    the collection are also resolved against. The bookmark is added to the
+ *    index of the collection only if the bookmark file, or the journal that
+ *    it is appended to, is in the collection.
+ *
+ *  @param html_info
+ *    Information about the HTML document.
+ *
+ *  @param url_index
+ *    Index of the collection, which has been opened with @link OpenUrlIndex
+ *    @endlink, or `nullptr` if no collection is specified.
+ *
+ *  @param out
+ *    Stream that the bookmark is written to if `cmd_args` specifies the
+ *    standard output.
+ *
+ *  @return
+ *    Path to the bookmark file, or empty string if the bookmark is written to
+ *    `out` or appended to a journal.
+ *
+ *  @throw std::runtime_error
+ *    Bookmark file exists, or the bookmark cannot be written.
+ */
+std::string WriteBookmark(
+    const CmdArgs &cmd_args,
+    const QDir &dir,
+    const xbelmark::html::Info &html_info,
+    xbelmark::urlindex::UrlIndex *url_index,
+    std::ostream &out);
+
 } // namespace paste
 } // namespace xbelmark
 
@@ -0,0 +1,52 @@
+#ifndef XBELMARK_PASTE_URL_LIST_H
+#define XBELMARK_PASTE_URL_LIST_H
+
+#include <cctype>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  URLs in a list with one URL per line.
+ *
+ *  Surrounding whitespace is removed from each line. Empty lines, and lines
+ *  that begin with `#`, are skipped.
+ *
+ *  @param text
+ *    List of URLs, where lines end with LF or CRLF.
+ *
+ *  @return
+ *    URLs in the order that they are listed.
+ */
+inline std::vector<std::string> UrlLines(const std::string &text) {
+  std::vector<std::string> retval;
+  std::size_t first = 0;
+  while (first < text.size()) {
+    std::size_t last = text.find('\n', first);
+    if (last == std::string::npos) {
+      last = text.size();
+    }
+    std::size_t next = last + 1;
+    while (first != last &&
+           std::isspace(static_cast<unsigned char>(text[first]))) {
+      ++first;
+    }
+    while (last != first &&
+           std::isspace(static_cast<unsigned char>(text[last - 1]))) {
+      --last;
+    }
+    if (first != last && text[first] != '#') {
+      retval.push_back(text.substr(first, last - first));
+    }
+    first = next;
+  }
+  return retval;
+}
+
+} // namespace paste
+} // namespace xbelmark
+
+#endif
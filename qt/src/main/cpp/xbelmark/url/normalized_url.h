@@ -0,0 +1,156 @@
+#ifndef XBELMARK_URL_NORMALIZED_URL_H
+#define XBELMARK_URL_NORMALIZED_URL_H
+
+#include <cctype>
+#include <cstddef>
+#include <string>
+
+namespace xbelmark {
+namespace url {
+
+/**
+ *  Whether a character is unreserved in a URL, so that its percent-encoding
+ *  is equivalent to the character itself.
+ */
+inline bool IsUnreservedUrlChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) ||
+      c == '-' || c == '.' || c == '_' || c == '~';
+}
+
+/**
+ *  Component of a URL with the percent-encodings of unreserved characters
+ *  decoded and the hexadecimal digits of the other percent-encodings in
+ *  uppercase.
+ */
+inline std::string NormalizedPercentEncoding(const std::string &component) {
+  std::string retval;
+  retval.reserve(component.size());
+  for (std::size_t i = 0; i != component.size(); ++i) {
+    if (component[i] != '%' || i + 2 >= component.size() ||
+        !std::isxdigit(static_cast<unsigned char>(component[i + 1])) ||
+        !std::isxdigit(static_cast<unsigned char>(component[i + 2]))) {
+      retval += component[i];
+      continue;
+    }
+    const char decoded = static_cast<char>(
+        std::stoi(component.substr(i + 1, 2), nullptr, 16));
+    if (IsUnreservedUrlChar(decoded)) {
+      retval += decoded;
+    } else {
+      retval += '%';
+      retval += static_cast<char>(
+          std::toupper(static_cast<unsigned char>(component[i + 1])));
+      retval += static_cast<char>(
+          std::toupper(static_cast<unsigned char>(component[i + 2])));
+    }
+    i += 2;
+  }
+  return retval;
+}
+
+/**
+ *  Path of a URL with the dot segments removed as in RFC 3986.
+ */
+inline std::string PathWithoutDotSegments(std::string path) {
+  std::string retval;
+  while (!path.empty()) {
+    if (path.compare(0, 3, "../") == 0) {
+      path.erase(0, 3);
+    } else if (path.compare(0, 2, "./") == 0) {
+      path.erase(0, 2);
+    } else if (path.compare(0, 3, "/./") == 0) {
+      path.erase(0, 2);
+    } else if (path == "/.") {
+      path = "/";
+    } else if (path.compare(0, 4, "/../") == 0 || path == "/..") {
+      path = path.size() == 3 ? "/" : path.substr(3);
+      const std::size_t slash_pos = retval.rfind('/');
+      retval.erase(slash_pos == std::string::npos ? 0 : slash_pos);
+    } else if (path == "." || path == "..") {
+      path.clear();
+    } else {
+      const std::size_t end_pos = path.find('/', 1);
+      retval += path.substr(0, end_pos);
+      path.erase(0, end_pos == std::string::npos ? path.size() : end_pos);
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Normalized form of an absolute URL for use as a key.
+ *
+ *  The scheme and host are in lowercase, the port is removed if it is empty
+ *  or the default port of the scheme, an empty path is replaced with `/`,
+ *  dot segments are removed from the path, percent-encodings are normalized
+ *  as in @link NormalizedPercentEncoding @endlink, and the fragment is
+ *  removed. A trailing slash is significant and is kept.
+ *
+ *  @param url
+ *    Encoded URL to normalize.
+ *
+ *  @return
+ *    Normalized URL.
+ */
+inline std::string NormalizedUrl(const std::string &url) {
+  const std::string unfragmented(url.substr(0, url.find('#')));
+  const std::size_t colon_pos = unfragmented.find(':');
+  if (colon_pos == std::string::npos) {
+    return NormalizedPercentEncoding(unfragmented);
+  }
+  std::string scheme(unfragmented.substr(0, colon_pos));
+  for (char &c : scheme) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  std::string rest(unfragmented.substr(colon_pos + 1));
+  std::string authority;
+  const bool has_authority = rest.compare(0, 2, "//") == 0;
+  if (has_authority) {
+    const std::size_t end_pos = rest.find_first_of("/?", 2);
+    authority = rest.substr(2, end_pos - 2);
+    rest.erase(0, end_pos == std::string::npos ? rest.size() : end_pos);
+    // Only the host is case-insensitive.
+    const std::size_t at_pos = authority.rfind('@');
+    const std::size_t host_pos = at_pos == std::string::npos ? 0 : at_pos + 1;
+    std::size_t port_pos = authority.rfind(':');
+    if (port_pos != std::string::npos &&
+        (port_pos < host_pos ||
+         authority.find(']', port_pos) != std::string::npos)) {
+      port_pos = std::string::npos;
+    }
+    const std::string port(
+        port_pos == std::string::npos ? "" : authority.substr(port_pos + 1));
+    std::string host(
+        authority.substr(host_pos, port_pos == std::string::npos ?
+            std::string::npos : port_pos - host_pos));
+    for (char &c : host) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    const bool is_default_port = port.empty() ||
+        (scheme == "http" && port == "80") ||
+        (scheme == "https" && port == "443");
+    authority = NormalizedPercentEncoding(authority.substr(0, host_pos)) +
+        host + (is_default_port ? "" : ":" + port);
+  }
+  const std::size_t query_pos = rest.find('?');
+  std::string path(
+      PathWithoutDotSegments(
+          NormalizedPercentEncoding(rest.substr(0, query_pos))));
+  if (has_authority && path.empty()) {
+    path = "/";
+  }
+  std::string retval(scheme + ":");
+  if (has_authority) {
+    retval += "//" + authority;
+  }
+  retval += path;
+  if (query_pos != std::string::npos) {
+    retval += NormalizedPercentEncoding(rest.substr(query_pos));
+  }
+  return retval;
+}
+
+} // namespace url
+} // namespace xbelmark
+
+#endif
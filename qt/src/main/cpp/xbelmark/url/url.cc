@@ -0,0 +1,16 @@
+#include "xbelmark/url/url.h"
+
+#include <QString>
+
+#include "xbelmark/url/normalized_url.h"
+
+namespace xbelmark {
+namespace url {
+
+std::string NormalizedUrl(const QUrl &url) {
+  return NormalizedUrl(
+      std::string(url.toString(QUrl::FullyEncoded).toUtf8().constData()));
+}
+
+} // namespace url
+} // namespace xbelmark
@@ -0,0 +1,28 @@
+#ifndef XBELMARK_URL_URL_H
+#define XBELMARK_URL_URL_H
+
+#include <string>
+
+#include <QUrl>
+
+namespace xbelmark {
+namespace url {
+
+/**
+ *  Normalized form of a URL for use as a key.
+ *
+ *  It is the fully encoded form of the URL that is normalized as in @link
+ *  NormalizedUrl(const std::string &) @endlink.
+ *
+ *  @param url
+ *    URL to normalize.
+ *
+ *  @return
+ *    Fully encoded form of the normalized URL.
+ */
+std::string NormalizedUrl(const QUrl &url);
+
+} // namespace url
+} // namespace xbelmark
+
+#endif
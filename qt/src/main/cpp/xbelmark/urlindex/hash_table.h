@@ -0,0 +1,90 @@
+#ifndef XBELMARK_URLINDEX_HASH_TABLE_H
+#define XBELMARK_URLINDEX_HASH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace xbelmark {
+namespace urlindex {
+
+/**
+ *  64-bit FNV-1a hash of a normalized URL, which is never `0` so that `0` can
+ *  mark an empty slot.
+ */
+inline std::uint64_t UrlHash(const std::string &normalized_url) {
+  std::uint64_t retval = UINT64_C(0xCBF29CE484222325);
+  for (char ch : normalized_url) {
+    retval ^= static_cast<unsigned char>(ch);
+    retval *= UINT64_C(0x100000001B3);
+  }
+  return retval == 0 ? 1 : retval;
+}
+
+/**
+ *  Whether an open-addressing hash table with linear probing contains a hash.
+ *
+ *  @param slots
+ *    Slots of the hash table, where `0` is an empty slot.
+ *
+ *  @param capacity
+ *    Number of slots, which is a power of two.
+ *
+ *  @param hash
+ *    Hash from @link UrlHash @endlink.
+ */
+inline bool ContainsHash(
+    const std::uint64_t *slots,
+    std::size_t capacity,
+    std::uint64_t hash) {
+  const std::size_t mask = capacity - 1;
+  for (std::size_t i = hash & mask, n = 0; n != capacity;
+       i = (i + 1) & mask, ++n) {
+    if (slots[i] == hash) {
+      return true;
+    }
+    if (slots[i] == 0) {
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+ *  Insert a hash into an open-addressing hash table with linear probing.
+ *
+ *  @param slots
+ *    Slots of the hash table, where `0` is an empty slot.
+ *
+ *  @param capacity
+ *    Number of slots, which is a power of two.
+ *
+ *  @param hash
+ *    Hash from @link UrlHash @endlink.
+ *
+ *  @return
+ *    Whether the hash was inserted, which is not the case if it was already
+ *    in the hash table or the hash table is full.
+ */
+inline bool InsertHash(
+    std::uint64_t *slots,
+    std::size_t capacity,
+    std::uint64_t hash) {
+  const std::size_t mask = capacity - 1;
+  for (std::size_t i = hash & mask, n = 0; n != capacity;
+       i = (i + 1) & mask, ++n) {
+    if (slots[i] == hash) {
+      return false;
+    }
+    if (slots[i] == 0) {
+      slots[i] = hash;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace urlindex
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,351 @@
+#include "xbelmark/urlindex/url_index.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QIODevice>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QString>
+#include <QStringList>
+#include <libxml/xmlreader.h>
+
+#include "xbelmark/journal/journal.h"
+#include "xbelmark/url/url.h"
+#include "xbelmark/urlindex/hash_table.h"
+
+/**
+ *  Name of the index file at the root of the directory tree.
+ */
+#define INDEX_FILE_NAME ".xbelmark-index"
+
+/**
+ *  Time in milliseconds to wait for another process to update the index.
+ */
+#define LOCK_TIMEOUT_MILLISECONDS 30000
+
+using xbelmark::url::NormalizedUrl;
+
+namespace xbelmark {
+namespace urlindex {
+
+class UrlIndex::Impl final {
+ public:
+  /**
+   *  Header of the index file, which is followed by the slots of the hash
+   *  table.
+   */
+  struct Header {
+    char magic[8];
+
+    /**
+     *  Number of slots, which is a power of two.
+     */
+    std::uint64_t capacity;
+
+    /**
+     *  Number of slots that are not empty.
+     */
+    std::uint64_t count;
+
+    std::uint64_t reserved;
+  };
+
+  /**
+   *  Identifier of the format of the index file.
+   */
+  static constexpr char kMagic[8] = {
+    'X', 'B', 'M', 'I', 'D', 'X', '0', '1'
+  };
+
+  /**
+   *  Map the index file.
+   *
+   *  @param file
+   *    Index file, which is mapped until it is closed.
+   *
+   *  @return
+   *    Header of the index file, or `nullptr` if it does not exist or is not
+   *    valid.
+   */
+  static Header *Map(QFile &file, QIODevice::OpenMode mode) {
+    if (!file.open(mode)) {
+      return nullptr;
+    }
+    const qint64 size = file.size();
+    if (size < static_cast<qint64>(sizeof(Header))) {
+      return nullptr;
+    }
+    uchar *data = file.map(0, size);
+    if (!data) {
+      return nullptr;
+    }
+    Header *header = reinterpret_cast<Header *>(data);
+    const std::uint64_t capacity = header->capacity;
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+        capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        static_cast<std::uint64_t>(size) !=
+            sizeof(Header) + capacity * sizeof(std::uint64_t)) {
+      return nullptr;
+    }
+    return header;
+  }
+
+  /**
+   *  Slots of the hash table that follow a header.
+   */
+  static std::uint64_t *Slots(Header *header) {
+    return reinterpret_cast<std::uint64_t *>(header + 1);
+  }
+
+  /**
+   *  Hash of a URL, or `0` if it is not an absolute URL.
+   */
+  static std::uint64_t HashOf(const QUrl &url) {
+    if (!url.isValid() || url.isRelative()) {
+      return 0;
+    }
+    return UrlHash(NormalizedUrl(url));
+  }
+
+  QString IndexPath() const {
+    return root_dir_.filePath(INDEX_FILE_NAME);
+  }
+
+  /**
+   *  Add the hashes of the URLs in a `.url` file.
+   */
+  static void ReadUrlFile(
+      const QString &path,
+      std::vector<std::uint64_t> &hashes) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+      return;
+    }
+    while (!file.atEnd()) {
+      const QByteArray line(file.readLine().trimmed());
+      if (line.size() > 4 && qstrnicmp(line.constData(), "URL=", 4) == 0) {
+        const std::uint64_t hash =
+            HashOf(QUrl(QString::fromUtf8(line.mid(4))));
+        if (hash != 0) {
+          hashes.push_back(hash);
+        }
+      }
+    }
+  }
+
+  /**
+   *  Add the hashes of the URLs of the bookmarks in an `.xbel` file, which is
+   *  read as a stream.
+   */
+  static void ReadXbelFile(
+      const QString &path,
+      std::vector<std::uint64_t> &hashes) {
+    xmlTextReaderPtr reader = xmlReaderForFile(
+        QFile::encodeName(path).constData(),
+        nullptr,
+        XML_PARSE_NONET | XML_PARSE_NOERROR | XML_PARSE_NOWARNING);
+    if (!reader) {
+      return;
+    }
+    while (xmlTextReaderRead(reader) == 1) {
+      if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT ||
+          !xmlStrEqual(
+              xmlTextReaderConstLocalName(reader),
+              reinterpret_cast<const xmlChar *>("bookmark"))) {
+        continue;
+      }
+      xmlChar *href = xmlTextReaderGetAttribute(
+          reader, reinterpret_cast<const xmlChar *>("href"));
+      if (href) {
+        const std::uint64_t hash = HashOf(
+            QUrl(QString::fromUtf8(reinterpret_cast<const char *>(href))));
+        if (hash != 0) {
+          hashes.push_back(hash);
+        }
+        xmlFree(href);
+      }
+    }
+    xmlFreeTextReader(reader);
+  }
+
+  /**
+   *  Hashes of the URLs bookmarked in the directory tree, and in the records
+   *  of the journal that have not been compacted into an XBEL document yet.
+   */
+  std::vector<std::uint64_t> ScanHashes() const {
+    std::vector<std::uint64_t> retval;
+    QDirIterator it(
+        root_dir_.path(),
+        QStringList({ "*.xbel", "*.url" }),
+        QDir::Files,
+        QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+      const QString path(it.next());
+      if (path.endsWith(".url", Qt::CaseInsensitive)) {
+        ReadUrlFile(path, retval);
+      } else {
+        ReadXbelFile(path, retval);
+      }
+    }
+    if (!journal_path_.empty()) {
+      for (const xbelmark::journal::Record &record :
+           xbelmark::journal::PendingRecords(journal_path_)) {
+        const std::uint64_t hash =
+            HashOf(QUrl(QString::fromStdString(record.href)));
+        if (hash != 0) {
+          retval.push_back(hash);
+        }
+      }
+    }
+    return retval;
+  }
+
+  /**
+   *  Replace the index file atomically with one of the given hashes, whose
+   *  hash table is at most half full.
+   *
+   *  @return
+   *    Number of distinct hashes.
+   */
+  std::size_t Write(const std::vector<std::uint64_t> &hashes) const {
+    std::size_t capacity = 1024;
+    while (capacity < 2 * hashes.size()) {
+      capacity *= 2;
+    }
+    std::vector<std::uint64_t> slots(capacity, 0);
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.capacity = capacity;
+    for (std::uint64_t hash : hashes) {
+      if (InsertHash(slots.data(), capacity, hash)) {
+        ++header.count;
+      }
+    }
+    QSaveFile file(IndexPath());
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header)) !=
+            static_cast<qint64>(sizeof(header)) ||
+        file.write(
+            reinterpret_cast<const char *>(slots.data()),
+            capacity * sizeof(std::uint64_t)) !=
+            static_cast<qint64>(capacity * sizeof(std::uint64_t)) ||
+        !file.commit()) {
+      throw std::runtime_error(
+          "Cannot write the URL index at\n" + IndexPath().toStdString());
+    }
+    return header.count;
+  }
+
+  /**
+   *  Lock the index for an update.
+   */
+  void Lock(QLockFile &lock_file) const {
+    if (!lock_file.tryLock(LOCK_TIMEOUT_MILLISECONDS)) {
+      throw std::runtime_error(
+          "Cannot lock the URL index at\n" + IndexPath().toStdString());
+    }
+  }
+
+  QDir root_dir_;
+
+  std::string journal_path_;
+};
+
+constexpr char UrlIndex::Impl::kMagic[8];
+
+UrlIndex::UrlIndex(
+    const std::string &root_dir_path,
+    const std::string &journal_path) : p_impl_(new Impl()) {
+  p_impl_->root_dir_ = QDir(QString::fromStdString(root_dir_path));
+  p_impl_->journal_path_ = journal_path;
+}
+
+UrlIndex::~UrlIndex() = default;
+
+bool UrlIndex::Contains(const QUrl &url) const {
+  const std::uint64_t hash = Impl::HashOf(url);
+  if (hash == 0) {
+    return false;
+  }
+  {
+    QFile file(p_impl_->IndexPath());
+    Impl::Header *header = Impl::Map(file, QIODevice::ReadOnly);
+    if (header) {
+      return ContainsHash(Impl::Slots(header), header->capacity, hash);
+    }
+  }
+  // Build the index, unless another process has built it meanwhile.
+  QLockFile lock_file(p_impl_->IndexPath() + ".lock");
+  p_impl_->Lock(lock_file);
+  QFile file(p_impl_->IndexPath());
+  Impl::Header *header = Impl::Map(file, QIODevice::ReadOnly);
+  if (header) {
+    return ContainsHash(Impl::Slots(header), header->capacity, hash);
+  }
+  file.close();
+  const std::vector<std::uint64_t> hashes(p_impl_->ScanHashes());
+  p_impl_->Write(hashes);
+  for (std::uint64_t scanned_hash : hashes) {
+    if (scanned_hash == hash) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void UrlIndex::Insert(const QUrl &url) {
+  const std::uint64_t hash = Impl::HashOf(url);
+  if (hash == 0) {
+    return;
+  }
+  QLockFile lock_file(p_impl_->IndexPath() + ".lock");
+  p_impl_->Lock(lock_file);
+  QFile file(p_impl_->IndexPath());
+  Impl::Header *header = Impl::Map(file, QIODevice::ReadWrite);
+  if (!header) {
+    // The bookmark has been written, so the scan finds it.
+    file.close();
+    std::vector<std::uint64_t> hashes(p_impl_->ScanHashes());
+    hashes.push_back(hash);
+    p_impl_->Write(hashes);
+    return;
+  }
+  std::uint64_t *slots = Impl::Slots(header);
+  if (ContainsHash(slots, header->capacity, hash)) {
+    return;
+  }
+  if (2 * (header->count + 1) <= header->capacity) {
+    InsertHash(slots, header->capacity, hash);
+    ++header->count;
+    return;
+  }
+  // Grow the hash table.
+  std::vector<std::uint64_t> hashes;
+  hashes.reserve(header->count + 1);
+  for (std::uint64_t i = 0; i != header->capacity; ++i) {
+    if (slots[i] != 0) {
+      hashes.push_back(slots[i]);
+    }
+  }
+  hashes.push_back(hash);
+  file.close();
+  p_impl_->Write(hashes);
+}
+
+std::size_t UrlIndex::Rebuild() {
+  QLockFile lock_file(p_impl_->IndexPath() + ".lock");
+  p_impl_->Lock(lock_file);
+  return p_impl_->Write(p_impl_->ScanHashes());
+}
+
+} // namespace urlindex
+} // namespace xbelmark
@@ -0,0 +1,79 @@
+#ifndef XBELMARK_URLINDEX_URL_INDEX_H
+#define XBELMARK_URLINDEX_URL_INDEX_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <QUrl>
+
+namespace xbelmark {
+namespace urlindex {
+
+/**
+ *  Persistent index of the URLs bookmarked in a directory tree of `.xbel` and
+ *  `.url` files.
+ *
+ *  The index is a file at the root of the directory tree that holds an
+ *  open-addressing hash table of the 64-bit hashes of normalized URLs. It is
+ *  memory-mapped, so a lookup reads a few slots regardless of the number of
+ *  URLs. Since only hashes are stored, a lookup can have a false positive
+ *  with negligible probability.
+ *
+ *  The index is built by scanning the directory tree, and the pending records
+ *  of a journal in it, when it does not exist, and is updated incrementally
+ *  as bookmarks are added. Bookmarks that are
+ *  removed stay in the index until it is rebuilt. Updates by different
+ *  processes are serialized by a lock file, while lookups take no lock.
+ */
+class UrlIndex final {
+ public:
+  /**
+   *  @param root_dir_path
+   *    Path to the root of the directory tree of bookmark files.
+   *
+   *  @param journal_path
+   *    Path to a journal in the directory tree whose records have not been
+   *    compacted yet, or an empty string for none.
+   */
+  UrlIndex(const std::string &root_dir_path, const std::string &journal_path);
+
+  ~UrlIndex();
+
+  /**
+   *  Whether a URL is bookmarked.
+   *
+   *  @throw std::runtime_error
+   *    Index cannot be built.
+   */
+  bool Contains(const QUrl &url) const;
+
+  /**
+   *  Add a URL that has been bookmarked.
+   *
+   *  @throw std::runtime_error
+   *    Index cannot be updated.
+   */
+  void Insert(const QUrl &url);
+
+  /**
+   *  Rebuild the index from the bookmark files and the journal.
+   *
+   *  @return
+   *    Number of distinct URLs in the index.
+   *
+   *  @throw std::runtime_error
+   *    Index cannot be written.
+   */
+  std::size_t Rebuild();
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+} // namespace urlindex
+} // namespace xbelmark
+
+#endif
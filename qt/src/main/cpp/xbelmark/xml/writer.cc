@@ -82,5 +82,11 @@ void Writer::EndDocument() {
   }
 }
 
+void Writer::Flush() {
+  if (xmlTextWriterFlush(p_impl_->writer_) == -1) {
+    throw std::runtime_error("Cannot flush the XML document.");
+  }
+}
+
 } // namespace xml
 } // namespace xbelmark
@@ -49,6 +49,11 @@ class Writer final {
 
   void EndDocument();
 
+  /**
+   *  Writes the buffered output to its destination.
+   */
+  void Flush();
+
  private:
   class Impl;
 
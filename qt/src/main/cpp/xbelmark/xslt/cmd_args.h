@@ -3,6 +3,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "xbelmark/cmd_args.h"
 
@@ -20,14 +21,48 @@ struct CmdArgs : public xbelmark::CmdArgs {
   std::map<std::string, std::string> xslt_params;
 
   /**
-   *  Path to the XSL stylesheet.
+   *  Paths to the XSL stylesheets.
+   *
+   *  Several stylesheets are applied to a single input document, with an
+   *  output document for each.
    */
-  std::string stylesheet_path;
+  std::vector<std::string> stylesheet_paths;
 
   /**
-   *  Path to the input document.
+   *  Paths to the input documents.
    */
-  std::string input_doc_path;
+  std::vector<std::string> input_doc_paths;
+
+  /**
+   *  Paths to the output documents in the order of the input documents, or
+   *  none for writing the output document of a single input document to the
+   *  standard output.
+   */
+  std::vector<std::string> output_doc_paths;
+
+  /**
+   *  Path to the manifest of input and output documents, or an empty string
+   *  if there is none.
+   */
+  std::string manifest_path;
+
+  /**
+   *  Maximum number of documents transformed at a time, or `0` for the
+   *  number of hardware threads.
+   */
+  int jobs = 0;
+
+  /**
+   *  Whether the profile of the templates, extension functions, and phases
+   *  is printed to the standard error as JSON.
+   */
+  bool profile = false;
+
+  /**
+   *  Path to the directory of the icon cache that icons are embedded from, or
+   *  an empty string for the default.
+   */
+  std::string icon_cache_dir;
 };
 
 } // namespace xslt
@@ -1,5 +1,6 @@
 #include "xbelmark/xslt/cmd_args_parser.h"
 
+#include <cstddef>
 #include <regex>
 #include <stdexcept>
 #include <utility>
@@ -35,19 +36,60 @@ class CmdArgsParser::Impl final {
         "Usage: " +
         cmd_args_->command_name + " " + cmd_args_->subcommand_name +
         " [options]\n\n" +
-        "Transform XBEL into XHTML5.\n\n";
+        "Transform XBEL into XHTML5.\n\n" +
+        "The stylesheet is compiled once, and multiple input documents\n" +
+        "are transformed in parallel. With several stylesheets, a single\n" +
+        "input document is parsed once, and the stylesheets are applied\n" +
+        "to it in parallel.\n\n";
     help = help +
         "  --xsl [xsl]\n" +
         "\n" +
-        "      Path to the XSL stylesheet.\n\n";
+        "      Path to the XSL stylesheet. It can be repeated with an\n" +
+        "      `--out` for each, in which case only one `--in` can be\n" +
+        "      specified.\n\n";
     help = help +
         "  --in [in]\n" +
         "\n" +
-        "      Path to the input document.\n\n";
+        "      Path to an input document. It can be repeated.\n\n";
+    help = help +
+        "  --out [out]\n" +
+        "\n" +
+        "      Path to the output document of the input document, or of the\n" +
+        "      stylesheet if there are several, in the same position. It\n" +
+        "      can be repeated, and it is required for multiple input\n" +
+        "      documents or stylesheets. If not specified, the output\n" +
+        "      document is written to the standard output.\n\n";
+    help = help +
+        "  --manifest [manifest]\n" +
+        "\n" +
+        "      Path to a file with the path to an input document and the\n" +
+        "      path to its output document, separated by a tab, on each\n" +
+        "      line. Empty lines and lines that begin with `#` are\n" +
+        "      skipped.\n\n";
+    help = help +
+        "  --jobs [jobs]\n" +
+        "\n" +
+        "      Maximum number of documents transformed, or of stylesheets\n" +
+        "      applied, at a time. If not specified, it is the number of\n" +
+        "      hardware threads.\n\n";
+    help = help +
+        "  --profile\n" +
+        "\n" +
+        "      Print the time of each phase, the calls and time of each\n" +
+        "      template and extension function, and the number of\n" +
+        "      documents to the standard error as JSON. Documents are\n" +
+        "      transformed one at a time, since libxslt counts the calls of\n" +
+        "      templates in the stylesheet that is shared.\n\n";
     help = help +
         "  --param [name] [value]\n" +
         "\n" +
         "      Name and value of a parameter.\n\n";
+    help = help +
+        "  --icon-cache [dir]\n" +
+        "\n" +
+        "      Directory of the icon cache that the icons of bookmarks are\n" +
+        "      embedded from. If not specified, `xbelmark/icons` under the\n" +
+        "      cache location of the user is used if it exists.\n\n";
     help = help +
         "  --help, -h\n" +
         "\n" +
@@ -55,19 +97,87 @@ class CmdArgsParser::Impl final {
   }
 
   /**
-   *  Set the path to the XSL stylesheet.
+   *  Append the path to an XSL stylesheet.
    */
-  void SetStylesheetPath() {
+  void AppendStylesheetPath() {
     ++arg_it_;
-    cmd_args_->stylesheet_path = *arg_it_++;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--xsl`.");
+    }
+    cmd_args_->stylesheet_paths.push_back(*arg_it_++);
   }
 
   /**
-   *  Set the path to the input document.
+   *  Append the path to an input document.
    */
-  void SetInputDocPath() {
+  void AppendInputDocPath() {
     ++arg_it_;
-    cmd_args_->input_doc_path = *arg_it_++;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--in`.");
+    }
+    cmd_args_->input_doc_paths.push_back(*arg_it_++);
+  }
+
+  /**
+   *  Append the path to an output document.
+   */
+  void AppendOutputDocPath() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--out`.");
+    }
+    cmd_args_->output_doc_paths.push_back(*arg_it_++);
+  }
+
+  /**
+   *  Set the path to the manifest.
+   */
+  void SetManifestPath() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--manifest`.");
+    }
+    cmd_args_->manifest_path = *arg_it_++;
+  }
+
+  /**
+   *  Set the maximum number of documents transformed at a time.
+   */
+  void SetJobs() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--jobs`.");
+    }
+    const std::string arg(*arg_it_++);
+    std::size_t num_chars = 0;
+    long long jobs = 0;
+    try {
+      jobs = std::stoll(arg, &num_chars);
+    } catch (const std::exception &) {
+    }
+    if (jobs < 1 || jobs > 256 || num_chars != arg.size()) {
+      throw std::runtime_error("Invalid argument for `--jobs`: " + arg);
+    }
+    cmd_args_->jobs = static_cast<int>(jobs);
+  }
+
+  /**
+   *  Set that the transformations are profiled.
+   */
+  void SetProfile() {
+    ++arg_it_;
+    cmd_args_->profile = true;
+  }
+
+  /**
+   *  Set the directory of the icon cache.
+   */
+  void SetIconCacheDir() {
+    ++arg_it_;
+    if (arg_it_ == arg_last_) {
+      throw std::runtime_error("Insufficient arguments for `--icon-cache`.");
+    }
+    cmd_args_->icon_cache_dir = *arg_it_++;
   }
 
   /**
@@ -123,11 +233,21 @@ std::unique_ptr<CmdArgs> CmdArgsParser::Parse(char **first, char **last) {
       if (opt == "--help" || opt == "-h") {
         p_impl_->SetHelpMessage();
       } else if (opt == "--xsl") {
-        p_impl_->SetStylesheetPath();
+        p_impl_->AppendStylesheetPath();
       } else if (opt == "--in") {
-        p_impl_->SetInputDocPath();
+        p_impl_->AppendInputDocPath();
+      } else if (opt == "--out") {
+        p_impl_->AppendOutputDocPath();
+      } else if (opt == "--manifest") {
+        p_impl_->SetManifestPath();
+      } else if (opt == "--jobs") {
+        p_impl_->SetJobs();
+      } else if (opt == "--profile") {
+        p_impl_->SetProfile();
       } else if (opt == "--param") {
         p_impl_->AppendParam();
+      } else if (opt == "--icon-cache") {
+        p_impl_->SetIconCacheDir();
       } else if (opt.front() == '-') {
         throw std::runtime_error("Unrecognized option: " + opt);
       } else {
@@ -138,13 +258,42 @@ std::unique_ptr<CmdArgs> CmdArgsParser::Parse(char **first, char **last) {
       throw std::runtime_error("Unrecognized positional argument: " + arg);
     }
   }
-  // Ensure the paths to the XSL stylesheet and input document are set.
-  if (p_impl_->cmd_args_->help.empty()) {
-    if (p_impl_->cmd_args_->stylesheet_path.empty()) {
+  // Ensure the paths to the XSL stylesheet and documents are set.
+  const CmdArgs &cmd_args = *p_impl_->cmd_args_;
+  if (cmd_args.help.empty()) {
+    if (cmd_args.stylesheet_paths.empty()) {
       throw std::invalid_argument("Path to stylesheet is not provided.");
     }
-    if (p_impl_->cmd_args_->input_doc_path.empty()) {
-      throw std::invalid_argument("Path to input document is not provided.");
+    if (cmd_args.stylesheet_paths.size() > 1) {
+      if (cmd_args.input_doc_paths.size() != 1 ||
+          !cmd_args.manifest_path.empty()) {
+        throw std::invalid_argument(
+            "Several stylesheets require a single input document.");
+      }
+      if (cmd_args.output_doc_paths.size() !=
+          cmd_args.stylesheet_paths.size()) {
+        throw std::invalid_argument(
+            "Numbers of stylesheets and output documents differ.");
+      }
+    } else {
+      if (cmd_args.input_doc_paths.empty() &&
+          cmd_args.manifest_path.empty()) {
+        throw std::invalid_argument(
+            "Path to input document is not provided.");
+      }
+      if (!cmd_args.output_doc_paths.empty() &&
+          cmd_args.output_doc_paths.size() !=
+              cmd_args.input_doc_paths.size()) {
+        throw std::invalid_argument(
+            "Numbers of input and output documents differ.");
+      }
+      if (cmd_args.output_doc_paths.empty() &&
+          (cmd_args.input_doc_paths.size() > 1 ||
+           (!cmd_args.input_doc_paths.empty() &&
+            !cmd_args.manifest_path.empty()))) {
+        throw std::invalid_argument(
+            "Paths to output documents are not provided.");
+      }
     }
   }
   return std::move(p_impl_->cmd_args_);
@@ -0,0 +1,56 @@
+#include "xbelmark/xslt/ext/call_profile.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace xbelmark {
+namespace xslt {
+namespace ext {
+
+/**
+ *  Whether extension functions are timed when they are registered.
+ */
+static std::atomic<bool> is_enabled(false);
+
+/**
+ *  Guard of @link entries @endlink, which are recorded by concurrent
+ *  transformations.
+ */
+static std::mutex entries_mutex;
+
+/**
+ *  Entries keyed by `{URI}name`.
+ */
+static std::map<std::string, CallProfile::Entry> entries;
+
+void CallProfile::SetEnabled(bool enabled) {
+  is_enabled = enabled;
+}
+
+std::map<std::string, CallProfile::Entry> CallProfile::Entries() {
+  std::lock_guard<std::mutex> lock(entries_mutex);
+  return entries;
+}
+
+bool CallProfile::IsEnabled() {
+  return is_enabled;
+}
+
+void CallProfile::Record(xmlXPathParserContextPtr ctxt, double seconds) {
+  std::string key;
+  if (ctxt && ctxt->context && ctxt->context->function) {
+    if (ctxt->context->functionURI) {
+      key = key + "{" +
+          reinterpret_cast<const char *>(ctxt->context->functionURI) + "}";
+    }
+    key += reinterpret_cast<const char *>(ctxt->context->function);
+  }
+  std::lock_guard<std::mutex> lock(entries_mutex);
+  Entry &entry = entries[key];
+  ++entry.num_calls;
+  entry.seconds += seconds;
+}
+
+} // namespace ext
+} // namespace xslt
+} // namespace xbelmark
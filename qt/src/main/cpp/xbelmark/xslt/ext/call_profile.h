@@ -0,0 +1,113 @@
+#ifndef XBELMARK_XSLT_EXT_CALL_PROFILE_H
+#define XBELMARK_XSLT_EXT_CALL_PROFILE_H
+
+#include <chrono>
+#include <map>
+#include <string>
+
+#include <libxml/xmlstring.h>
+#include <libxml/xpath.h>
+#include <libxslt/extensions.h>
+#include <libxslt/transform.h>
+
+namespace xbelmark {
+namespace xslt {
+namespace ext {
+
+/**
+ *  Number of calls and cumulative time of the extension functions.
+ *
+ *  Extension functions are timed only if they are registered by @link
+ *  RegisterFunction @endlink while profiling is enabled, so that they are
+ *  called without overhead otherwise.
+ */
+class CallProfile final {
+ public:
+  /**
+   *  Calls of an extension function.
+   */
+  struct Entry {
+   public:
+    /**
+     *  Number of calls.
+     */
+    long long num_calls = 0;
+
+    /**
+     *  Cumulative wall-clock time of the calls in seconds.
+     */
+    double seconds = 0;
+  };
+
+  /**
+   *  Enable or disable the profiling of extension functions that are
+   *  registered afterward.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   *  Entries of the extension functions that have been called while
+   *  profiling, keyed by `{URI}name`.
+   */
+  static std::map<std::string, Entry> Entries();
+
+  /**
+   *  Register an extension function that is timed if profiling is enabled.
+   *
+   *  @tparam function
+   *    Extension function.
+   *
+   *  @param ctxt
+   *    libxslt transform context.
+   *
+   *  @param name
+   *    Name of the extension function.
+   *
+   *  @param URI
+   *    URI of the namespace of the extension function.
+   */
+  template <xmlXPathFunction function>
+  static void RegisterFunction(
+      xsltTransformContextPtr ctxt, const char *name, const xmlChar *URI) {
+    xsltRegisterExtFunction(
+        ctxt,
+        reinterpret_cast<const xmlChar *>(name),
+        URI,
+        IsEnabled() ? Timed<function> : function);
+  }
+
+ private:
+  /**
+   *  Whether profiling is enabled.
+   */
+  static bool IsEnabled();
+
+  /**
+   *  Record a call of the extension function that is being called in an
+   *  XPath context.
+   */
+  static void Record(xmlXPathParserContextPtr ctxt, double seconds);
+
+  /**
+   *  Extension function that calls another and records its time.
+   *
+   *  The extension function must report errors through @link RaiseError
+   *  @endlink rather than throw, since it is called by libxslt.
+   */
+  template <xmlXPathFunction function>
+  static void Timed(xmlXPathParserContextPtr ctxt, int nargs) {
+    const std::chrono::steady_clock::time_point start(
+        std::chrono::steady_clock::now());
+    function(ctxt, nargs);
+    Record(
+        ctxt,
+        std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count());
+  }
+};
+
+} // namespace ext
+} // namespace xslt
+} // namespace xbelmark
+
+#endif
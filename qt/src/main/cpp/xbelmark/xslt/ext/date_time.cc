@@ -1,7 +1,7 @@
 #include "xbelmark/xslt/ext/date_time.h"
 
 #include <deque>
-#include <stdexcept>
+#include <exception>
 #include <string>
 #include <utility>
 
@@ -10,6 +10,8 @@
 
 #include "xbelmark/datetime/datetime.h"
 #include "xbelmark/xml/xpath/xpath.h"
+#include "xbelmark/xslt/ext/call_profile.h"
+#include "xbelmark/xslt/ext/error.h"
 
 using xbelmark::memory::UniquePtr;
 using xbelmark::xml::xpath::NewXmlXPathObject;
@@ -26,18 +28,17 @@ const xmlChar *DateTime::NamespaceUri() {
 }
 
 void *DateTime::InitFunction(xsltTransformContextPtr ctxt, const xmlChar *URI) {
-  xsltRegisterExtFunction(
-      ctxt,
-      reinterpret_cast<const xmlChar *>("dateTimeToUnix"),
-      URI,
-      dateTimeToUnix);
+  CallProfile::RegisterFunction<dateTimeToUnix>(ctxt, "dateTimeToUnix", URI);
   return nullptr;
 }
 
 void DateTime::dateTimeToUnix(xmlXPathParserContextPtr ctxt, int nargs) {
   if (nargs != 1) {
-    throw std::invalid_argument(
+    RaiseError(
+        ctxt,
+        XPATH_INVALID_ARITY,
         "Invalid number of arguments for `dateTimeToUnix`.");
+    return;
   }
   std::deque<UniquePtr<xmlXPathObject>> args;
   // Pop arguments from the stack, and push them onto the deque.
@@ -60,8 +61,11 @@ void DateTime::dateTimeToUnix(xmlXPathParserContextPtr ctxt, int nargs) {
       input_time = xbelmark::datetime::Date(input);
     }
   } catch (const std::exception &) {
-    throw std::invalid_argument(
+    RaiseError(
+        ctxt,
+        XPATH_INVALID_OPERAND,
         "Not a valid `xs:dateTime` or `xs:date` format: " + input);
+    return;
   }
   // Push result onto the stack.
   UniquePtr<xmlXPathObject> result(xbelmark::xml::xpath::NewXmlXPathObject());
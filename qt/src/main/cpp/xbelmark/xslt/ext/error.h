@@ -0,0 +1,46 @@
+#ifndef XBELMARK_XSLT_EXT_ERROR_H
+#define XBELMARK_XSLT_EXT_ERROR_H
+
+#include <string>
+
+#include <libxml/xpath.h>
+#include <libxml/xpathInternals.h>
+#include <libxslt/extensions.h>
+#include <libxslt/xsltutils.h>
+
+namespace xbelmark {
+namespace xslt {
+namespace ext {
+
+/**
+ *  Report an error in a call of an extension function.
+ *
+ *  Extension functions are called by libxslt, which is C, on the threads of
+ *  concurrent transformations, so they report errors with this instead of
+ *  throwing. The XPath expression that called the extension function fails,
+ *  and the transformation fails with it.
+ *
+ *  @param ctxt
+ *    libxml2 XPath parser context of the call.
+ *
+ *  @param code
+ *    XPath error, such as `XPATH_INVALID_ARITY`.
+ *
+ *  @param message
+ *    Error message.
+ */
+inline void RaiseError(
+    xmlXPathParserContextPtr ctxt,
+    xmlXPathError code,
+    const std::string &message) {
+  xsltTransformError(
+      xsltXPathGetTransformContext(ctxt), nullptr, nullptr, "%s\n",
+      message.c_str());
+  ctxt->error = code;
+}
+
+} // namespace ext
+} // namespace xslt
+} // namespace xbelmark
+
+#endif
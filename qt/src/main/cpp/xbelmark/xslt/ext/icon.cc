@@ -0,0 +1,85 @@
+#include "xbelmark/xslt/ext/icon.h"
+
+#include <deque>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include <QString>
+#include <QUrl>
+#include <libxml/xpathInternals.h>
+#include <libxslt/extensions.h>
+
+#include "xbelmark/xml/xpath/xpath.h"
+#include "xbelmark/xslt/ext/call_profile.h"
+#include "xbelmark/xslt/ext/error.h"
+
+using xbelmark::memory::UniquePtr;
+using xbelmark::xml::xpath::NewXmlXPathObject;
+using xbelmark::xml::xpath::PopValue;
+using xbelmark::xml::xpath::PushValue;
+
+namespace xbelmark {
+namespace xslt {
+namespace ext {
+
+/**
+ *  Icon cache that is read by the extension functions, or `nullptr` if there
+ *  is none.
+ */
+static const xbelmark::html::IconCache *icon_cache = nullptr;
+
+const xmlChar *Icon::NamespaceUri() {
+  return reinterpret_cast<const xmlChar *>(
+      "xalan://io.github.hc1839.xbelmark.xslt.ext.Icon");
+}
+
+void *Icon::InitFunction(xsltTransformContextPtr ctxt, const xmlChar *URI) {
+  CallProfile::RegisterFunction<dataUri>(ctxt, "dataUri", URI);
+  return nullptr;
+}
+
+void Icon::SetCache(const xbelmark::html::IconCache *cache) {
+  icon_cache = cache;
+}
+
+void Icon::dataUri(xmlXPathParserContextPtr ctxt, int nargs) {
+  if (nargs != 1) {
+    RaiseError(
+        ctxt,
+        XPATH_INVALID_ARITY,
+        "Invalid number of arguments for `dataUri`.");
+    return;
+  }
+  std::deque<UniquePtr<xmlXPathObject>> args;
+  // Pop arguments from the stack, and push them onto the deque.
+  for (int i = 0; i != nargs; ++i) {
+    args.push_front(PopValue(ctxt));
+  }
+  // Convert argument to a string.
+  if (args[0]->type != xmlXPathObjectType::XPATH_STRING) {
+    PushValue(ctxt, std::move(args[0]));
+    xmlXPathStringFunction(ctxt, 1);
+    args[0] = PopValue(ctxt);
+  }
+  const std::string input(reinterpret_cast<const char *>(args[0]->stringval));
+  std::string data_uri;
+  if (icon_cache && !input.empty()) {
+    try {
+      data_uri = icon_cache->DataUri(QUrl(QString::fromStdString(input)));
+    } catch (const std::exception &e) {
+      RaiseError(ctxt, XPATH_INVALID_OPERAND, e.what());
+      return;
+    }
+  }
+  // Push result onto the stack.
+  UniquePtr<xmlXPathObject> result(NewXmlXPathObject());
+  result->type = xmlXPathObjectType::XPATH_STRING;
+  result->stringval = xmlStrdup(
+      reinterpret_cast<const xmlChar *>(data_uri.c_str()));
+  PushValue(ctxt, std::move(result));
+}
+
+} // namespace ext
+} // namespace xslt
+} // namespace xbelmark
@@ -0,0 +1,72 @@
+#ifndef XBELMARK_XSLT_EXT_ICON_H
+#define XBELMARK_XSLT_EXT_ICON_H
+
+#include <libxml/xmlstring.h>
+#include <libxml/xpath.h>
+#include <libxslt/transform.h>
+
+#include "xbelmark/html/icon_cache.h"
+
+namespace xbelmark {
+namespace xslt {
+namespace ext {
+
+/**
+ *  Icons of bookmarks from the icon cache.
+ */
+class Icon final {
+ public:
+  /**
+   *  URI of the namespace of the extension.
+   *
+   *  It is `xalan://io.github.hc1839.xbelmark.xslt.ext.Icon` in the style of
+   *  @link DateTime::NamespaceUri @endlink. Stylesheets should test whether
+   *  its functions are available, since other processors do not have them.
+   *
+   *  @return
+   *    URI of the namespace of the extension.
+   */
+  static const xmlChar *NamespaceUri();
+
+  /**
+   *  Register the extension functions associated with @link NamespaceUri
+   *  @endlink.
+   *
+   *  @param ctxt
+   *    libxslt transform context.
+   *
+   *  @param URI
+   *    URI returned by @link NamespaceUri @endlink.
+   */
+  static void *InitFunction(xsltTransformContextPtr ctxt, const xmlChar *URI);
+
+  /**
+   *  Set the icon cache that the extension functions read.
+   *
+   *  @param cache
+   *    Icon cache, which must outlive the transformations, or `nullptr` for
+   *    none.
+   */
+  static void SetCache(const xbelmark::html::IconCache *cache);
+
+  /**
+   *  `dataUri` extension function that converts the URL of an icon to a
+   *  `data` URI with the content from the icon cache, without accessing the
+   *  network.
+   *
+   *  The result is an empty string if the icon is not in the icon cache.
+   *
+   *  @param ctxt
+   *    libxslt transform context.
+   *
+   *  @param nargs
+   *    Number of arguments on the stack. It must be `1`.
+   */
+  static void dataUri(xmlXPathParserContextPtr ctxt, int nargs);
+};
+
+} // namespace ext
+} // namespace xslt
+} // namespace xbelmark
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef XBELMARK_XSLT_MANIFEST_H
+#define XBELMARK_XSLT_MANIFEST_H
+
+#include <cctype>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xbelmark {
+namespace xslt {
+
+/**
+ *  Pairs of input and output documents in a manifest with one pair per line.
+ *
+ *  Each line has the path to an input document and the path to its output
+ *  document separated by a tab. Surrounding whitespace is removed from each
+ *  line. Empty lines, and lines that begin with `#`, are skipped.
+ *
+ *  @param text
+ *    Manifest, where lines end with LF or CRLF.
+ *
+ *  @return
+ *    Paths to the input and output documents in the order that they are
+ *    listed.
+ */
+inline std::vector<std::pair<std::string, std::string>> ManifestEntries(
+    const std::string &text) {
+  std::vector<std::pair<std::string, std::string>> retval;
+  std::size_t line_num = 0;
+  std::size_t first = 0;
+  while (first < text.size()) {
+    ++line_num;
+    std::size_t last = text.find('\n', first);
+    if (last == std::string::npos) {
+      last = text.size();
+    }
+    std::size_t next = last + 1;
+    while (first != last &&
+           std::isspace(static_cast<unsigned char>(text[first]))) {
+      ++first;
+    }
+    while (last != first &&
+           std::isspace(static_cast<unsigned char>(text[last - 1]))) {
+      --last;
+    }
+    if (first != last && text[first] != '#') {
+      const std::size_t tab = text.find('\t', first);
+      if (tab >= last || tab + 1 == last ||
+          text.find('\t', tab + 1) < last) {
+        throw std::runtime_error(
+            "Invalid line in manifest: " + std::to_string(line_num));
+      }
+      retval.emplace_back(
+          text.substr(first, tab - first),
+          text.substr(tab + 1, last - tab - 1));
+    }
+    first = next;
+  }
+  return retval;
+}
+
+} // namespace xslt
+} // namespace xbelmark
+
+#endif
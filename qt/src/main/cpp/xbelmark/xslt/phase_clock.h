@@ -0,0 +1,120 @@
+#ifndef XBELMARK_XSLT_PHASE_CLOCK_H
+#define XBELMARK_XSLT_PHASE_CLOCK_H
+
+#include <chrono>
+#include <ctime>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+namespace xbelmark {
+namespace xslt {
+
+/**
+ *  CPU time in seconds that has been consumed by the calling thread.
+ */
+inline double ThreadCpuSeconds() {
+#ifdef WIN32
+  FILETIME creation_time;
+  FILETIME exit_time;
+  FILETIME kernel_time;
+  FILETIME user_time;
+  if (!GetThreadTimes(
+          GetCurrentThread(),
+          &creation_time, &exit_time, &kernel_time, &user_time)) {
+    return 0;
+  }
+  // Both are in units of 100 nanoseconds.
+  const auto ticks = [](const FILETIME &time) -> double {
+    return static_cast<double>(
+        (static_cast<unsigned long long>(time.dwHighDateTime) << 32) |
+        time.dwLowDateTime);
+  };
+  return (ticks(kernel_time) + ticks(user_time)) * 1e-7;
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+    return 0;
+  }
+  return static_cast<double>(time.tv_sec) + time.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ *  Accumulated time of a phase of the `xslt` subcommand.
+ */
+struct PhaseTime {
+ public:
+  /**
+   *  Add a run of the phase.
+   *
+   *  A negative time, such as from a CPU time that could not be read, is
+   *  added as `0`, so that the accumulated times never decrease.
+   *
+   *  @param run_wall_seconds
+   *    Wall-clock time of the run in seconds.
+   *
+   *  @param run_cpu_seconds
+   *    CPU time of the run in seconds.
+   */
+  void Add(double run_wall_seconds, double run_cpu_seconds) {
+    wall_seconds += run_wall_seconds > 0 ? run_wall_seconds : 0;
+    cpu_seconds += run_cpu_seconds > 0 ? run_cpu_seconds : 0;
+    ++count;
+  }
+
+  /**
+   *  Wall-clock time in seconds.
+   */
+  double wall_seconds = 0;
+
+  /**
+   *  CPU time in seconds of the thread that ran the phase.
+   */
+  double cpu_seconds = 0;
+
+  /**
+   *  Number of times that the phase has run.
+   */
+  long long count = 0;
+};
+
+/**
+ *  Clock that divides the time of a thread into consecutive phases.
+ */
+class PhaseClock final {
+ public:
+  PhaseClock() :
+      wall_start_(std::chrono::steady_clock::now()),
+      cpu_start_(ThreadCpuSeconds()) {
+  }
+
+  /**
+   *  Add the time since the previous lap, or since the clock was created, to
+   *  a phase, and start the next lap.
+   *
+   *  @param phase
+   *    Phase that has ended.
+   */
+  void Lap(PhaseTime &phase) {
+    const std::chrono::steady_clock::time_point wall_now(
+        std::chrono::steady_clock::now());
+    const double cpu_now = ThreadCpuSeconds();
+    phase.Add(
+        std::chrono::duration<double>(wall_now - wall_start_).count(),
+        cpu_now - cpu_start_);
+    wall_start_ = wall_now;
+    cpu_start_ = cpu_now;
+  }
+
+ private:
+  std::chrono::steady_clock::time_point wall_start_;
+
+  double cpu_start_;
+};
+
+} // namespace xslt
+} // namespace xbelmark
+
+#endif
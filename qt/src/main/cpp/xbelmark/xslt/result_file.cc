@@ -0,0 +1,132 @@
+#include "xbelmark/xslt/result_file.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+#include <QByteArray>
+#include <QFile>
+#include <QIODevice>
+#include <QSaveFile>
+#include <QString>
+#include <libxml/encoding.h>
+#include <libxml/xmlIO.h>
+#include <libxslt/imports.h>
+#include <libxslt/xsltutils.h>
+
+namespace xbelmark {
+namespace xslt {
+
+class ResultFile::Impl final {
+ public:
+  /**
+   *  Output callback of libxml2 that appends to the buffer, and writes the
+   *  buffer once it is full.
+   *
+   *  @return
+   *    Number of bytes that have been consumed, or `-1` on error.
+   */
+  static int Write(void *context, const char *data, int size) {
+    Impl *obj = static_cast<Impl *>(context);
+    obj->buffer_.append(data, size);
+    if (obj->buffer_.size() >= buffer_size && !obj->Flush()) {
+      return -1;
+    }
+    return size;
+  }
+
+  /**
+   *  Write the buffer to the file.
+   *
+   *  @return
+   *    Whether the buffer has been written.
+   */
+  bool Flush() {
+    if (buffer_.isEmpty()) {
+      return true;
+    }
+    const qint64 num_written = device_->write(buffer_);
+    buffer_.clear();
+    return num_written >= 0;
+  }
+
+  /**
+   *  Path to the file, or an empty string for the standard output.
+   */
+  std::string path_;
+
+  /**
+   *  File other than the standard output, which is committed once the
+   *  result has been written.
+   */
+  std::unique_ptr<QSaveFile> save_file_;
+
+  /**
+   *  Standard output.
+   */
+  std::unique_ptr<QFile> stdout_file_;
+
+  /**
+   *  Device of either file.
+   */
+  QIODevice *device_ = nullptr;
+
+  QByteArray buffer_;
+};
+
+ResultFile::ResultFile(const std::string &path) : p_impl_(new Impl()) {
+  p_impl_->path_ = path;
+  p_impl_->buffer_.reserve(buffer_size + 4096);
+}
+
+ResultFile::~ResultFile() = default;
+
+void ResultFile::Save(xmlDocPtr result, xsltStylesheetPtr stylesheet) {
+  Impl *impl = p_impl_.get();
+  if (impl->path_.empty()) {
+    impl->stdout_file_.reset(new QFile());
+    std::fflush(stdout);
+    if (!impl->stdout_file_->open(
+            fileno(stdout), QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+      throw std::runtime_error("Cannot write to the standard output.");
+    }
+    impl->device_ = impl->stdout_file_.get();
+  } else {
+    impl->save_file_.reset(new QSaveFile(QString::fromStdString(impl->path_)));
+    if (!impl->save_file_->open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+      throw std::runtime_error("Cannot write " + impl->path_);
+    }
+    impl->device_ = impl->save_file_.get();
+  }
+  // Encoding is chosen in the same way as by `xsltSaveResultToFilename`.
+  const xmlChar *encoding = nullptr;
+  XSLT_GET_IMPORT_PTR(encoding, stylesheet, encoding)
+  xmlCharEncodingHandlerPtr encoder = nullptr;
+  if (encoding) {
+    encoder = xmlFindCharEncodingHandler(
+        reinterpret_cast<const char *>(encoding));
+    if (encoder &&
+        xmlStrEqual(
+            reinterpret_cast<const xmlChar *>(encoder->name),
+            reinterpret_cast<const xmlChar *>("UTF-8"))) {
+      encoder = nullptr;
+    }
+  }
+  xmlOutputBufferPtr out_buffer =
+      xmlOutputBufferCreateIO(&Impl::Write, nullptr, impl, encoder);
+  if (!out_buffer) {
+    throw std::runtime_error("Cannot create the output buffer.");
+  }
+  const bool is_serialized =
+      xsltSaveResultTo(out_buffer, result, stylesheet) >= 0;
+  const bool is_closed = xmlOutputBufferClose(out_buffer) >= 0;
+  if (!is_serialized || !is_closed || !impl->Flush() ||
+      (impl->save_file_ && !impl->save_file_->commit())) {
+    throw std::runtime_error(
+        "Cannot write " +
+        (impl->path_.empty() ? std::string("the standard output") :
+                               impl->path_));
+  }
+}
+
+} // namespace xslt
+} // namespace xbelmark
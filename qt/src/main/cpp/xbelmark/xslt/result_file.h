@@ -0,0 +1,63 @@
+#ifndef XBELMARK_XSLT_RESULT_FILE_H
+#define XBELMARK_XSLT_RESULT_FILE_H
+
+#include <memory>
+#include <string>
+
+#include <libxslt/xsltInternals.h>
+
+namespace xbelmark {
+namespace xslt {
+
+/**
+ *  File that the result of a transformation is serialized to.
+ *
+ *  The result is serialized by libxml2 into a large buffer that is written to
+ *  the file unbuffered, so that a large result takes few writes and is not
+ *  copied again by stdio. A file other than the standard output is replaced
+ *  atomically once the result has been written in its entirety, so that a
+ *  reader never sees a partial result.
+ */
+class ResultFile final {
+ public:
+  /**
+   *  Number of bytes that are buffered before they are written.
+   */
+  static constexpr int buffer_size = 1024 * 1024;
+
+  /**
+   *  @param path
+   *    Path to the file, or an empty string for the standard output.
+   */
+  explicit ResultFile(const std::string &path);
+
+  /**
+   *  The file is left unchanged if the result has not been saved.
+   */
+  ~ResultFile();
+
+  /**
+   *  Serialize the result of a transformation, and commit the file.
+   *
+   *  @param result
+   *    Result of the transformation.
+   *
+   *  @param stylesheet
+   *    Stylesheet that produced the result, whose `xsl:output` element
+   *    determines the serialization.
+   *
+   *  @throw std::runtime_error
+   *    If the file cannot be written.
+   */
+  void Save(xmlDocPtr result, xsltStylesheetPtr stylesheet);
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> p_impl_;
+};
+
+} // namespace xslt
+} // namespace xbelmark
+
+#endif
@@ -1,27 +1,511 @@
 #include "xbelmark/xslt/xslt.h"
 
-#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
 #include <libxslt/extensions.h>
 #include <libxslt/transform.h>
+#include <libxslt/xsltInternals.h>
 #include <libxslt/xsltutils.h>
 
+#include "xbelmark/html/icon_cache.h"
+#include "xbelmark/xml/reader.h"
 #include "xbelmark/xslt/cmd_args.h"
 #include "xbelmark/xslt/cmd_args_parser.h"
+#include "xbelmark/xslt/ext/call_profile.h"
 #include "xbelmark/xslt/ext/date_time.h"
+#include "xbelmark/xslt/ext/icon.h"
+#include "xbelmark/xslt/manifest.h"
+#include "xbelmark/xslt/phase_clock.h"
+#include "xbelmark/xslt/result_file.h"
 
+using xbelmark::html::IconCache;
+using xbelmark::xml::OrderedXmlDoc;
+using xbelmark::xml::ReadXmlFile;
+using xbelmark::xslt::ext::CallProfile;
 using xbelmark::xslt::ext::DateTime;
+using xbelmark::xslt::ext::Icon;
 
 namespace xbelmark {
 namespace xslt {
 
+/**
+ *  Profile of the transformations that is printed by `--profile`.
+ */
+struct Profile {
+ public:
+  /**
+   *  Parsing the command-line arguments, registering the extensions, and
+   *  opening the icon cache.
+   */
+  PhaseTime setup;
+
+  /**
+   *  Compiling the stylesheets.
+   */
+  PhaseTime compile;
+
+  /**
+   *  Parsing the input documents.
+   */
+  PhaseTime parse;
+
+  /**
+   *  Applying the stylesheet to the input documents.
+   */
+  PhaseTime transform;
+
+  /**
+   *  Serializing the output documents.
+   */
+  PhaseTime serialize;
+
+  /**
+   *  Entire subcommand.
+   */
+  PhaseTime total;
+
+  /**
+   *  Templates that have been called, in descending order of their time,
+   *  keyed by the index of their stylesheet in the command-line arguments,
+   *  since the same stylesheet can be given more than once.
+   */
+  std::map<std::size_t, QJsonArray> templates;
+};
+
+/**
+ *  JSON object of the time of a phase.
+ */
+QJsonObject PhaseTimeJson(const PhaseTime &phase) {
+  QJsonObject retval;
+  retval.insert("wall", phase.wall_seconds);
+  retval.insert("cpu", phase.cpu_seconds);
+  retval.insert("count", static_cast<qint64>(phase.count));
+  return retval;
+}
+
+/**
+ *  Path to the file of a compiled stylesheet.
+ */
+std::string StylesheetPath(xsltStylesheetPtr stylesheet) {
+  return stylesheet->doc && stylesheet->doc->URL ?
+      reinterpret_cast<const char *>(stylesheet->doc->URL) : "";
+}
+
+/**
+ *  Calls and time of the templates that have been called so far with a
+ *  stylesheet as JSON.
+ *
+ *  libxslt counts the calls and time of each template in the compiled
+ *  stylesheet, so the counts include every transformation with the
+ *  stylesheet rather than only the one of the transform context.
+ *
+ *  @param ctxt
+ *    Transform context with profiling enabled.
+ */
+QJsonArray TemplateProfile(xsltTransformContextPtr ctxt) {
+  QJsonArray retval;
+  xmlDocPtr doc = xsltGetProfileInformation(ctxt);
+  if (!doc) {
+    return retval;
+  }
+  const auto property = [](xmlNodePtr node, const char *name) -> QString {
+    xmlChar *value =
+        xmlGetProp(node, reinterpret_cast<const xmlChar *>(name));
+    const QString retval(
+        value ? QString::fromUtf8(reinterpret_cast<const char *>(value)) :
+            QString());
+    xmlFree(value);
+    return retval;
+  };
+  const QString stylesheet_path(
+      QString::fromStdString(StylesheetPath(ctxt->style)));
+  for (xmlNodePtr node = xmlDocGetRootElement(doc)->children; node;
+       node = node->next) {
+    if (node->type != XML_ELEMENT_NODE) {
+      continue;
+    }
+    QJsonObject obj;
+    obj.insert("stylesheet", stylesheet_path);
+    obj.insert("name", property(node, "name"));
+    obj.insert("match", property(node, "match"));
+    obj.insert("mode", property(node, "mode"));
+    obj.insert("calls", property(node, "calls").toLongLong());
+    // Time is in ticks of the timestamps of libxslt.
+    obj.insert(
+        "seconds",
+        property(node, "time").toDouble() / XSLT_TIMESTAMP_TICS_PER_SEC);
+    retval.append(obj);
+  }
+  xmlFreeDoc(doc);
+  return retval;
+}
+
+/**
+ *  Print a profile to the standard error as a JSON object.
+ *
+ *  @param num_docs
+ *    Number of input documents.
+ */
+void PrintProfile(const Profile &profile, std::size_t num_docs) {
+  QJsonObject phases;
+  phases.insert("setup", PhaseTimeJson(profile.setup));
+  phases.insert("compile", PhaseTimeJson(profile.compile));
+  phases.insert("parse", PhaseTimeJson(profile.parse));
+  phases.insert("transform", PhaseTimeJson(profile.transform));
+  phases.insert("serialize", PhaseTimeJson(profile.serialize));
+  phases.insert("total", PhaseTimeJson(profile.total));
+  QJsonArray templates;
+  for (const auto &entry : profile.templates) {
+    for (const QJsonValue &value : entry.second) {
+      templates.append(value);
+    }
+  }
+  QJsonArray ext_functions;
+  for (const auto &entry : CallProfile::Entries()) {
+    QJsonObject obj;
+    obj.insert("name", QString::fromStdString(entry.first));
+    obj.insert("calls", static_cast<qint64>(entry.second.num_calls));
+    obj.insert("seconds", entry.second.seconds);
+    ext_functions.append(obj);
+  }
+  QJsonObject obj;
+  obj.insert("phases", phases);
+  obj.insert("documents", static_cast<qint64>(num_docs));
+  obj.insert("templates", templates);
+  obj.insert("extension_functions", ext_functions);
+  std::cerr <<
+      QJsonDocument(obj).toJson(QJsonDocument::Compact).toStdString() <<
+      std::endl;
+}
+
+/**
+ *  Paths to the input and output documents of the transformations.
+ *
+ *  An empty path to an output document is the standard output.
+ */
+std::vector<std::pair<std::string, std::string>> Transforms(
+    const CmdArgs &cmd_args) {
+  std::vector<std::pair<std::string, std::string>> retval;
+  for (std::size_t i = 0; i != cmd_args.input_doc_paths.size(); ++i) {
+    retval.emplace_back(
+        cmd_args.input_doc_paths[i],
+        cmd_args.output_doc_paths.empty() ?
+            std::string() : cmd_args.output_doc_paths[i]);
+  }
+  if (!cmd_args.manifest_path.empty()) {
+    std::ifstream file(cmd_args.manifest_path, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error(
+          "Cannot read the manifest " + cmd_args.manifest_path);
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    for (auto &entry : ManifestEntries(text.str())) {
+      retval.push_back(std::move(entry));
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Whether a search for a string in the attributes of the elements of an XML
+ *  document finds it.
+ */
+bool HasAttributeWith(xmlNodePtr node, const char *str) {
+  for (; node; node = node->next) {
+    if (node->type != XML_ELEMENT_NODE) {
+      continue;
+    }
+    for (xmlAttrPtr attr = node->properties; attr; attr = attr->next) {
+      xmlChar *value = xmlNodeGetContent(reinterpret_cast<xmlNodePtr>(attr));
+      const bool is_found =
+          value && xmlStrstr(value, reinterpret_cast<const xmlChar *>(str));
+      xmlFree(value);
+      if (is_found) {
+        return true;
+      }
+    }
+    if (HasAttributeWith(node->children, str)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ *  Whether applying a stylesheet may modify the input document.
+ *
+ *  libxslt removes the whitespace that is stripped by `xsl:strip-space` from
+ *  the input document, and it flags the nodes that are indexed by `xsl:key`
+ *  or identified by `generate-id()` until the transformation ends. Calls of
+ *  `generate-id()` are searched for in the attributes of the stylesheet
+ *  documents, so a mention of it that is not a call is counted as well.
+ */
+bool ModifiesInputDoc(xsltStylesheetPtr stylesheet) {
+  for (; stylesheet; stylesheet = stylesheet->next) {
+    if (stylesheet->stripSpaces || stylesheet->stripAll == 1 ||
+        stylesheet->keys) {
+      return true;
+    }
+    if (stylesheet->doc &&
+        HasAttributeWith(stylesheet->doc->children, "generate-id")) {
+      return true;
+    }
+    for (xsltDocumentPtr include = stylesheet->docList; include;
+         include = include->next) {
+      if (include->doc &&
+          HasAttributeWith(include->doc->children, "generate-id")) {
+        return true;
+      }
+    }
+    if (ModifiesInputDoc(stylesheet->imports)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ *  Apply a stylesheet that is shared by concurrent transformations to an
+ *  input document.
+ *
+ *  Each transformation has its own transformation context, so only the
+ *  compiled stylesheet, which is not modified, is shared.
+ *
+ *  @param stylesheet_index
+ *    Index of the stylesheet in the command-line arguments, which the
+ *    templates are recorded by.
+ *
+ *  @param profile
+ *    Profile that the phase and templates are recorded in, or `nullptr` if
+ *    the transformation is not profiled. Since libxslt records the calls of
+ *    templates in the stylesheet, profiled transformations must not be
+ *    concurrent.
+ *
+ *  @return
+ *    Output document, or `nullptr` if the transformation failed. It must be
+ *    freed by `xmlFreeDoc`.
+ */
+xmlDocPtr Apply(
+    xsltStylesheetPtr stylesheet,
+    const char **xslt_params,
+    xmlDocPtr input_doc,
+    std::size_t stylesheet_index,
+    Profile *profile) {
+  PhaseClock clock;
+  xsltTransformContextPtr ctxt = xsltNewTransformContext(stylesheet, input_doc);
+  if (!ctxt) {
+    return nullptr;
+  }
+  // Without a file, the profile is only recorded in the templates.
+  ctxt->profile = profile ? 1 : 0;
+  xmlDocPtr retval = xsltApplyStylesheetUser(
+      stylesheet, input_doc, xslt_params, nullptr, nullptr, ctxt);
+  if (retval && ctxt->state != XSLT_STATE_OK) {
+    xmlFreeDoc(retval);
+    retval = nullptr;
+  }
+  if (profile) {
+    clock.Lap(profile->transform);
+    profile->templates[stylesheet_index] = TemplateProfile(ctxt);
+  }
+  xsltFreeTransformContext(ctxt);
+  return retval;
+}
+
+/**
+ *  Serialize and free an output document.
+ *
+ *  @param output_doc_path
+ *    Path to the output document, or an empty string for the standard output.
+ *
+ *  @return
+ *    Error message, or an empty string if there was no error.
+ */
+std::string Save(
+    xmlDocPtr output_doc,
+    xsltStylesheetPtr stylesheet,
+    const std::string &output_doc_path,
+    Profile *profile) {
+  PhaseClock clock;
+  std::string error;
+  try {
+    ResultFile(output_doc_path).Save(output_doc, stylesheet);
+  } catch (const std::exception &e) {
+    error = e.what();
+  }
+  if (profile) {
+    clock.Lap(profile->serialize);
+  }
+  xmlFreeDoc(output_doc);
+  return error;
+}
+
+/**
+ *  Transform an input document with a stylesheet that is shared by
+ *  concurrent transformations.
+ *
+ *  The input document is parsed with a child of the dictionary of the
+ *  stylesheet, so that names are matched by pointer. The input document is
+ *  freed before the result is serialized, since libxslt builds the result in
+ *  its entirety first.
+ *
+ *  @param output_doc_path
+ *    Path to the output document, or an empty string for the standard output.
+ *
+ *  @param profile
+ *    Profile as in @link Apply @endlink.
+ *
+ *  @return
+ *    Error message, or an empty string if there was no error.
+ */
+std::string Transform(
+    xsltStylesheetPtr stylesheet,
+    const char **xslt_params,
+    const std::string &input_doc_path,
+    const std::string &output_doc_path,
+    Profile *profile) {
+  PhaseClock clock;
+  xmlDocPtr input_doc = ReadXmlFile(input_doc_path, stylesheet->dict);
+  if (profile) {
+    clock.Lap(profile->parse);
+  }
+  if (!input_doc) {
+    return "Cannot parse " + input_doc_path;
+  }
+  xmlDocPtr output_doc = Apply(stylesheet, xslt_params, input_doc, 0, profile);
+  xmlFreeDoc(input_doc);
+  if (!output_doc) {
+    return "Cannot transform " + input_doc_path;
+  }
+  return Save(output_doc, stylesheet, output_doc_path, profile);
+}
+
+/**
+ *  Run tasks on up to a number of threads, one of which is the calling
+ *  thread.
+ *
+ *  @param task
+ *    Function that runs the task at an index.
+ */
+void RunTasks(
+    std::size_t num_tasks,
+    std::size_t num_threads,
+    const std::function<void(std::size_t)> &task) {
+  std::atomic<std::size_t> next_index(0);
+  const auto work = [&]() -> void {
+    for (std::size_t i = next_index++; i < num_tasks; i = next_index++) {
+      task(i);
+    }
+  };
+  num_threads = std::min(num_threads, num_tasks);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ *  Render an input document that is parsed once with several stylesheets.
+ *
+ *  The stylesheets are applied concurrently to the same input document,
+ *  which is only read. A stylesheet that would modify the input document, as
+ *  determined by @link ModifiesInputDoc @endlink, is applied to a copy of it
+ *  instead, which is still cheaper than parsing it again.
+ *
+ *  @param output_doc_paths
+ *    Paths to the output documents in the order of the stylesheets.
+ *
+ *  @param num_threads
+ *    Maximum number of stylesheets that are applied at a time.
+ *
+ *  @param profile
+ *    Profile as in @link Apply @endlink.
+ *
+ *  @return
+ *    Error messages, which are empty strings if there was no error.
+ */
+std::vector<std::string> Render(
+    const std::vector<xsltStylesheetPtr> &stylesheets,
+    const char **xslt_params,
+    const std::string &input_doc_path,
+    const std::vector<std::string> &output_doc_paths,
+    std::size_t num_threads,
+    Profile *profile) {
+  PhaseClock clock;
+  // Names that are in the first stylesheet are matched by pointer.
+  xmlDocPtr input_doc = ReadXmlFile(input_doc_path, stylesheets[0]->dict);
+  if (profile) {
+    clock.Lap(profile->parse);
+  }
+  if (!input_doc) {
+    return std::vector<std::string>(1, "Cannot parse " + input_doc_path);
+  }
+  std::vector<std::string> errors(stylesheets.size());
+  RunTasks(stylesheets.size(), num_threads, [&](std::size_t i) -> void {
+    xsltStylesheetPtr stylesheet = stylesheets[i];
+    xmlDocPtr copied_doc = nullptr;
+    if (ModifiesInputDoc(stylesheet)) {
+      copied_doc = OrderedXmlDoc(xmlCopyDoc(input_doc, 1));
+      if (!copied_doc) {
+        errors[i] = "Cannot copy " + input_doc_path;
+        return;
+      }
+    }
+    xmlDocPtr output_doc = Apply(
+        stylesheet,
+        xslt_params,
+        copied_doc ? copied_doc : input_doc,
+        i,
+        profile);
+    xmlFreeDoc(copied_doc);
+    if (!output_doc) {
+      errors[i] = "Cannot transform " + input_doc_path + " with " +
+          StylesheetPath(stylesheet);
+      return;
+    }
+    errors[i] = Save(output_doc, stylesheet, output_doc_paths[i], profile);
+  });
+  xmlFreeDoc(input_doc);
+  return errors;
+}
+
 int Execute(int argc, char *argv[]) {
+  PhaseClock clock;
+  PhaseClock total_clock;
+  Profile profile;
   std::unique_ptr<CmdArgs> cmd_args;
+  std::vector<std::pair<std::string, std::string>> transforms;
   try {
     cmd_args = CmdArgsParser().Parse(&argv[2], &argv[argc]);
+    if (cmd_args->help.empty()) {
+      transforms = Transforms(*cmd_args);
+    }
   } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
     return 1;
@@ -32,14 +516,30 @@ int Execute(int argc, char *argv[]) {
     return 1;
   }
 
+  // Extension functions are registered for each transform context.
+  CallProfile::SetEnabled(cmd_args->profile);
   int status = xsltRegisterExtModule(
       DateTime::NamespaceUri(), DateTime::InitFunction, nullptr);
+  if (status == 0) {
+    status = xsltRegisterExtModule(
+        Icon::NamespaceUri(), Icon::InitFunction, nullptr);
+  }
 
   if (status != 0) {
     std::cerr << "Failed to register the extension module." << std::endl;
     return 1;
   }
 
+  // Icons are embedded only from the cache, which is not created here.
+  const std::string icon_cache_dir(
+      cmd_args->icon_cache_dir.empty() ?
+          xbelmark::html::DefaultIconCacheDir() : cmd_args->icon_cache_dir);
+  std::unique_ptr<IconCache> icon_cache;
+  if (QDir(QString::fromStdString(icon_cache_dir)).exists()) {
+    icon_cache.reset(new IconCache(icon_cache_dir));
+  }
+  Icon::SetCache(icon_cache.get());
+
   std::vector<const char *> xslt_params;
   for (const auto &item : cmd_args->xslt_params) {
     xslt_params.push_back(item.first.c_str());
@@ -47,21 +547,71 @@ int Execute(int argc, char *argv[]) {
   }
   xslt_params.push_back(nullptr);
 
-  xsltStylesheetPtr stylesheet = xsltParseStylesheetFile(
-      reinterpret_cast<const xmlChar *>(cmd_args->stylesheet_path.c_str()));
-  xmlDocPtr input_doc = xmlParseFile(cmd_args->input_doc_path.c_str());
-  xmlDocPtr output_doc =
-      xsltApplyStylesheet(stylesheet, input_doc, xslt_params.data());
-  xsltSaveResultToFile(stdout, output_doc, stylesheet);
+  // Global state of libxml2 is initialized before it is shared by threads.
+  xmlInitParser();
+  clock.Lap(profile.setup);
+  std::vector<xsltStylesheetPtr> stylesheets;
+  for (const std::string &stylesheet_path : cmd_args->stylesheet_paths) {
+    xsltStylesheetPtr stylesheet = xsltParseStylesheetFile(
+        reinterpret_cast<const xmlChar *>(stylesheet_path.c_str()));
+    clock.Lap(profile.compile);
+    if (!stylesheet) {
+      std::cerr << "Cannot parse " << stylesheet_path << std::endl;
+      status = 1;
+      break;
+    }
+    stylesheets.push_back(stylesheet);
+  }
+  if (status == 0) {
+    Profile *transform_profile = cmd_args->profile ? &profile : nullptr;
+    std::size_t num_threads = cmd_args->jobs > 0 ?
+        static_cast<std::size_t>(cmd_args->jobs) :
+        std::max(std::thread::hardware_concurrency(), 1u);
+    if (cmd_args->profile) {
+      num_threads = 1;
+    }
+    std::vector<std::string> errors;
+    if (stylesheets.size() == 1) {
+      errors.resize(transforms.size());
+      RunTasks(transforms.size(), num_threads, [&](std::size_t i) -> void {
+        errors[i] = Transform(
+            stylesheets[0],
+            xslt_params.data(),
+            transforms[i].first,
+            transforms[i].second,
+            transform_profile);
+      });
+    } else {
+      errors = Render(
+          stylesheets,
+          xslt_params.data(),
+          cmd_args->input_doc_paths[0],
+          cmd_args->output_doc_paths,
+          num_threads,
+          transform_profile);
+    }
+    for (const std::string &error : errors) {
+      if (!error.empty()) {
+        std::cerr << error << std::endl;
+        status = 1;
+      }
+    }
+  }
+  for (xsltStylesheetPtr stylesheet : stylesheets) {
+    xsltFreeStylesheet(stylesheet);
+  }
+
+  Icon::SetCache(nullptr);
 
-  xmlFreeDoc(output_doc);
-  xmlFreeDoc(input_doc);
-  xsltFreeStylesheet(stylesheet);
+  if (cmd_args->profile) {
+    total_clock.Lap(profile.total);
+    PrintProfile(profile, transforms.size());
+  }
 
   xsltCleanupGlobals();
   xmlCleanupParser();
 
-  return 0;
+  return status;
 }
 
 } // namespace xslt
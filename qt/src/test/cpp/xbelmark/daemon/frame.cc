@@ -0,0 +1,69 @@
+#include "xbelmark/daemon/frame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace daemon {
+
+/**
+ *  @brief Test frames that are complete.
+ */
+TEST(HasFrame, Valid) {
+  ASSERT_EQ(FramePrefix(0), std::string(4, '\0'));
+  ASSERT_EQ(FramePrefix(0x01020384u), "\x01\x02\x03\x84");
+  const std::string payload("{\"command\":\"ping\"}");
+  const std::string next(FramePrefix(2) + "{}");
+  const std::string buffer(
+      FramePrefix(static_cast<std::uint32_t>(payload.size())) + payload +
+      next);
+  std::uint32_t payload_size = 0;
+  ASSERT_TRUE(HasFrame(buffer.data(), buffer.size(), 1024, payload_size));
+  ASSERT_EQ(payload_size, payload.size());
+  ASSERT_EQ(buffer.substr(kFramePrefixSize, payload_size), payload);
+  const std::string rest(buffer.substr(kFramePrefixSize + payload_size));
+  ASSERT_EQ(rest, next);
+  ASSERT_TRUE(HasFrame(rest.data(), rest.size(), 2, payload_size));
+  ASSERT_EQ(payload_size, 2u);
+  const std::string empty(FramePrefix(0));
+  ASSERT_TRUE(HasFrame(empty.data(), empty.size(), 0, payload_size));
+  ASSERT_EQ(payload_size, 0u);
+}
+
+/**
+ *  @brief Test frames that are incomplete or too large, and payloads that
+ *  are not JSON, which are delimited regardless.
+ */
+TEST(HasFrame, Invalid) {
+  std::uint32_t payload_size = 7;
+  const std::string prefix(FramePrefix(5));
+  for (std::size_t size = 0; size != kFramePrefixSize; ++size) {
+    ASSERT_FALSE(HasFrame(prefix.data(), size, 1024, payload_size));
+  }
+  const std::string partial(prefix + "{\"a\"");
+  ASSERT_FALSE(HasFrame(partial.data(), partial.size(), 1024, payload_size));
+  ASSERT_EQ(payload_size, 7u);
+  const std::string oversized(FramePrefix(1025));
+  ASSERT_THROW(
+      HasFrame(oversized.data(), oversized.size(), 1024, payload_size),
+      std::runtime_error);
+  const std::string huge("\xFF\xFF\xFF\xFF");
+  ASSERT_THROW(
+      HasFrame(huge.data(), huge.size(), 1024, payload_size),
+      std::runtime_error);
+  // The JSON is checked after the frame is consumed, so that a bad message
+  // does not desynchronize the stream.
+  const std::string bad_json(FramePrefix(5) + "{bad," + FramePrefix(0));
+  ASSERT_TRUE(
+      HasFrame(bad_json.data(), bad_json.size(), 1024, payload_size));
+  ASSERT_EQ(payload_size, 5u);
+  ASSERT_EQ(
+      bad_json.substr(kFramePrefixSize + payload_size), FramePrefix(0));
+}
+
+} // namespace daemon
+} // namespace xbelmark
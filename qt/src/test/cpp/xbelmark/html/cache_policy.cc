@@ -0,0 +1,68 @@
+#include "xbelmark/html/cache_policy.h"
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test the expiry of cached entries.
+ */
+TEST(IsFreshEntry, Valid) {
+  ASSERT_TRUE(IsFreshEntry(1000, 1000, 0));
+  ASSERT_TRUE(IsFreshEntry(1000, 1600, 600));
+  ASSERT_FALSE(IsFreshEntry(1000, 1601, 600));
+  ASSERT_FALSE(IsFreshEntry(1000, 1001, 0));
+}
+
+/**
+ *  @brief Test that entries from the future are not fresh.
+ */
+TEST(IsFreshEntry, Invalid) {
+  ASSERT_FALSE(IsFreshEntry(2000, 1000, 600));
+}
+
+/**
+ *  @brief Test the headers of revalidation.
+ */
+TEST(RevalidationHeaders, Valid) {
+  const auto headers(
+      RevalidationHeaders("\"abc\"", "Wed, 21 Oct 2015 07:28:00 GMT"));
+  ASSERT_EQ(headers.size(), 2u);
+  ASSERT_EQ(headers[0].first, "If-None-Match");
+  ASSERT_EQ(headers[0].second, "\"abc\"");
+  ASSERT_EQ(headers[1].first, "If-Modified-Since");
+  ASSERT_EQ(headers[1].second, "Wed, 21 Oct 2015 07:28:00 GMT");
+  ASSERT_EQ(RevalidationHeaders("W/\"x\"", "").size(), 1u);
+}
+
+/**
+ *  @brief Test that entries without validators are not revalidated.
+ */
+TEST(RevalidationHeaders, Invalid) {
+  ASSERT_TRUE(RevalidationHeaders("", "").empty());
+}
+
+/**
+ *  @brief Test the outcomes of revalidation.
+ */
+TEST(IsRevalidated, Valid) {
+  ASSERT_TRUE(IsRevalidated(304, true));
+  ASSERT_FALSE(IsRevalidated(304, false));
+  ASSERT_FALSE(IsRevalidated(200, true));
+}
+
+/**
+ *  @brief Test which responses are stored.
+ */
+TEST(IsCacheableResponse, Valid) {
+  ASSERT_TRUE(IsCacheableResponse(200, true, false));
+  ASSERT_TRUE(IsCacheableResponse(206, true, false));
+  ASSERT_FALSE(IsCacheableResponse(200, false, false));
+  ASSERT_FALSE(IsCacheableResponse(200, true, true));
+  ASSERT_FALSE(IsCacheableResponse(404, true, false));
+  ASSERT_FALSE(IsCacheableResponse(304, true, false));
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,78 @@
+#include "xbelmark/html/charset.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test character encodings declared in `Content-Type` headers.
+ */
+TEST(CharsetFromContentType, Valid) {
+  ASSERT_EQ(CharsetFromContentType("text/html; charset=UTF-8"), "utf-8");
+  ASSERT_EQ(
+      CharsetFromContentType("text/html;charset=\"Shift_JIS\""),
+      "shift_jis");
+  ASSERT_EQ(
+      CharsetFromContentType("text/html; Charset = iso-8859-1"),
+      "windows-1252");
+  ASSERT_EQ(CharsetFromContentType("text/html; charset=utf8; q=1"), "utf-8");
+  ASSERT_EQ(CharsetFromContentType("text/html"), "");
+  ASSERT_EQ(CharsetFromContentType(""), "");
+}
+
+/**
+ *  @brief Test character encodings declared at the beginning of documents.
+ */
+TEST(SniffCharset, Valid) {
+  ASSERT_EQ(SniffCharset("\xEF\xBB\xBF<html>", 9), "utf-8");
+  ASSERT_EQ(SniffCharset("\xFF\xFE<\0", 4), "utf-16le");
+  const std::string meta_charset(
+      "<!DOCTYPE html><html><head><meta charset=\"EUC-JP\">");
+  ASSERT_EQ(
+      SniffCharset(meta_charset.data(), meta_charset.size()), "euc-jp");
+  const std::string http_equiv(
+      "<html><head><META HTTP-EQUIV='Content-Type' "
+      "CONTENT='text/html; charset=windows-1251'>");
+  ASSERT_EQ(
+      SniffCharset(http_equiv.data(), http_equiv.size()), "windows-1251");
+  const std::string utf16("<html><head><meta charset=utf-16 />");
+  ASSERT_EQ(SniffCharset(utf16.data(), utf16.size()), "utf-8");
+  const std::string commented(
+      "<!-- <meta charset=\"big5\"> --><meta name=x><title>");
+  ASSERT_EQ(SniffCharset(commented.data(), commented.size()), "");
+  const std::string late(std::string(2000, ' ') + "<meta charset=big5>");
+  ASSERT_EQ(SniffCharset(late.data(), late.size()), "");
+}
+
+/**
+ *  @brief Test various valid UTF-8 byte sequences.
+ */
+TEST(IsValidUtf8, Valid) {
+  const std::string ascii("<html><head><title>Example Domain</title>");
+  ASSERT_TRUE(IsValidUtf8(ascii.data(), ascii.size()));
+  const std::string mixed(
+      "caf\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x94\x96");
+  ASSERT_TRUE(IsValidUtf8(mixed.data(), mixed.size()));
+  ASSERT_TRUE(IsValidUtf8("\xE6\x97", 2, true));
+  ASSERT_TRUE(IsValidUtf8("", 0));
+}
+
+/**
+ *  @brief Test various invalid UTF-8 byte sequences.
+ */
+TEST(IsValidUtf8, Invalid) {
+  ASSERT_FALSE(IsValidUtf8("caf\xE9", 4));
+  ASSERT_FALSE(IsValidUtf8("\xE6\x97", 2));
+  ASSERT_FALSE(IsValidUtf8("\xC0\xAF", 2));
+  ASSERT_FALSE(IsValidUtf8("\xE0\x80\xAF", 3));
+  ASSERT_FALSE(IsValidUtf8("\xED\xA0\x80", 3));
+  ASSERT_FALSE(IsValidUtf8("\xF4\x90\x80\x80", 4));
+  ASSERT_FALSE(IsValidUtf8("\xF5\x80\x80\x80", 4));
+  ASSERT_FALSE(IsValidUtf8("abcdefgh\x80", 9, true));
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,90 @@
+#include "xbelmark/html/content_type.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test media types that can and cannot have an HTML title.
+ */
+TEST(IsHtmlMediaType, Valid) {
+  ASSERT_TRUE(IsHtmlMediaType("text/html; charset=UTF-8"));
+  ASSERT_TRUE(IsHtmlMediaType("Application/XHTML+XML"));
+  ASSERT_TRUE(IsHtmlMediaType(""));
+  ASSERT_FALSE(IsHtmlMediaType("application/pdf"));
+  ASSERT_FALSE(IsHtmlMediaType("video/mp4"));
+  ASSERT_FALSE(IsHtmlMediaType("application/x-iso9660-image"));
+}
+
+/**
+ *  @brief Test file names in `Content-Disposition` headers.
+ */
+TEST(FileNameFromContentDisposition, Valid) {
+  ASSERT_EQ(
+      FileNameFromContentDisposition("attachment; filename=\"report.pdf\""),
+      "report.pdf");
+  ASSERT_EQ(
+      FileNameFromContentDisposition("inline; filename=debian.iso"),
+      "debian.iso");
+  ASSERT_EQ(
+      FileNameFromContentDisposition(
+          "attachment; filename=\"a.pdf\"; "
+          "filename*=UTF-8''na%C3%AFve%20report.pdf"),
+      "na\xC3\xAFve report.pdf");
+  ASSERT_EQ(
+      FileNameFromContentDisposition(
+          "attachment; filename*=iso-8859-1'en'caf%E9.txt"),
+      "caf\xC3\xA9.txt");
+  ASSERT_EQ(FileNameFromContentDisposition("attachment"), "");
+}
+
+/**
+ *  @brief Test satisfied and unsatisfied `Content-Range` headers.
+ */
+TEST(ParseContentRange, Valid) {
+  long long first = 0;
+  long long last = 0;
+  long long complete_length = 0;
+  ASSERT_TRUE(
+      ParseContentRange("bytes 0-16383/52811", first, last, complete_length));
+  ASSERT_EQ(first, 0);
+  ASSERT_EQ(last, 16383);
+  ASSERT_EQ(complete_length, 52811);
+  ASSERT_TRUE(
+      ParseContentRange("bytes 16384-32767/*", first, last, complete_length));
+  ASSERT_EQ(first, 16384);
+  ASSERT_EQ(last, 32767);
+  ASSERT_EQ(complete_length, -1);
+  ASSERT_FALSE(
+      ParseContentRange("bytes */52811", first, last, complete_length));
+  ASSERT_FALSE(
+      ParseContentRange("bytes 10-5/52811", first, last, complete_length));
+  ASSERT_FALSE(
+      ParseContentRange("bytes 0-52811/52811", first, last, complete_length));
+  ASSERT_FALSE(ParseContentRange("items 0-9/10", first, last, complete_length));
+}
+
+/**
+ *  @brief Test titles in document information dictionaries of PDF files.
+ */
+TEST(PdfTitle, Valid) {
+  const std::string literal(
+      "%PDF-1.4\n1 0 obj\n<< /Title (Annual \\(2023\\) Report) >>\nendobj");
+  ASSERT_EQ(PdfTitle(literal.data(), literal.size()), "Annual (2023) Report");
+  const std::string octal("<</Title(Caf\\351)>>");
+  ASSERT_EQ(PdfTitle(octal.data(), octal.size()), "Caf\xC3\xA9");
+  const std::string utf16("<</Title<FEFF0041006200E9>>>");
+  ASSERT_EQ(PdfTitle(utf16.data(), utf16.size()), "Ab\xC3\xA9");
+  const std::string nested("<</Title (a (b) c)>>");
+  ASSERT_EQ(PdfTitle(nested.data(), nested.size()), "a (b) c");
+  const std::string none("%PDF-1.7\n<</Type /Catalog>>");
+  ASSERT_EQ(PdfTitle(none.data(), none.size()), "");
+  const std::string truncated("<</Title (Unterminat");
+  ASSERT_EQ(PdfTitle(truncated.data(), truncated.size()), "");
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,67 @@
+#include "xbelmark/html/file_name.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test whitespace and reserved characters in titles.
+ */
+TEST(SanitizedFileName, Valid) {
+  ASSERT_EQ(SanitizedFileName("  Example \t Domain \n"), "Example Domain");
+  ASSERT_EQ(SanitizedFileName("Example Domain", '_'), "Example_Domain");
+  ASSERT_EQ(SanitizedFileName("A\xC2\xA0\xC2\xA0 B"), "A B");
+  ASSERT_EQ(SanitizedFileName("a<b>c:d\"e/f\\g|h?i*j"), "a_b_c_d_e_f_g_h_i_j");
+  ASSERT_EQ(SanitizedFileName("Bell\x07"), "Bell_");
+  ASSERT_EQ(SanitizedFileName("Caf\xC3\xA9"), "Caf\xC3\xA9");
+  ASSERT_EQ(SanitizedFileName("Stop... "), "Stop");
+  ASSERT_EQ(SanitizedFileName(" \t "), "");
+  ASSERT_EQ(SanitizedFileName("..."), "");
+}
+
+/**
+ *  @brief Test malformed UTF-8, whose bytes are replaced one at a time.
+ */
+TEST(SanitizedFileName, Invalid) {
+  ASSERT_EQ(SanitizedFileName("\xE0<>"), "___");
+  ASSERT_EQ(SanitizedFileName("\xC3/a"), "__a");
+  ASSERT_EQ(SanitizedFileName("\xF0\x9F\x98:"), "____");
+  ASSERT_EQ(SanitizedFileName("a\xF0\x9F"), "a__");
+  ASSERT_EQ(SanitizedFileName("\xA9" "b"), "_b");
+}
+
+/**
+ *  @brief Test reserved device names under Windows.
+ */
+TEST(SanitizedFileName, DeviceName) {
+  ASSERT_EQ(SanitizedFileName("CON"), "CON_");
+  ASSERT_EQ(SanitizedFileName("nul"), "nul_");
+  ASSERT_EQ(SanitizedFileName("Com1.txt"), "Com1.txt_");
+  ASSERT_EQ(SanitizedFileName("LPT9"), "LPT9_");
+  ASSERT_EQ(SanitizedFileName("LPT0"), "LPT0");
+  ASSERT_EQ(SanitizedFileName("Console"), "Console");
+  ASSERT_TRUE(IsReservedDeviceName("aux .log"));
+  ASSERT_FALSE(IsReservedDeviceName("auxiliary"));
+}
+
+/**
+ *  @brief Test truncation to the budgets without splitting code points.
+ */
+TEST(SanitizedFileName, Truncation) {
+  ASSERT_EQ(SanitizedFileName("abcdef", ' ', 4, 100), "abcd");
+  ASSERT_EQ(SanitizedFileName("ab cd", ' ', 3, 100), "ab");
+  // Two-byte characters are not split by an odd budget.
+  ASSERT_EQ(
+      SanitizedFileName("\xC3\xA9\xC3\xA9\xC3\xA9", ' ', 5, 100),
+      "\xC3\xA9\xC3\xA9");
+  // Characters outside the BMP count as two UTF-16 code units.
+  const std::string emoji("\xF0\x9F\x98\x80");
+  ASSERT_EQ(SanitizedFileName(emoji + emoji, ' ', 100, 3), emoji);
+  ASSERT_EQ(SanitizedFileName(std::string(300, 'x')).size(), kMaxFileNameBytes);
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,105 @@
+#include "xbelmark/html/head_parser.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test titles, descriptions, and links in `head` elements.
+ */
+TEST(HeadParser, Valid) {
+  const std::string html(
+      "<!DOCTYPE html><html><head>"
+      "<base href=\"/docs/\"><base href=\"/ignored/\">"
+      "<title>Title &amp; More</title>"
+      "<meta property=\"OG:Title\" content=\"Open Graph\">"
+      "<meta property=\"og:title\" content=\"Second\">"
+      "<meta name=\"twitter:title\" content=\"Card\">"
+      "<meta property=\"og:description\" content=\"Open description\">"
+      "<meta name=\"description\" content=\"Description\">"
+      "<link rel=\"Canonical\" href=\"page.html\">"
+      "<link rel=\"canonical\" href=\"other.html\">"
+      "<link rel=\"shortcut icon\" href=\"favicon.ico\">"
+      "<link rel=\"apple-touch-icon-precomposed\" href=\"touch.png\" "
+      "sizes=\"180x180\" type=\"image/png\">"
+      "<link rel=\"stylesheet\" href=\"style.css\">"
+      "</head><body><title>Body</title></body></html>");
+  HeadParser parser;
+  parser.Parse(html.data(), html.size(), true);
+  ASSERT_TRUE(parser.is_done());
+  ASSERT_EQ(parser.title(), "Title & More");
+  ASSERT_EQ(parser.og_title(), "Open Graph");
+  ASSERT_EQ(parser.twitter_title(), "Card");
+  ASSERT_EQ(parser.description(), "Description");
+  ASSERT_EQ(parser.canonical_href(), "page.html");
+  ASSERT_EQ(parser.base_href(), "/docs/");
+  ASSERT_EQ(parser.icons().size(), 2u);
+  ASSERT_EQ(parser.icons()[0].href, "favicon.ico");
+  ASSERT_EQ(parser.icons()[0].rel, "shortcut icon");
+  ASSERT_EQ(parser.icons()[1].href, "touch.png");
+  ASSERT_EQ(parser.icons()[1].sizes, "180x180");
+  ASSERT_EQ(parser.icons()[1].type, "image/png");
+}
+
+/**
+ *  @brief Test documents that are parsed in chunks.
+ */
+TEST(HeadParser, ValidChunks) {
+  const std::string html(
+      "<html><head><meta property=\"og:description\" content=\"Open\">"
+      "<title>Chunked</title></head><body><p>Text</p></body></html>");
+  HeadParser parser;
+  for (std::size_t i = 0; i < html.size(); i += 7) {
+    parser.Parse(html.data() + i, std::min<std::size_t>(7, html.size() - i),
+                 false);
+  }
+  parser.Parse(nullptr, 0, true);
+  ASSERT_TRUE(parser.is_done());
+  ASSERT_EQ(parser.title(), "Chunked");
+  ASSERT_EQ(parser.description(), "Open");
+  parser.Reset();
+  ASSERT_FALSE(parser.is_done());
+  ASSERT_EQ(parser.title(), "");
+  ASSERT_EQ(parser.description(), "");
+}
+
+/**
+ *  @brief Test titles that come only from properties.
+ */
+TEST(HeadParser, ValidProperties) {
+  const std::string html(
+      "<html><head><meta property=\"twitter:title\" content=\"Card\">"
+      "</head><body></body></html>");
+  HeadParser parser;
+  parser.Parse(html.data(), html.size(), false);
+  ASSERT_TRUE(parser.is_done());
+  ASSERT_EQ(parser.title(), "");
+  ASSERT_EQ(parser.twitter_title(), "Card");
+}
+
+/**
+ *  @brief Test metadata that is not in `head` elements, and links that are
+ *  not used.
+ */
+TEST(HeadParser, Invalid) {
+  const std::string html(
+      "<html><head><link rel=\"canonical\" href=\"\">"
+      "<link rel=\"icons\" href=\"favicon.ico\"></head>"
+      "<body><meta property=\"og:title\" content=\"Body\">"
+      "<link rel=\"canonical\" href=\"body.html\"></body></html>");
+  HeadParser parser;
+  parser.Parse(html.data(), html.size(), true);
+  ASSERT_FALSE(parser.is_done());
+  ASSERT_EQ(parser.title(), "");
+  ASSERT_EQ(parser.og_title(), "");
+  ASSERT_EQ(parser.canonical_href(), "");
+  ASSERT_TRUE(parser.icons().empty());
+}
+
+} // namespace html
+} // namespace xbelmark
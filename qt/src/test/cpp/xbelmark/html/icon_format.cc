@@ -0,0 +1,52 @@
+#include "xbelmark/html/icon_format.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test the ranks of icons by `rel` and `sizes`.
+ */
+TEST(IconRank, Valid) {
+  ASSERT_LT(IconRank("icon", ""), IconRank("apple-touch-icon", "32x32"));
+  ASSERT_EQ(IconRank("shortcut icon", ""), IconRank("icon", ""));
+  ASSERT_LT(IconRank("icon", "32x32"), IconRank("icon", "16x16"));
+  ASSERT_LT(IconRank("icon", "16x16 32x32"), IconRank("icon", "192x192"));
+  ASSERT_LT(IconRank("icon", "any"), IconRank("icon", ""));
+  ASSERT_LT(
+      IconRank("apple-touch-icon", "120x120"),
+      IconRank("apple-touch-icon", "180x180"));
+}
+
+/**
+ *  @brief Test the sniffing of image formats.
+ */
+TEST(SniffIconType, Valid) {
+  const std::string png("\x89PNG\r\n\x1A\n\x00\x00", 10);
+  ASSERT_EQ(SniffIconType(png.data(), png.size()), "image/png");
+  const std::string ico("\x00\x00\x01\x00\x01\x00", 6);
+  ASSERT_EQ(SniffIconType(ico.data(), ico.size()), "image/x-icon");
+  const std::string gif("GIF89a\x01\x00");
+  ASSERT_EQ(SniffIconType(gif.data(), gif.size()), "image/gif");
+  const std::string webp("RIFF\x10\x00\x00\x00WEBPVP8 ", 16);
+  ASSERT_EQ(SniffIconType(webp.data(), webp.size()), "image/webp");
+  const std::string svg(
+      "\n<?xml version=\"1.0\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\"/>");
+  ASSERT_EQ(SniffIconType(svg.data(), svg.size()), "image/svg+xml");
+}
+
+/**
+ *  @brief Test content that is not an image.
+ */
+TEST(SniffIconType, Invalid) {
+  const std::string html("<!DOCTYPE html><html><body>Not Found</body></html>");
+  ASSERT_EQ(SniffIconType(html.data(), html.size()), "");
+  ASSERT_EQ(SniffIconType("", 0), "");
+  ASSERT_EQ(SniffIconType("\x89PN", 3), "");
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,41 @@
+#include "xbelmark/html/latency_tracker.h"
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test the percentiles of latencies.
+ */
+TEST(LatencyTracker, Percentile) {
+  LatencyTracker tracker(100);
+  ASSERT_EQ(tracker.Percentile(95), -1);
+  for (long long latency = 100; latency >= 1; --latency) {
+    tracker.Record(latency);
+  }
+  ASSERT_EQ(tracker.size(), 100u);
+  ASSERT_EQ(tracker.Percentile(50), 50);
+  ASSERT_EQ(tracker.Percentile(95), 95);
+  ASSERT_EQ(tracker.Percentile(100), 100);
+  ASSERT_EQ(tracker.Percentile(0), 1);
+}
+
+/**
+ *  @brief Test that the oldest latencies are replaced.
+ */
+TEST(LatencyTracker, Capacity) {
+  LatencyTracker tracker(4);
+  for (long long latency = 1; latency <= 4; ++latency) {
+    tracker.Record(1000 * latency);
+  }
+  tracker.Record(1);
+  tracker.Record(2);
+  ASSERT_EQ(tracker.size(), 4u);
+  // Samples are 1, 2, 3000, and 4000.
+  ASSERT_EQ(tracker.Percentile(50), 2);
+  ASSERT_EQ(tracker.Percentile(100), 4000);
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,63 @@
+#include "xbelmark/html/redirect_policy.h"
+
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test HTTP status codes of redirects.
+ */
+TEST(IsRedirectStatus, Valid) {
+  ASSERT_TRUE(IsRedirectStatus(301));
+  ASSERT_TRUE(IsRedirectStatus(302));
+  ASSERT_TRUE(IsRedirectStatus(303));
+  ASSERT_TRUE(IsRedirectStatus(307));
+  ASSERT_TRUE(IsRedirectStatus(308));
+  ASSERT_TRUE(IsPermanentRedirectStatus(301));
+  ASSERT_TRUE(IsPermanentRedirectStatus(308));
+}
+
+/**
+ *  @brief Test HTTP status codes that are not of redirects that are
+ *  followed.
+ */
+TEST(IsRedirectStatus, Invalid) {
+  ASSERT_FALSE(IsRedirectStatus(200));
+  ASSERT_FALSE(IsRedirectStatus(300));
+  ASSERT_FALSE(IsRedirectStatus(304));
+  ASSERT_FALSE(IsRedirectStatus(305));
+  ASSERT_FALSE(IsRedirectStatus(404));
+  ASSERT_FALSE(IsPermanentRedirectStatus(302));
+  ASSERT_FALSE(IsPermanentRedirectStatus(307));
+}
+
+/**
+ *  @brief Test redirects that are followed along a chain.
+ */
+TEST(RedirectError, Valid) {
+  ASSERT_EQ(RedirectError("http", "http", 0, 10), "");
+  ASSERT_EQ(RedirectError("http", "https", 0, 10), "");
+  ASSERT_EQ(RedirectError("https", "https", 9, 10), "");
+  std::size_t num_redirects = 0;
+  while (RedirectError("https", "https", num_redirects, 3).empty()) {
+    ++num_redirects;
+  }
+  ASSERT_EQ(num_redirects, 3u);
+}
+
+/**
+ *  @brief Test redirects that are not followed.
+ */
+TEST(RedirectError, Invalid) {
+  ASSERT_EQ(RedirectError("http", "", 0, 10), "Invalid redirect.");
+  ASSERT_EQ(RedirectError("https", "ftp", 0, 10), "Invalid redirect.");
+  ASSERT_EQ(RedirectError("https", "http", 0, 10), "Insecure redirect.");
+  ASSERT_EQ(RedirectError("http", "https", 10, 10), "Too many redirects.");
+  ASSERT_EQ(RedirectError("https", "http", 10, 10), "Insecure redirect.");
+}
+
+} // namespace html
+} // namespace xbelmark
@@ -0,0 +1,46 @@
+#include "xbelmark/html/retry_policy.h"
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test the classification of transient statuses.
+ */
+TEST(IsTransientStatus, Valid) {
+  ASSERT_TRUE(IsTransientStatus(429));
+  ASSERT_TRUE(IsTransientStatus(503));
+  ASSERT_TRUE(IsTransientStatus(504));
+  ASSERT_FALSE(IsTransientStatus(200));
+  ASSERT_FALSE(IsTransientStatus(404));
+  ASSERT_FALSE(IsTransientStatus(500));
+}
+
+/**
+ *  @brief Test the backoff of retries.
+ */
+TEST(RetryDelay, Valid) {
+  ASSERT_EQ(RetryDelay(1, 200, 10000, 0.0), 100);
+  ASSERT_EQ(RetryDelay(1, 200, 10000, 0.5), 150);
+  ASSERT_EQ(RetryDelay(2, 200, 10000, 0.0), 200);
+  ASSERT_EQ(RetryDelay(3, 200, 10000, 0.0), 400);
+  // Backoff is capped.
+  ASSERT_EQ(RetryDelay(30, 200, 10000, 0.0), 5000);
+  ASSERT_LT(RetryDelay(30, 200, 10000, 0.999), 10000);
+}
+
+/**
+ *  @brief Test the parsing of `Retry-After`.
+ */
+TEST(RetryAfterDelay, Valid) {
+  ASSERT_EQ(RetryAfterDelay("120"), 120000);
+  ASSERT_EQ(RetryAfterDelay(" 0 "), 0);
+  ASSERT_EQ(RetryAfterDelay(""), -1);
+  ASSERT_EQ(RetryAfterDelay("-1"), -1);
+  ASSERT_EQ(RetryAfterDelay("1 2"), -1);
+  ASSERT_EQ(RetryAfterDelay("Wed, 21 Oct 2015 07:28:00 GMT"), -1);
+}
+
+} // namespace html
+} // namespace xbelmark
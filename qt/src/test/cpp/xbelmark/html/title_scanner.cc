@@ -0,0 +1,100 @@
+#include "xbelmark/html/title_scanner.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test finding a byte in blocks and in the remainder.
+ */
+TEST(Find, Valid) {
+  const std::string str(
+      std::string(20, 'a') + std::string(1, '\0') + "<" +
+      std::string(5, 'b') + "&");
+  const char *first = str.data();
+  const char *last = first + str.size();
+  ASSERT_EQ(Find(first, last, '<') - first, 21);
+  ASSERT_EQ(Find(first, last, '&') - first, 27);
+  ASSERT_EQ(Find(first, last, '\0') - first, 20);
+  ASSERT_EQ(Find(first + 22, last, 'b') - first, 22);
+  ASSERT_EQ(Find(first, last, '>'), last);
+  ASSERT_EQ(Find(first, first, 'a'), first);
+}
+
+/**
+ *  @brief Test finding a byte among three in blocks and in the remainder.
+ */
+TEST(FindAnyOf, Valid) {
+  const std::string str(std::string(37, 'a') + "\"" + std::string(5, 'b'));
+  const char *first = str.data();
+  const char *last = first + str.size();
+  ASSERT_EQ(FindAnyOf(first, last, '<', '>', '"') - first, 37);
+  ASSERT_EQ(FindAnyOf(first, last, 'b', 'b', 'b') - first, 38);
+  ASSERT_EQ(FindAnyOf(first, last, '<', '<', '<'), last);
+}
+
+/**
+ *  @brief Test scanning HTML documents for their titles.
+ */
+TEST(TitleScanner, Found) {
+  const std::string html(
+      "<!DOCTYPE html><html><head>"
+      "<!-- <title>Comment</title> -->"
+      "<meta name=\"x\" content=\"<title>Attribute</title>\">"
+      "<script>document.write('<title>Script</title>');</script>"
+      "<STYLE>p::after { content: '</title>'; }</STYLE>"
+      "<Title lang=en>Fish &amp; Chips &#8211; &#x1F41F;&nbsp;&lt;3"
+      "</TITLE></head>");
+  TitleScanner scanner;
+  ASSERT_EQ(
+      scanner.Scan(html.data(), html.size(), true),
+      TitleScanner::Status::FOUND);
+  ASSERT_EQ(
+      scanner.title(),
+      "Fish & Chips \xE2\x80\x93 \xF0\x9F\x90\x9F\xC2\xA0<3");
+}
+
+/**
+ *  @brief Test scanning an HTML document as it is being downloaded.
+ */
+TEST(TitleScanner, Incremental) {
+  const std::string html(
+      "<html><head><script src=a.js></script><title>Example</title>");
+  TitleScanner scanner;
+  for (std::size_t size = 0; size < html.size(); ++size) {
+    ASSERT_EQ(
+        scanner.Scan(html.data(), size, false),
+        TitleScanner::Status::INCOMPLETE);
+  }
+  ASSERT_EQ(
+      scanner.Scan(html.data(), html.size(), false),
+      TitleScanner::Status::FOUND);
+  ASSERT_EQ(scanner.title(), "Example");
+}
+
+/**
+ *  @brief Test HTML documents that are left to an HTML parser.
+ */
+TEST(TitleScanner, Fallback) {
+  const std::string no_title("<html><head></head><body>Text</body></html>");
+  const std::string entity("<title>Caf&eacute;</title>");
+  const std::string invalid("<title>\xFF</title>");
+  TitleScanner scanner;
+  ASSERT_EQ(
+      scanner.Scan(no_title.data(), no_title.size(), true),
+      TitleScanner::Status::FALLBACK);
+  scanner = TitleScanner();
+  ASSERT_EQ(
+      scanner.Scan(entity.data(), entity.size(), true),
+      TitleScanner::Status::FALLBACK);
+  scanner = TitleScanner();
+  ASSERT_EQ(
+      scanner.Scan(invalid.data(), invalid.size(), true),
+      TitleScanner::Status::FALLBACK);
+}
+
+} // namespace html
+} // namespace xbelmark
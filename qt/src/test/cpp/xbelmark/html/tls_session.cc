@@ -0,0 +1,91 @@
+#include "xbelmark/html/tls_session.h"
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace html {
+
+/**
+ *  @brief Test the keys of TLS sessions.
+ */
+TEST(TlsSessionKey, Valid) {
+  ASSERT_EQ(TlsSessionKey("Example.COM", 443), "example.com:443");
+  ASSERT_EQ(TlsSessionKey("localhost", 8443), "localhost:8443");
+  ASSERT_NE(
+      TlsSessionKey("example.com", 443), TlsSessionKey("example.com", 8443));
+}
+
+/**
+ *  @brief Test the freshness of TLS sessions.
+ */
+TEST(IsTlsSessionFresh, Valid) {
+  const long long now = 1700000000;
+  ASSERT_TRUE(IsTlsSessionFresh(now - 60, 300, now));
+  ASSERT_FALSE(IsTlsSessionFresh(now - 300, 300, now));
+  // Without a hint, the default lifetime is assumed.
+  ASSERT_TRUE(IsTlsSessionFresh(now - 60, 0, now));
+  ASSERT_FALSE(
+      IsTlsSessionFresh(now - kDefaultTlsSessionLifetime, 0, now));
+  // Hints are bounded.
+  ASSERT_FALSE(
+      IsTlsSessionFresh(now - kMaxTlsSessionAge, 100 * kMaxTlsSessionAge, now));
+  // A session from the future is not trusted.
+  ASSERT_FALSE(IsTlsSessionFresh(now + 60, 300, now));
+}
+
+/**
+ *  @brief Test storing a session and resuming it with the same server.
+ */
+TEST(ResumableTlsTicket, Valid) {
+  const long long now = 1700000000;
+  std::map<std::string, TlsSession> store;
+  // The first connection has nothing to resume, and stores its session.
+  const std::string key(TlsSessionKey("Example.com", 443));
+  ASSERT_EQ(store.count(key), 0u);
+  ASSERT_TRUE(IsNewTlsSession("dGlja2V0", ""));
+  TlsSession session;
+  session.key = key;
+  session.ticket = "dGlja2V0";
+  session.lifetime_hint = 600;
+  session.stored_at = now;
+  store[key] = session;
+  // The next connection resumes it.
+  const std::string resumed_ticket(
+      ResumableTlsTicket(
+          store[TlsSessionKey("example.com", 443)],
+          TlsSessionKey("example.com", 443),
+          now + 60));
+  ASSERT_EQ(resumed_ticket, "dGlja2V0");
+  // A resumed session is not stored again, but a new one replaces it.
+  ASSERT_FALSE(IsNewTlsSession(resumed_ticket, resumed_ticket));
+  ASSERT_TRUE(IsNewTlsSession("bmV3", resumed_ticket));
+}
+
+/**
+ *  @brief Test sessions that are not resumed or stored.
+ */
+TEST(ResumableTlsTicket, Invalid) {
+  const long long now = 1700000000;
+  TlsSession session;
+  session.key = TlsSessionKey("example.com", 443);
+  session.ticket = "dGlja2V0";
+  session.lifetime_hint = 600;
+  session.stored_at = now;
+  // Another server, as with a hash collision.
+  ASSERT_EQ(
+      ResumableTlsTicket(session, TlsSessionKey("example.com", 8443), now),
+      "");
+  // Expired.
+  ASSERT_EQ(ResumableTlsTicket(session, session.key, now + 600), "");
+  // Corrupted.
+  ASSERT_EQ(ResumableTlsTicket(TlsSession(), session.key, now), "");
+  // No ticket to store.
+  ASSERT_FALSE(IsNewTlsSession("", ""));
+  ASSERT_FALSE(IsNewTlsSession("", "dGlja2V0"));
+}
+
+} // namespace html
+} // namespace xbelmark
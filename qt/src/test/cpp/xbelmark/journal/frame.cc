@@ -0,0 +1,50 @@
+#include "xbelmark/journal/frame.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace journal {
+
+/**
+ *  @brief Test CRC-32 against its check value.
+ */
+TEST(Crc32, Valid) {
+  ASSERT_EQ(Crc32("", 0), 0u);
+  ASSERT_EQ(Crc32("123456789", 9), 0xCBF43926u);
+}
+
+/**
+ *  @brief Test records that are framed and unframed.
+ */
+TEST(UnframeRecord, Valid) {
+  const std::string payload("{\"href\":\"https://example.com/\"}");
+  std::string line(FrameRecord(payload));
+  ASSERT_EQ(line.back(), '\n');
+  line.pop_back();
+  std::string unframed;
+  ASSERT_TRUE(UnframeRecord(line, unframed));
+  ASSERT_EQ(unframed, payload);
+  ASSERT_TRUE(UnframeRecord(FrameRecord("").substr(0, 9), unframed));
+  ASSERT_EQ(unframed, "");
+}
+
+/**
+ *  @brief Test lines that are torn or corrupted.
+ */
+TEST(UnframeRecord, Invalid) {
+  std::string line(FrameRecord("{\"title\":\"Example\"}"));
+  line.pop_back();
+  std::string unframed("unchanged");
+  ASSERT_FALSE(UnframeRecord(line.substr(0, line.size() - 1), unframed));
+  ASSERT_FALSE(UnframeRecord(line.substr(0, 8), unframed));
+  std::string corrupted(line);
+  corrupted[12] ^= 1;
+  ASSERT_FALSE(UnframeRecord(corrupted, unframed));
+  ASSERT_FALSE(UnframeRecord("zzzzzzzz {}", unframed));
+  ASSERT_EQ(unframed, "unchanged");
+}
+
+} // namespace journal
+} // namespace xbelmark
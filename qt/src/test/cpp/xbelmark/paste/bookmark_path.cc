@@ -0,0 +1,71 @@
+#include "xbelmark/paste/bookmark_path.h"
+
+#include <ctime>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  @brief Test file names that are numbered to avoid collisions.
+ */
+TEST(NumberedFileName, Valid) {
+  ASSERT_EQ(NumberedFileName("Example", ".xbel", 1), "Example.xbel");
+  ASSERT_EQ(NumberedFileName("Example", ".xbel", 2), "Example (2).xbel");
+  ASSERT_EQ(NumberedFileName("Example", ".url", 12), "Example (12).url");
+}
+
+/**
+ *  @brief Test subdirectories of the layout that shards by hash.
+ */
+TEST(HashShard, Valid) {
+  ASSERT_EQ(HashShard("Example"), HashShard("Example"));
+  ASSERT_EQ(HashShard("").size(), 2u);
+  std::set<std::string> shards;
+  for (int i = 0; i != 4096; ++i) {
+    const std::string shard(HashShard("Bookmark_" + std::to_string(i)));
+    ASSERT_EQ(shard.find_first_not_of("0123456789abcdef"), std::string::npos);
+    shards.insert(shard);
+  }
+  ASSERT_EQ(shards.size(), 256u);
+}
+
+/**
+ *  @brief Test subdirectories of the layout that shards by date.
+ */
+TEST(DateShard, Valid) {
+  std::tm date_time = {};
+  date_time.tm_year = 2024 - 1900;
+  date_time.tm_mon = 5 - 1;
+  date_time.tm_mday = 17;
+  ASSERT_EQ(DateShard(date_time), "2024/05");
+}
+
+/**
+ *  @brief Test files that are in directory trees.
+ */
+TEST(IsInDirTree, Valid) {
+  ASSERT_TRUE(
+      IsInDirTree("/home/user/bookmarks/a.xbel", "/home/user/bookmarks"));
+  ASSERT_TRUE(IsInDirTree("/home/user/bookmarks/1/2/a.url", "/home/user"));
+  ASSERT_TRUE(IsInDirTree("/a.xbel", "/"));
+  ASSERT_TRUE(IsInDirTree("C:/Bookmarks/a.url", "C:/"));
+}
+
+/**
+ *  @brief Test files that are not in directory trees.
+ */
+TEST(IsInDirTree, Invalid) {
+  ASSERT_FALSE(
+      IsInDirTree("/home/user/bookmarks2/a.xbel", "/home/user/bookmarks"));
+  ASSERT_FALSE(IsInDirTree("/home/user/bookmarks", "/home/user/bookmarks"));
+  ASSERT_FALSE(IsInDirTree("/tmp/a.xbel", "/home/user/bookmarks"));
+  ASSERT_FALSE(IsInDirTree("", "/home/user"));
+  ASSERT_FALSE(IsInDirTree("/home/user/a.xbel", ""));
+}
+
+} // namespace paste
+} // namespace xbelmark
@@ -0,0 +1,37 @@
+#include "xbelmark/paste/url_list.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace paste {
+
+/**
+ *  @brief Test URLs in lists with one URL per line.
+ */
+TEST(UrlLines, Valid) {
+  ASSERT_EQ(
+      UrlLines("https://example.com/\nhttps://example.org/a b\n"),
+      std::vector<std::string>({
+          "https://example.com/",
+          "https://example.org/a b"
+      }));
+  ASSERT_EQ(
+      UrlLines(
+          "# Exported links\r\n"
+          "\r\n"
+          "  https://example.com/  \r\n"
+          "\t\r\n"
+          "https://example.net/"),
+      std::vector<std::string>({
+          "https://example.com/",
+          "https://example.net/"
+      }));
+  ASSERT_TRUE(UrlLines("").empty());
+  ASSERT_TRUE(UrlLines("\n \n#\n").empty());
+}
+
+} // namespace paste
+} // namespace xbelmark
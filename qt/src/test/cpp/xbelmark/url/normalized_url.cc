@@ -0,0 +1,77 @@
+#include "xbelmark/url/normalized_url.h"
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace url {
+
+/**
+ *  @brief Test the normalization of percent-encodings.
+ */
+TEST(NormalizedPercentEncoding, Valid) {
+  ASSERT_EQ(NormalizedPercentEncoding("%7euser"), "~user");
+  ASSERT_EQ(NormalizedPercentEncoding("%41%2d"), "A-");
+  ASSERT_EQ(NormalizedPercentEncoding("a%2fb"), "a%2Fb");
+  ASSERT_EQ(NormalizedPercentEncoding("%e2%82%ac"), "%E2%82%AC");
+}
+
+/**
+ *  @brief Test that malformed percent-encodings are kept.
+ */
+TEST(NormalizedPercentEncoding, Invalid) {
+  ASSERT_EQ(NormalizedPercentEncoding("%"), "%");
+  ASSERT_EQ(NormalizedPercentEncoding("%4"), "%4");
+  ASSERT_EQ(NormalizedPercentEncoding("%zz"), "%zz");
+}
+
+/**
+ *  @brief Test the removal of dot segments.
+ */
+TEST(PathWithoutDotSegments, Valid) {
+  ASSERT_EQ(PathWithoutDotSegments("/a/b/c/./../../g"), "/a/g");
+  ASSERT_EQ(PathWithoutDotSegments("/a/./b/"), "/a/b/");
+  ASSERT_EQ(PathWithoutDotSegments("/a/.."), "/");
+  ASSERT_EQ(PathWithoutDotSegments("/../a"), "/a");
+  ASSERT_EQ(PathWithoutDotSegments("/a/b"), "/a/b");
+}
+
+/**
+ *  @brief Test the normalization of URLs.
+ */
+TEST(NormalizedUrl, Valid) {
+  // Case of the scheme and host but not of the path.
+  ASSERT_EQ(
+      NormalizedUrl("HTTPS://Example.COM/Path"), "https://example.com/Path");
+  // Default ports.
+  ASSERT_EQ(NormalizedUrl("http://example.com:80/"), "http://example.com/");
+  ASSERT_EQ(
+      NormalizedUrl("https://example.com:443/a"), "https://example.com/a");
+  ASSERT_EQ(
+      NormalizedUrl("http://example.com:443/"), "http://example.com:443/");
+  ASSERT_EQ(NormalizedUrl("http://example.com:/"), "http://example.com/");
+  ASSERT_EQ(
+      NormalizedUrl("http://[::1]:80/"), "http://[::1]/");
+  ASSERT_EQ(
+      NormalizedUrl("http://[::1]/"), "http://[::1]/");
+  // Fragments.
+  ASSERT_EQ(
+      NormalizedUrl("https://example.com/a?b=1#top"),
+      "https://example.com/a?b=1");
+  // Trailing slash is significant except for an empty path.
+  ASSERT_EQ(NormalizedUrl("https://example.com"), "https://example.com/");
+  ASSERT_EQ(NormalizedUrl("https://example.com?q"), "https://example.com/?q");
+  ASSERT_EQ(NormalizedUrl("https://example.com/a/"), "https://example.com/a/");
+  ASSERT_EQ(NormalizedUrl("https://example.com/a"), "https://example.com/a");
+  // Percent-encoding and dot segments.
+  ASSERT_EQ(
+      NormalizedUrl("https://example.com/%7euser/./a/../b?x=%2f"),
+      "https://example.com/~user/b?x=%2F");
+  // User information keeps its case.
+  ASSERT_EQ(
+      NormalizedUrl("ftp://User@Example.com:21/"), "ftp://User@example.com:21/");
+  // URLs without an authority.
+  ASSERT_EQ(NormalizedUrl("MAILTO:a@example.com"), "mailto:a@example.com");
+}
+
+} // namespace url
+} // namespace xbelmark
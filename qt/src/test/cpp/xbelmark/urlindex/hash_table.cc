@@ -0,0 +1,50 @@
+#include "xbelmark/urlindex/hash_table.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace urlindex {
+
+/**
+ *  @brief Test hashes of normalized URLs.
+ */
+TEST(UrlHash, Valid) {
+  ASSERT_EQ(UrlHash(""), UINT64_C(0xCBF29CE484222325));
+  ASSERT_EQ(UrlHash("a"), UINT64_C(0xAF63DC4C8601EC8C));
+  ASSERT_NE(UrlHash("https://example.com/"), UrlHash("https://example.org/"));
+}
+
+/**
+ *  @brief Test inserting hashes that collide in their home slot.
+ */
+TEST(InsertHash, Probing) {
+  std::vector<std::uint64_t> slots(8, 0);
+  ASSERT_TRUE(InsertHash(slots.data(), slots.size(), 7));
+  ASSERT_TRUE(InsertHash(slots.data(), slots.size(), 15));
+  ASSERT_TRUE(InsertHash(slots.data(), slots.size(), 23));
+  ASSERT_FALSE(InsertHash(slots.data(), slots.size(), 15));
+  ASSERT_EQ(slots[7], 7u);
+  ASSERT_EQ(slots[0], 15u);
+  ASSERT_EQ(slots[1], 23u);
+  ASSERT_TRUE(ContainsHash(slots.data(), slots.size(), 23));
+  ASSERT_FALSE(ContainsHash(slots.data(), slots.size(), 31));
+  ASSERT_FALSE(ContainsHash(slots.data(), slots.size(), 2));
+}
+
+/**
+ *  @brief Test a hash table that is full.
+ */
+TEST(InsertHash, Full) {
+  std::vector<std::uint64_t> slots(2, 0);
+  ASSERT_TRUE(InsertHash(slots.data(), slots.size(), 1));
+  ASSERT_TRUE(InsertHash(slots.data(), slots.size(), 2));
+  ASSERT_FALSE(InsertHash(slots.data(), slots.size(), 3));
+  ASSERT_FALSE(ContainsHash(slots.data(), slots.size(), 3));
+  ASSERT_TRUE(ContainsHash(slots.data(), slots.size(), 2));
+}
+
+} // namespace urlindex
+} // namespace xbelmark
@@ -0,0 +1,38 @@
+#include "xbelmark/xslt/manifest.h"
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace xslt {
+
+/**
+ *  @brief Test the entries of a manifest.
+ */
+TEST(ManifestEntries, Valid) {
+  const auto entries(
+      ManifestEntries(
+          "# Collections\n"
+          "\n"
+          "alice/bookmarks.xbel\talice/index.html\r\n"
+          "  bob/my bookmarks.xbel\tbob/index.html  \n"));
+  ASSERT_EQ(entries.size(), 2u);
+  ASSERT_EQ(entries[0].first, "alice/bookmarks.xbel");
+  ASSERT_EQ(entries[0].second, "alice/index.html");
+  ASSERT_EQ(entries[1].first, "bob/my bookmarks.xbel");
+  ASSERT_EQ(entries[1].second, "bob/index.html");
+  ASSERT_TRUE(ManifestEntries("").empty());
+}
+
+/**
+ *  @brief Test that lines without exactly two paths are rejected.
+ */
+TEST(ManifestEntries, Invalid) {
+  ASSERT_THROW(ManifestEntries("a.xbel\n"), std::runtime_error);
+  ASSERT_THROW(ManifestEntries("a.xbel\tb.html\tc\n"), std::runtime_error);
+  ASSERT_THROW(ManifestEntries("a.xbel\t\t\n"), std::runtime_error);
+}
+
+} // namespace xslt
+} // namespace xbelmark
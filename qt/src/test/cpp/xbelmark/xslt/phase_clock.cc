@@ -0,0 +1,62 @@
+#include "xbelmark/xslt/phase_clock.h"
+
+#include <gtest/gtest.h>
+
+namespace xbelmark {
+namespace xslt {
+
+/**
+ *  @brief Test that runs accumulate into phases.
+ */
+TEST(PhaseTime, Valid) {
+  PhaseTime phase;
+  ASSERT_EQ(phase.count, 0);
+  phase.Add(0.5, 0.25);
+  phase.Add(1.5, 0.75);
+  ASSERT_EQ(phase.count, 2);
+  ASSERT_EQ(phase.wall_seconds, 2.0);
+  ASSERT_EQ(phase.cpu_seconds, 1.0);
+  phase.Add(0, 0);
+  ASSERT_EQ(phase.count, 3);
+  ASSERT_EQ(phase.wall_seconds, 2.0);
+  ASSERT_EQ(phase.cpu_seconds, 1.0);
+}
+
+/**
+ *  @brief Test that negative times do not decrease the accumulated times.
+ */
+TEST(PhaseTime, Invalid) {
+  PhaseTime phase;
+  phase.Add(1, 1);
+  phase.Add(-0.5, -2);
+  ASSERT_EQ(phase.count, 2);
+  ASSERT_EQ(phase.wall_seconds, 1.0);
+  ASSERT_EQ(phase.cpu_seconds, 1.0);
+}
+
+/**
+ *  @brief Test that laps are counted in the phases that they end, and that
+ *  the accumulated times never decrease.
+ */
+TEST(PhaseClock, Valid) {
+  PhaseClock clock;
+  PhaseTime first;
+  PhaseTime second;
+  double wall_seconds = 0;
+  double cpu_seconds = 0;
+  for (long long i = 1; i <= 100; ++i) {
+    clock.Lap(first);
+    clock.Lap(second);
+    ASSERT_EQ(first.count, i);
+    ASSERT_EQ(second.count, i);
+    ASSERT_GE(first.wall_seconds, wall_seconds);
+    ASSERT_GE(first.cpu_seconds, cpu_seconds);
+    wall_seconds = first.wall_seconds;
+    cpu_seconds = first.cpu_seconds;
+  }
+  ASSERT_GE(second.wall_seconds, 0);
+  ASSERT_GE(second.cpu_seconds, 0);
+}
+
+} // namespace xslt
+} // namespace xbelmark